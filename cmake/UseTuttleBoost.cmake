@@ -5,14 +5,14 @@ add_definitions(-DBOOST_LOG_DYN_LINK)
 
 # Get boost libraries for tuttleCommon
 find_package(Boost 1.53.0
-    COMPONENTS log filesystem
+    COMPONENTS log filesystem thread system
     QUIET
 )
 set(TuttleCommonBoost_LIBRARIES ${Boost_LIBRARIES})
 
 # Get boost libraries for tuttleHost
 find_package(Boost 1.53.0
-    COMPONENTS date_time chrono serialization system filesystem atomic log timer
+    COMPONENTS date_time chrono serialization system filesystem atomic log timer iostreams
     QUIET
 )
 set(TuttleHostBoost_LIBRARIES ${Boost_LIBRARIES})
@@ -672,6 +672,12 @@ void ImageEffectDescriptor::setSupportsTiles( bool v )
 	_effectProps.propSetInt( kOfxImageEffectPropSupportsTiles, int(v) );
 }
 
+/** @brief Can the plugin render with the output sharing the buffer of a source image */
+void ImageEffectDescriptor::setSupportsInPlace( bool v )
+{
+	_effectProps.propSetInt( kTuttleOfxImageEffectPropSupportsInPlace, int(v), false );
+}
+
 /** @brief Does the plugin perform temporal clip access */
 void ImageEffectDescriptor::setTemporalClipAccess( bool v )
 {
@@ -383,6 +383,7 @@ static PropertyDescription gPluginDescriptorProps[] =
     PropertyDescription( kOfxImageEffectPropSupportsMultipleClipDepths,   OFX::eInt, 1, eDescDefault, 0, eDescFinished ),
     PropertyDescription( kOfxImageEffectPropSupportsMultipleClipPARs,     OFX::eInt, 1, eDescDefault, 0, eDescFinished ),
     PropertyDescription( kTuttleOfxImageEffectPropEvaluation,             OFX::eDouble, 1, eDescDefault, -1, eDescFinished ),
+    PropertyDescription( kTuttleOfxImageEffectPropSupportsInPlace,        OFX::eInt, 1, eDescDefault, 0, eDescFinished ),
 
     // Pointer props with defaults that can be checked against
     PropertyDescription( kOfxImageEffectPluginPropOverlayInteractV1,      OFX::ePointer, 1, eDescDefault, ( void* )( 0 ), eDescFinished ),
@@ -459,6 +459,9 @@ public:
     /** @brief Does the plugin support image tiling, defaults to true */
     void setSupportsTiles( bool v );
 
+    /** @brief Can the plugin render with the output sharing the buffer of a source image, defaults to false */
+    void setSupportsInPlace( bool v );
+
     /** @brief Does the plugin perform temporal clip access, defaults to false */
     void setTemporalClipAccess( bool v );
 
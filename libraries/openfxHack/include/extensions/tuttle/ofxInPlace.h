@@ -0,0 +1,25 @@
+#ifndef _ofxInPlace_h_
+#define _ofxInPlace_h_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Indicates whether a plugin can render with the output image sharing the buffer of a source image.
+ *
+ * - Type - int X 1
+ * - Property Set - plugin descriptor (read/write)
+ * - Default - 0
+ * - Valid Values - This must be one of
+ *   - 0 - the output buffer is always a new buffer
+ *   - 1 - the plugin only reads a source pixel before writing the output pixel at the same position,
+ *         so the host can give the same buffer for a source image and the output image
+ *         (when they have the same bounds and pixel format).
+ */
+#define kTuttleOfxImageEffectPropSupportsInPlace "TuttleOfxImageEffectPropSupportsInPlace"
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,498 @@
+#ifndef _TERRY_FILTER_RECURSIVEBLUR_HPP_
+#define _TERRY_FILTER_RECURSIVEBLUR_HPP_
+
+#include "convolve.hpp"
+
+#include <terry/globals.hpp>
+
+#include <boost/gil/metafunctions.hpp>
+#include <boost/type_traits/is_integral.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <vector>
+#include <algorithm>
+
+namespace terry {
+namespace filter {
+
+/**
+ * @brief Blur filters with a constant cost per pixel, whatever the size of the blur.
+ */
+enum recursive_blur_method
+{
+	recursive_blur_young_van_vliet, ///< 3rd order recursive gaussian (Young and van Vliet)
+	recursive_blur_deriche,         ///< 2nd order recursive gaussian (Deriche)
+	recursive_blur_box              ///< 3 iterated box filters, computed with a running sum
+};
+
+namespace detail {
+
+static const std::ptrdiff_t kRecursiveBlurBoxPasses = 3;
+static const std::ptrdiff_t kRecursiveBlurBlockWidth = 16; ///< number of lines filtered together
+
+/// radius of each box filter to approximate a gaussian of standard deviation @p sigma
+inline std::ptrdiff_t box_blur_radius( const double sigma )
+{
+	// variance of a box of width w: (w^2 - 1) / 12
+	const double width = std::sqrt( 12.0 * sigma * sigma / kRecursiveBlurBoxPasses + 1.0 );
+	return std::max( std::ptrdiff_t(0), static_cast<std::ptrdiff_t>( ( width - 1.0 ) * 0.5 + 0.5 ) );
+}
+
+/**
+ * @brief Index of the source sample used at @p i, for a line of @p size samples.
+ * @return -1 for a zero sample
+ */
+inline std::ptrdiff_t boundary_index( const std::ptrdiff_t i, const std::ptrdiff_t size, const convolve_boundary_option option )
+{
+	if( i >= 0 && i < size )
+		return i;
+	switch( option )
+	{
+		case convolve_option_extend_mirror:
+		{
+			const std::ptrdiff_t period = 2 * size;
+			std::ptrdiff_t m = i % period;
+			if( m < 0 )
+				m += period;
+			return m < size ? m : period - 1 - m;
+		}
+		case convolve_option_extend_constant:
+		case convolve_option_extend_padded:
+			return i < 0 ? 0 : size - 1;
+		case convolve_option_extend_zero:
+		case convolve_option_output_zero:
+		case convolve_option_output_ignore:
+			break;
+	}
+	return -1;
+}
+
+/**
+ * @brief Coefficients of the recursive gaussian of Young and van Vliet,
+ * normalized by b0.
+ *
+ * I.T. Young, L.J. van Vliet, "Recursive implementation of the Gaussian filter",
+ * Signal Processing 44, 1995.
+ */
+struct young_van_vliet_coefficients
+{
+	explicit young_van_vliet_coefficients( const double sigma )
+	{
+		// the q of the paper gives a blur about 10% too large,
+		// so q is adjusted to have a variance of sigma^2
+		const double s = std::max( sigma, 0.5 );
+		double qMin = 0.0;
+		double qMax = 2.0 * s + 1.0;
+		for( int i = 0; i < 50; ++i )
+		{
+			const double q = 0.5 * ( qMin + qMax );
+			if( variance( q ) < s * s )
+				qMin = q;
+			else
+				qMax = q;
+		}
+		const double q = 0.5 * ( qMin + qMax );
+		double b1, b2, b3;
+		coefficients( q, b1, b2, b3 );
+		_b1 = static_cast<float>( b1 );
+		_b2 = static_cast<float>( b2 );
+		_b3 = static_cast<float>( b3 );
+		_B = 1.f - ( _b1 + _b2 + _b3 );
+	}
+
+	static void coefficients( const double q, double& b1, double& b2, double& b3 )
+	{
+		const double q2 = q * q;
+		const double q3 = q2 * q;
+		const double b0 = 1.57825 + 2.44413 * q + 1.4281 * q2 + 0.422205 * q3;
+		b1 = ( 2.44413 * q + 2.85619 * q2 + 1.26661 * q3 ) / b0;
+		b2 = -( 1.4281 * q2 + 1.26661 * q3 ) / b0;
+		b3 = ( 0.422205 * q3 ) / b0;
+	}
+
+	/// variance of the causal and anticausal filters together
+	static double variance( const double q )
+	{
+		double b1, b2, b3;
+		coefficients( q, b1, b2, b3 );
+		const double B = 1.0 - ( b1 + b2 + b3 );
+		const double m1 = ( b1 + 2.0 * b2 + 3.0 * b3 ) / B;
+		const double m2 = ( b1 + 4.0 * b2 + 9.0 * b3 ) / B;
+		return 2.0 * ( m2 + m1 * m1 );
+	}
+
+	float _B;
+	float _b1, _b2, _b3;
+};
+
+/**
+ * @brief Coefficients of the 2nd order recursive gaussian of Deriche.
+ *
+ * R. Deriche, "Recursively implementing the Gaussian and its derivatives",
+ * INRIA research report 1893, 1993.
+ */
+struct deriche_coefficients
+{
+	explicit deriche_coefficients( const double sigma )
+	{
+		// the variance of the filter is 4 / alpha^2
+		const double alpha = 2.0 / std::max( sigma, 0.5 );
+		const double ema = std::exp( -alpha );
+		const double ema2 = std::exp( -2.0 * alpha );
+		const double k = ( 1.0 - ema ) * ( 1.0 - ema ) / ( 1.0 + 2.0 * alpha * ema - ema2 );
+		_a0 = static_cast<float>( k );
+		_a1 = static_cast<float>( k * ema * ( alpha - 1.0 ) );
+		_a2 = static_cast<float>( k * ema * ( alpha + 1.0 ) );
+		_a3 = static_cast<float>( -k * ema2 );
+		_b1 = static_cast<float>( 2.0 * ema );
+		_b2 = static_cast<float>( -ema2 );
+		// response to a constant line of 1
+		_causalGain = ( _a0 + _a1 ) / ( 1.f - _b1 - _b2 );
+		_anticausalGain = ( _a2 + _a3 ) / ( 1.f - _b1 - _b2 );
+	}
+
+	float _a0, _a1, _a2, _a3;
+	float _b1, _b2;
+	float _causalGain;
+	float _anticausalGain;
+};
+
+/**
+ * @brief The lines are made of @p length samples of @p width contiguous floats,
+ * all the floats of a sample are filtered together.
+ * The values before and after the line are the first and last samples.
+ */
+inline void young_van_vliet_line( float* data, const std::ptrdiff_t length, const std::ptrdiff_t width, const young_van_vliet_coefficients& c )
+{
+	if( length == 0 )
+		return;
+	const float* first = data;
+	for( std::ptrdiff_t n = 0; n < length; ++n )
+	{
+		float* cur = data + n * width;
+		const float* p1 = n >= 1 ? cur - width : first;
+		const float* p2 = n >= 2 ? cur - 2 * width : first;
+		const float* p3 = n >= 3 ? cur - 3 * width : first;
+		for( std::ptrdiff_t i = 0; i < width; ++i )
+			cur[i] = c._B * cur[i] + c._b1 * p1[i] + c._b2 * p2[i] + c._b3 * p3[i];
+	}
+	const float* last = data + ( length - 1 ) * width;
+	for( std::ptrdiff_t n = length - 1; n >= 0; --n )
+	{
+		float* cur = data + n * width;
+		const float* n1 = n + 1 < length ? cur + width : last;
+		const float* n2 = n + 2 < length ? cur + 2 * width : last;
+		const float* n3 = n + 3 < length ? cur + 3 * width : last;
+		for( std::ptrdiff_t i = 0; i < width; ++i )
+			cur[i] = c._B * cur[i] + c._b1 * n1[i] + c._b2 * n2[i] + c._b3 * n3[i];
+	}
+}
+
+/**
+ * @brief Same layout than young_van_vliet_line.
+ * @param[out] tmp buffer of length * width floats
+ * @param[out] history buffer of 4 * width floats
+ */
+inline void deriche_line( float* data, float* tmp, float* history, const std::ptrdiff_t length, const std::ptrdiff_t width, const deriche_coefficients& c )
+{
+	if( length == 0 )
+		return;
+	// causal part in tmp
+	const float* first = data;
+	for( std::ptrdiff_t i = 0; i < width; ++i )
+	{
+		history[i] = first[i] * c._causalGain; // y[n-1]
+		history[width + i] = history[i]; // y[n-2]
+	}
+	for( std::ptrdiff_t n = 0; n < length; ++n )
+	{
+		const float* x = data + n * width;
+		const float* x1 = n >= 1 ? x - width : first;
+		float* y = tmp + n * width;
+		const float* y1 = n >= 1 ? y - width : history;
+		const float* y2 = n >= 2 ? y - 2 * width : ( n == 1 ? history : history + width );
+		for( std::ptrdiff_t i = 0; i < width; ++i )
+			y[i] = c._a0 * x[i] + c._a1 * x1[i] + c._b1 * y1[i] + c._b2 * y2[i];
+	}
+	// anticausal part, added in place
+	// history: y[n+1], y[n+2], x[n+1], x[n+2]
+	float* ya1 = history;
+	float* ya2 = history + width;
+	float* xa1 = history + 2 * width;
+	float* xa2 = history + 3 * width;
+	const float* last = data + ( length - 1 ) * width;
+	for( std::ptrdiff_t i = 0; i < width; ++i )
+	{
+		ya1[i] = ya2[i] = last[i] * c._anticausalGain;
+		xa1[i] = xa2[i] = last[i];
+	}
+	for( std::ptrdiff_t n = length - 1; n >= 0; --n )
+	{
+		float* x = data + n * width;
+		const float* y = tmp + n * width;
+		for( std::ptrdiff_t i = 0; i < width; ++i )
+		{
+			const float ya = c._a2 * xa1[i] + c._a3 * xa2[i] + c._b1 * ya1[i] + c._b2 * ya2[i];
+			xa2[i] = xa1[i];
+			xa1[i] = x[i];
+			ya2[i] = ya1[i];
+			ya1[i] = ya;
+			x[i] = y[i] + ya;
+		}
+	}
+}
+
+/**
+ * @brief Same layout than young_van_vliet_line.
+ * @param[out] tmp buffer of length * width floats
+ * @param[out] sums buffer of width doubles
+ */
+inline void box_line( float* data, float* tmp, double* sums, const std::ptrdiff_t length, const std::ptrdiff_t width, const std::ptrdiff_t radius )
+{
+	if( length == 0 || radius == 0 )
+		return;
+	const double norm = 1.0 / ( 2 * radius + 1 );
+	const std::ptrdiff_t lastIndex = length - 1;
+	for( std::ptrdiff_t pass = 0; pass < kRecursiveBlurBoxPasses; ++pass )
+	{
+		// running sum over [n - radius, n + radius]
+		for( std::ptrdiff_t i = 0; i < width; ++i )
+			sums[i] = data[i] * static_cast<double>( radius + 1 );
+		for( std::ptrdiff_t k = 1; k <= radius; ++k )
+		{
+			const float* x = data + std::min( k, lastIndex ) * width;
+			for( std::ptrdiff_t i = 0; i < width; ++i )
+				sums[i] += x[i];
+		}
+		for( std::ptrdiff_t n = 0; n < length; ++n )
+		{
+			float* y = tmp + n * width;
+			const float* in = data + std::min( n + radius + 1, lastIndex ) * width;
+			const float* out = data + std::max( n - radius, std::ptrdiff_t(0) ) * width;
+			for( std::ptrdiff_t i = 0; i < width; ++i )
+			{
+				y[i] = static_cast<float>( sums[i] * norm );
+				sums[i] += in[i] - out[i];
+			}
+		}
+		std::memcpy( data, tmp, length * width * sizeof(float) );
+	}
+}
+
+/**
+ * @brief Filter lines of floats with one of the recursive_blur_method.
+ */
+template<template<typename> class Alloc>
+class recursive_blur_line_filter
+{
+public:
+	recursive_blur_line_filter( const double sigma, const recursive_blur_method method )
+		: _method( method )
+		, _enabled( sigma > 0 )
+		, _youngVanVliet( sigma )
+		, _deriche( sigma )
+		, _boxRadius( box_blur_radius( sigma ) )
+	{}
+
+	bool enabled() const { return _enabled; }
+
+	void operator()( float* data, const std::ptrdiff_t length, const std::ptrdiff_t width )
+	{
+		if( ! _enabled )
+			return;
+		switch( _method )
+		{
+			case recursive_blur_young_van_vliet:
+				young_van_vliet_line( data, length, width, _youngVanVliet );
+				break;
+			case recursive_blur_deriche:
+				_tmp.resize( length * width );
+				_history.resize( 4 * width );
+				deriche_line( data, &_tmp.front(), &_history.front(), length, width, _deriche );
+				break;
+			case recursive_blur_box:
+				_tmp.resize( length * width );
+				_sums.resize( width );
+				box_line( data, &_tmp.front(), &_sums.front(), length, width, _boxRadius );
+				break;
+		}
+	}
+
+private:
+	recursive_blur_method _method;
+	bool _enabled;
+	young_van_vliet_coefficients _youngVanVliet;
+	deriche_coefficients _deriche;
+	std::ptrdiff_t _boxRadius;
+	std::vector<float, Alloc<float> > _tmp;
+	std::vector<float, Alloc<float> > _history;
+	std::vector<double, Alloc<double> > _sums;
+};
+
+/**
+ * @brief Convert a filtered value to a channel of the output.
+ * Integer channels are rounded to nearest and clamped to the channel range.
+ */
+template<typename Channel>
+inline Channel recursive_blur_channel_cast( const float value, const boost::false_type )
+{
+	return static_cast<Channel>( value );
+}
+
+template<typename Channel>
+inline Channel recursive_blur_channel_cast( const float value, const boost::true_type )
+{
+	const float rounded = std::floor( value + 0.5f );
+	if( rounded <= static_cast<float>( std::numeric_limits<Channel>::min() ) )
+		return std::numeric_limits<Channel>::min();
+	if( rounded >= static_cast<float>( std::numeric_limits<Channel>::max() ) )
+		return std::numeric_limits<Channel>::max();
+	return static_cast<Channel>( rounded );
+}
+
+template<typename Channel>
+inline Channel recursive_blur_channel_cast( const float value )
+{
+	return recursive_blur_channel_cast<Channel>( value, typename boost::is_integral<Channel>::type() );
+}
+
+}
+
+/**
+ * @brief Size of the source needed on each side of the result, for a blur of standard deviation @p sigma.
+ */
+inline std::ptrdiff_t recursive_blur_margin( const double sigma, const recursive_blur_method method )
+{
+	if( sigma <= 0 )
+		return 0;
+	if( method == recursive_blur_box )
+		return detail::kRecursiveBlurBoxPasses * detail::box_blur_radius( sigma );
+	return static_cast<std::ptrdiff_t>( std::ceil( 4.0 * sigma ) );
+}
+
+/**
+ * @brief Separable gaussian blur, with a constant cost per pixel.
+ *
+ * The lines are filtered by blocks of kRecursiveBlurBlockWidth lines, stored
+ * so the samples of all the lines of the block at the same position are
+ * contiguous: the recursion runs on all the lines together. The rows are
+ * transposed in the block for the horizontal pass, into a temporary buffer,
+ * then the columns are filtered from this buffer.
+ * Each line is extended by recursive_blur_margin on each side, with the
+ * boundary option.
+ *
+ * @param src source view
+ * @param dst destination view
+ * @param dst_tl topleft point of dst in src coordinates
+ * @param sigma standard deviation of the gaussian on each axis, 0 to not blur an axis
+ */
+template<template<typename> class Alloc, typename SrcView, typename DstView>
+void recursive_blur( const SrcView& src, const DstView& dst, const typename SrcView::point_t& dst_tl,
+                     const point2<double>& sigma, const recursive_blur_method method,
+                     const convolve_boundary_option option = convolve_option_extend_mirror )
+{
+	typedef typename channel_type<DstView>::type DstChannel;
+	typedef std::vector<float, Alloc<float> > Buffer;
+	static const std::ptrdiff_t nbChannels = num_channels<DstView>::value;
+
+	const std::ptrdiff_t width = dst.width();
+	const std::ptrdiff_t height = dst.height();
+	if( width == 0 || height == 0 || src.width() == 0 || src.height() == 0 )
+		return;
+
+	const std::ptrdiff_t marginX = recursive_blur_margin( sigma.x, method );
+	const std::ptrdiff_t marginY = recursive_blur_margin( sigma.y, method );
+	const std::ptrdiff_t lineLength = width + 2 * marginX;
+	const std::ptrdiff_t columnLength = height + 2 * marginY;
+
+	// source rows used by the vertical pass
+	std::vector<std::ptrdiff_t> rows( columnLength );
+	std::ptrdiff_t rowMin = src.height();
+	std::ptrdiff_t rowMax = -1;
+	for( std::ptrdiff_t j = 0; j < columnLength; ++j )
+	{
+		rows[j] = detail::boundary_index( dst_tl.y - marginY + j, src.height(), option );
+		if( rows[j] < 0 )
+			continue;
+		rowMin = std::min( rowMin, rows[j] );
+		rowMax = std::max( rowMax, rows[j] );
+	}
+
+	// horizontal pass, in a buffer of the dst width,
+	// by blocks of rows transposed so each column of the block is contiguous
+	const std::ptrdiff_t rowSize = width * nbChannels;
+	const std::ptrdiff_t nbRows = rowMax >= rowMin ? rowMax - rowMin + 1 : 0;
+	Buffer rowsBuffer( nbRows * rowSize );
+	{
+		std::vector<std::ptrdiff_t> columns( lineLength );
+		for( std::ptrdiff_t i = 0; i < lineLength; ++i )
+			columns[i] = detail::boundary_index( dst_tl.x - marginX + i, src.width(), option );
+
+		detail::recursive_blur_line_filter<Alloc> filter( sigma.x, method );
+		Buffer block( lineLength * detail::kRecursiveBlurBlockWidth * nbChannels );
+		for( std::ptrdiff_t r0 = 0; r0 < nbRows; r0 += detail::kRecursiveBlurBlockWidth )
+		{
+			const std::ptrdiff_t blockHeight = std::min( detail::kRecursiveBlurBlockWidth, nbRows - r0 );
+			const std::ptrdiff_t blockColumnSize = blockHeight * nbChannels;
+			for( std::ptrdiff_t k = 0; k < blockHeight; ++k )
+			{
+				typename SrcView::x_iterator src_it = src.row_begin( rowMin + r0 + k );
+				float* it_block = &block.front() + k * nbChannels;
+				for( std::ptrdiff_t i = 0; i < lineLength; ++i, it_block += blockColumnSize )
+				{
+					if( columns[i] < 0 )
+					{
+						std::fill_n( it_block, nbChannels, 0.f );
+						continue;
+					}
+					for( std::ptrdiff_t c = 0; c < nbChannels; ++c )
+						it_block[c] = static_cast<float>( src_it[columns[i]][c] );
+				}
+			}
+			filter( &block.front(), lineLength, blockColumnSize );
+			for( std::ptrdiff_t k = 0; k < blockHeight; ++k )
+			{
+				const float* it_block = &block.front() + marginX * blockColumnSize + k * nbChannels;
+				float* it_row = &rowsBuffer.front() + ( r0 + k ) * rowSize;
+				for( std::ptrdiff_t x = 0; x < width; ++x, it_block += blockColumnSize, it_row += nbChannels )
+					std::copy( it_block, it_block + nbChannels, it_row );
+			}
+		}
+	}
+
+	// vertical pass, by blocks of columns
+	detail::recursive_blur_line_filter<Alloc> filter( sigma.y, method );
+	Buffer block( columnLength * detail::kRecursiveBlurBlockWidth * nbChannels );
+	for( std::ptrdiff_t x0 = 0; x0 < width; x0 += detail::kRecursiveBlurBlockWidth )
+	{
+		const std::ptrdiff_t blockWidth = std::min( detail::kRecursiveBlurBlockWidth, width - x0 );
+		const std::ptrdiff_t blockRowSize = blockWidth * nbChannels;
+		for( std::ptrdiff_t j = 0; j < columnLength; ++j )
+		{
+			float* it_block = &block.front() + j * blockRowSize;
+			if( rows[j] < 0 )
+				std::fill_n( it_block, blockRowSize, 0.f );
+			else
+				std::memcpy( it_block, &rowsBuffer.front() + ( rows[j] - rowMin ) * rowSize + x0 * nbChannels, blockRowSize * sizeof(float) );
+		}
+		filter( &block.front(), columnLength, blockRowSize );
+		for( std::ptrdiff_t y = 0; y < height; ++y )
+		{
+			const float* it_block = &block.front() + ( marginY + y ) * blockRowSize;
+			typename DstView::x_iterator dst_it = dst.x_at( x0, y );
+			for( std::ptrdiff_t x = 0; x < blockWidth; ++x, ++dst_it, it_block += nbChannels )
+			{
+				for( std::ptrdiff_t c = 0; c < nbChannels; ++c )
+					( *dst_it )[c] = detail::recursive_blur_channel_cast<DstChannel>( it_block[c] );
+			}
+		}
+	}
+}
+
+}
+}
+
+#endif
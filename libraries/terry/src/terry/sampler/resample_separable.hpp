@@ -0,0 +1,244 @@
+#ifndef _TERRY_SAMPLER_RESAMPLE_SEPARABLE_HPP_
+#define _TERRY_SAMPLER_RESAMPLE_SEPARABLE_HPP_
+
+#include <terry/math/Rect.hpp>
+#include <terry/geometry/affine.hpp>
+#include <terry/basic_colors.hpp>
+
+#include <terry/sampler/resample_progress.hpp>
+#include <terry/sampler/sampler.hpp>
+
+#include <boost/gil/color_convert.hpp>
+#include <boost/gil/metafunctions.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace terry {
+namespace sampler {
+
+namespace details {
+
+/**
+ * @brief Weights of a sampler along one axis, for a scale and a translation.
+ *
+ * The output sample i uses the source samples [_first[i], _first[i] + _windowSize[
+ * with the weights [_weights[i * _windowSize], ...[.
+ * The weights are computed like in sample() for the same position.
+ */
+struct axis_weights
+{
+	std::size_t _windowSize;
+	std::vector<std::ptrdiff_t> _first;
+	std::vector<float> _weights;
+
+	template<typename Sampler>
+	void compute( Sampler& sampler, const double scale, const double translate, const std::ptrdiff_t begin, const std::ptrdiff_t end )
+	{
+		_windowSize = sampler._windowSize;
+		const std::ptrdiff_t middlePosition = ( static_cast<std::ptrdiff_t>( _windowSize ) - 1 ) / 2;
+		_first.resize( end - begin );
+		_weights.resize( ( end - begin ) * _windowSize );
+
+		for( std::ptrdiff_t i = begin; i < end; ++i )
+		{
+			const double p = scale * i + translate;
+			const std::ptrdiff_t pTL = static_cast<std::ptrdiff_t>( std::floor( p ) );
+			const RESAMPLING_CORE_TYPE frac = p - pTL;
+			_first[i - begin] = pTL - middlePosition;
+			for( std::size_t k = 0; k < _windowSize; ++k )
+			{
+				const RESAMPLING_CORE_TYPE distance = - frac - middlePosition + k;
+				sampler( distance, _weights[( i - begin ) * _windowSize + k] );
+			}
+		}
+	}
+};
+
+}
+
+/**
+ * @brief The separable resampling can be used for the transformation @p dst_to_src.
+ *
+ * The transformation has to be a scale and a translation.
+ * The mirror mode out of the image is only supported by the 2D resampling.
+ */
+inline bool resample_is_separable( const matrix3x2<double>& dst_to_src, const EParamFilterOutOfImage outOfImageProcess )
+{
+	return dst_to_src.b == 0.0 && dst_to_src.c == 0.0 &&
+	       outOfImageProcess != eParamFilterOutMirror;
+}
+
+/**
+ * @brief Resampling with a scale and a translation, as a horizontal pass then a vertical pass.
+ *
+ * Same result than resample_pixels_progress for the same sampler, with a cost
+ * of 2 * windowSize operations per pixel instead of windowSize^2.
+ * The weights of the columns and of the rows are computed once.
+ * Each source line is filtered horizontally once into a ring of
+ * windowSize lines in floating point, then each output line is the weighted sum
+ * of the lines of the ring, which is vectorized by the compiler.
+ *
+ * @pre resample_is_separable( dst_to_src, outOfImageProcess )
+ */
+template<
+	typename Sampler, // Models SamplerConcept
+	typename SrcView, // Models RandomAccess2DImageViewConcept
+	typename DstView, // Models MutableRandomAccess2DImageViewConcept
+	typename Progress>
+void resample_pixels_separable_progress(
+	const SrcView& src_view, const DstView& dst_view,
+	const matrix3x2<double>& dst_to_src, const terry::Rect<std::ssize_t>& procWindow,
+	const EParamFilterOutOfImage& outOfImageProcess,
+	Progress& p,
+	Sampler sampler = Sampler() )
+{
+	typedef typename SrcView::value_type SrcP;
+	typedef typename floating_pixel_from_view<SrcView>::type SrcC;
+	static const std::ptrdiff_t nbChannels = boost::gil::num_channels<SrcView>::value;
+
+	const terry::point2<std::ssize_t> procWindowSize = procWindow.size();
+	const std::ptrdiff_t srcWidth = src_view.width();
+	const std::ptrdiff_t srcHeight = src_view.height();
+	if( procWindowSize.x <= 0 || procWindowSize.y <= 0 )
+		return;
+	if( srcWidth == 0 || srcHeight == 0 )
+	{
+		resample_pixels_progress( src_view, dst_view, dst_to_src, procWindow, outOfImageProcess, p, sampler );
+		return;
+	}
+
+	details::axis_weights columns;
+	columns.compute( sampler, dst_to_src.a, dst_to_src.e, procWindow.x1, procWindow.x2 );
+	details::axis_weights rows;
+	rows.compute( sampler, dst_to_src.d, dst_to_src.f, procWindow.y1, procWindow.y2 );
+	const std::ptrdiff_t windowSize = columns._windowSize;
+
+	// value of the pixels out of the source image
+	SrcC outside( 0 );
+	if( outOfImageProcess == eParamFilterOutBlack )
+		color_convert( get_black<SrcP>(), outside );
+	// the floating point channels are stored as floats
+	const float* outsideChannels = reinterpret_cast<const float*>( &outside[0] );
+
+	// a source line with windowSize pixels out of the image on each side
+	const std::ptrdiff_t border = windowSize;
+	std::vector<SrcC> line( srcWidth + 2 * border, outside );
+	for( std::ptrdiff_t x = 0; x < procWindowSize.x; ++x )
+		columns._first[x] = std::max( -border, std::min( srcWidth, columns._first[x] ) ) + border;
+
+	// ring of the source lines filtered horizontally, the line y is at y % windowSize
+	const std::ptrdiff_t lineSize = procWindowSize.x * nbChannels;
+	std::vector<float> ring( windowSize * lineSize );
+	std::vector<std::ptrdiff_t> ringLines( windowSize, -1 );
+	std::vector<float> accumulator( lineSize );
+
+	for( std::ptrdiff_t y = 0; y < procWindowSize.y; ++y )
+	{
+		std::fill( accumulator.begin(), accumulator.end(), 0.f );
+		float outsideWeight = 0.f;
+
+		for( std::ptrdiff_t k = 0; k < windowSize; ++k )
+		{
+			const float weight = rows._weights[y * windowSize + k];
+			std::ptrdiff_t srcY = rows._first[y] + k;
+			if( srcY < 0 || srcY >= srcHeight )
+			{
+				if( outOfImageProcess != eParamFilterOutCopy )
+				{
+					outsideWeight += weight;
+					continue;
+				}
+				srcY = std::max( std::ptrdiff_t(0), std::min( srcHeight - 1, srcY ) );
+			}
+
+			float* filtered = &ring[( srcY % windowSize ) * lineSize];
+			if( ringLines[srcY % windowSize] != srcY )
+			{
+				// horizontal pass of the source line
+				ringLines[srcY % windowSize] = srcY;
+				typename SrcView::x_iterator srcIt = src_view.row_begin( srcY );
+				for( std::ptrdiff_t x = 0; x < srcWidth; ++x )
+					color_convert( srcIt[x], line[border + x] );
+				if( outOfImageProcess == eParamFilterOutCopy )
+				{
+					std::fill( line.begin(), line.begin() + border, line[border] );
+					std::fill( line.end() - border, line.end(), line[border + srcWidth - 1] );
+				}
+
+				const float* lineChannels = reinterpret_cast<const float*>( &line[0][0] );
+				for( std::ptrdiff_t x = 0; x < procWindowSize.x; ++x )
+				{
+					const float* weights = &columns._weights[x * windowSize];
+					const float* src = lineChannels + columns._first[x] * nbChannels;
+					float sum[nbChannels];
+					for( std::ptrdiff_t c = 0; c < nbChannels; ++c )
+						sum[c] = 0.f;
+					for( std::ptrdiff_t i = 0; i < windowSize; ++i )
+					{
+						for( std::ptrdiff_t c = 0; c < nbChannels; ++c )
+							sum[c] += weights[i] * src[i * nbChannels + c];
+					}
+					for( std::ptrdiff_t c = 0; c < nbChannels; ++c )
+						filtered[x * nbChannels + c] = sum[c];
+				}
+			}
+
+			// vertical pass
+			float* acc = &accumulator[0];
+			for( std::ptrdiff_t i = 0; i < lineSize; ++i )
+				acc[i] += weight * filtered[i];
+		}
+
+		if( outsideWeight != 0.f )
+		{
+			for( std::ptrdiff_t x = 0; x < procWindowSize.x; ++x )
+			{
+				for( std::ptrdiff_t c = 0; c < nbChannels; ++c )
+					accumulator[x * nbChannels + c] += outsideWeight * outsideChannels[c];
+			}
+		}
+
+		// convert from floating point to the destination type
+		typename DstView::x_iterator dstIt = dst_view.row_begin( procWindow.y1 + y ) + procWindow.x1;
+		SrcC result;
+		for( std::ptrdiff_t x = 0; x < procWindowSize.x; ++x )
+		{
+			for( std::ptrdiff_t c = 0; c < nbChannels; ++c )
+				result[c] = accumulator[x * nbChannels + c];
+			color_convert( result, dstIt[x] );
+		}
+
+		if( p.progressForward( procWindowSize.x ) )
+			return;
+	}
+}
+
+/**
+ * @brief Resampling with an affine transformation, separable when possible.
+ * @see resample_pixels_separable_progress, resample_pixels_progress
+ */
+template<
+	typename Sampler,
+	typename SrcView,
+	typename DstView,
+	typename Progress>
+void resample_pixels_affine_progress(
+	const SrcView& src_view, const DstView& dst_view,
+	const matrix3x2<double>& dst_to_src, const terry::Rect<std::ssize_t>& procWindow,
+	const EParamFilterOutOfImage& outOfImageProcess,
+	Progress& p,
+	Sampler sampler = Sampler() )
+{
+	if( resample_is_separable( dst_to_src, outOfImageProcess ) )
+		resample_pixels_separable_progress( src_view, dst_view, dst_to_src, procWindow, outOfImageProcess, p, sampler );
+	else
+		resample_pixels_progress( src_view, dst_view, dst_to_src, procWindow, outOfImageProcess, p, sampler );
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,191 @@
+#include <terry/globals.hpp>
+#include <terry/filter/recursiveBlur.hpp>
+#include <terry/filter/gaussianKernel.hpp>
+
+#include <boost/gil/image.hpp>
+#include <boost/gil/algorithm.hpp>
+
+#include <memory>
+#include <cmath>
+#include <algorithm>
+
+#include <boost/test/unit_test.hpp>
+using namespace boost::unit_test;
+
+namespace {
+
+const terry::filter::recursive_blur_method kMethods[] = {
+	terry::filter::recursive_blur_young_van_vliet,
+	terry::filter::recursive_blur_deriche,
+	terry::filter::recursive_blur_box };
+const std::size_t kNbMethods = sizeof( kMethods ) / sizeof( terry::filter::recursive_blur_method );
+
+/// @return the variance of the blur of an impulse along a line, with the standard deviation @p sigma
+double impulseVariance( const terry::filter::recursive_blur_method method, const double sigma )
+{
+	using namespace terry;
+	using namespace terry::filter;
+
+	const std::ptrdiff_t center = 100;
+	gray32f_image_t inImage( 2 * center + 1, 1 );
+	fill_pixels( view( inImage ), gray32f_pixel_t( 0.f ) );
+	view( inImage )( center, 0 ) = gray32f_pixel_t( 1.f );
+	gray32f_image_t outImage( 2 * center + 1, 1 );
+	// no vertical blur
+	recursive_blur<std::allocator>( const_view( inImage ), view( outImage ), gray32f_view_t::point_t( 0, 0 ),
+	                                point2<double>( sigma, 0 ), method, convolve_option_extend_zero );
+
+	double sum = 0;
+	double mean = 0;
+	for( std::ptrdiff_t x = 0; x < outImage.width(); ++x )
+	{
+		const double v = const_view( outImage )( x, 0 )[0];
+		sum += v;
+		mean += v * x;
+	}
+	mean /= sum;
+	double variance = 0;
+	for( std::ptrdiff_t x = 0; x < outImage.width(); ++x )
+	{
+		const double v = const_view( outImage )( x, 0 )[0];
+		variance += v * ( x - mean ) * ( x - mean );
+	}
+	BOOST_CHECK_CLOSE( sum, 1.0, 0.1 );
+	BOOST_CHECK_SMALL( mean - center, 0.01 );
+	return variance / sum;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE( terry_filter_recursiveBlur )
+
+BOOST_AUTO_TEST_CASE( recursiveBlurConstant )
+{
+	using namespace terry;
+	using namespace terry::filter;
+
+	// a blur keeps a constant image, on all the image and on a tile
+	rgb32f_image_t inImage( 40, 30 );
+	fill_pixels( view( inImage ), rgb32f_pixel_t( 0.5f, 0.25f, 1.0f ) );
+	rgb32f_image_t outImage( 20, 10 );
+	for( std::size_t m = 0; m < kNbMethods; ++m )
+	{
+		recursive_blur<std::allocator>(
+				const_view( inImage ), view( outImage ),
+				rgb32f_view_t::point_t( 5, 12 ),
+				point2<double>( 12, 3 ),
+				kMethods[m],
+				convolve_option_extend_mirror
+			);
+		for( int y = 0; y < outImage.height(); ++y )
+		{
+			for( int x = 0; x < outImage.width(); ++x )
+			{
+				const rgb32f_pixel_t p = const_view( outImage )( x, y );
+				BOOST_CHECK_CLOSE( float( p[0] ), 0.5f, 0.01f );
+				BOOST_CHECK_CLOSE( float( p[1] ), 0.25f, 0.01f );
+				BOOST_CHECK_CLOSE( float( p[2] ), 1.0f, 0.01f );
+			}
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE( recursiveBlurConstant8Bits )
+{
+	using namespace terry;
+	using namespace terry::filter;
+
+	// integer channels are rounded, the extreme values are clamped
+	rgb8_image_t inImage( 40, 30 );
+	fill_pixels( view( inImage ), rgb8_pixel_t( 0, 100, 255 ) );
+	rgb8_image_t outImage( 20, 10 );
+	for( std::size_t m = 0; m < kNbMethods; ++m )
+	{
+		recursive_blur<std::allocator>(
+				const_view( inImage ), view( outImage ),
+				rgb8_view_t::point_t( 5, 12 ),
+				point2<double>( 12, 3 ),
+				kMethods[m],
+				convolve_option_extend_mirror
+			);
+		for( int y = 0; y < outImage.height(); ++y )
+		{
+			for( int x = 0; x < outImage.width(); ++x )
+			{
+				const rgb8_pixel_t p = const_view( outImage )( x, y );
+				BOOST_CHECK_EQUAL( int( p[0] ), 0 );
+				BOOST_CHECK_EQUAL( int( p[1] ), 100 );
+				BOOST_CHECK_EQUAL( int( p[2] ), 255 );
+			}
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE( recursiveBlurImpulseVariance )
+{
+	// the 3 iterated boxes of width w have a variance of (w^2 - 1) / 4,
+	// so these sigmas are exact for the box blur too
+	const double variances[] = { 6.0, 20.0, 42.0, 110.0 };
+	for( std::size_t m = 0; m < kNbMethods; ++m )
+	{
+		for( std::size_t i = 0; i < sizeof( variances ) / sizeof( double ); ++i )
+		{
+			BOOST_TEST_MESSAGE( "method " << kMethods[m] << ", sigma^2 " << variances[i] );
+			BOOST_CHECK_CLOSE( impulseVariance( kMethods[m], std::sqrt( variances[i] ) ), variances[i], 2.0 );
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE( recursiveBlurConvolution )
+{
+	using namespace terry;
+	using namespace terry::filter;
+
+	// the recursive blurs are close to the convolution by a gaussian kernel
+	const std::ptrdiff_t width = 160;
+	const std::ptrdiff_t height = 120;
+	rgb32f_image_t inImage( width, height );
+	for( std::ptrdiff_t y = 0; y < height; ++y )
+	{
+		for( std::ptrdiff_t x = 0; x < width; ++x )
+		{
+			view( inImage )( x, y ) = rgb32f_pixel_t(
+				x < width / 2 ? 0.2f : 0.9f,
+				0.5f + 0.5f * static_cast<float>( std::sin( x * 0.15 ) * std::cos( y * 0.1 ) ),
+				static_cast<float>( ( x / 8 + y / 8 ) % 2 ) );
+		}
+	}
+
+	const double sigma = 3.0;
+	// inside the image, so the result doesn't depend on the boundary option
+	const rgb32f_view_t::point_t dst_tl( 30, 30 );
+	rgb32f_image_t convolutionImage( width - 60, height - 60 );
+	// the kernel of buildGaussian1DKernel has a variance of size
+	const kernel_1d<float> kernel = buildGaussian1DKernel<float>( static_cast<float>( sigma * sigma ), true, 1e-6 );
+	BOOST_REQUIRE_LE( kernel.left_size(), std::size_t( dst_tl.x ) );
+	correlate_rows_cols_auto<rgb32f_pixel_t, std::allocator>(
+		const_view( inImage ), kernel, kernel, view( convolutionImage ), dst_tl, convolve_option_extend_mirror );
+
+	// maximum difference for each method, on the sharp edges of the checkerboard:
+	// the recursive filters are truncated to the margin and the box blur is only an approximation
+	const float tolerances[] = { 0.04f, 0.05f, 0.12f };
+	rgb32f_image_t outImage( width - 60, height - 60 );
+	for( std::size_t m = 0; m < kNbMethods; ++m )
+	{
+		recursive_blur<std::allocator>( const_view( inImage ), view( outImage ), dst_tl,
+		                                point2<double>( sigma, sigma ), kMethods[m], convolve_option_extend_mirror );
+		float maxDiff = 0;
+		for( std::ptrdiff_t y = 0; y < outImage.height(); ++y )
+		{
+			for( std::ptrdiff_t x = 0; x < outImage.width(); ++x )
+			{
+				for( int c = 0; c < 3; ++c )
+					maxDiff = std::max( maxDiff, std::abs( const_view( outImage )( x, y )[c] - const_view( convolutionImage )( x, y )[c] ) );
+			}
+		}
+		BOOST_TEST_MESSAGE( "method " << kMethods[m] << ", max difference " << maxDiff );
+		BOOST_CHECK_SMALL( maxDiff, tolerances[m] );
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,117 @@
+#include <terry/globals.hpp>
+#include <terry/sampler/resample_separable.hpp>
+
+#include <boost/gil/image.hpp>
+#include <boost/gil/algorithm.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+#define BOOST_TEST_MODULE terry_sampler_tests
+#include <boost/test/unit_test.hpp>
+using namespace boost::unit_test;
+
+namespace {
+
+struct NoProgress
+{
+	bool progressForward( const int ) { return false; }
+};
+
+const terry::sampler::EParamFilterOutOfImage kOutOfImages[] = {
+	terry::sampler::eParamFilterOutBlack,
+	terry::sampler::eParamFilterOutTransparency,
+	terry::sampler::eParamFilterOutCopy };
+const std::size_t kNbOutOfImages = sizeof( kOutOfImages ) / sizeof( terry::sampler::EParamFilterOutOfImage );
+
+/// @brief Source with smooth parts and sharp edges, on all the channels.
+void fillSource( const terry::rgba32f_view_t& src )
+{
+	for( std::ptrdiff_t y = 0; y < src.height(); ++y )
+	{
+		for( std::ptrdiff_t x = 0; x < src.width(); ++x )
+		{
+			src( x, y ) = terry::rgba32f_pixel_t(
+				static_cast<float>( x ) / src.width(),
+				static_cast<float>( ( x / 4 + y / 4 ) % 2 ),
+				0.5f + 0.5f * static_cast<float>( std::sin( x * 0.4 + y * 0.3 ) ),
+				y < src.height() / 2 ? 1.f : 0.25f );
+		}
+	}
+}
+
+/**
+ * @brief Compare resample_pixels_separable_progress with resample_pixels_progress,
+ * on a part of the output, with the modes supported by the separable resampling.
+ */
+template<typename Sampler>
+void checkSeparable( const terry::matrix3x2<double>& dst_to_src )
+{
+	using namespace terry;
+	using namespace terry::sampler;
+
+	rgba32f_image_t srcImage( 37, 23 );
+	fillSource( view( srcImage ) );
+
+	const rgba32f_pixel_t untouched( 7.f, 7.f, 7.f, 7.f );
+	const Rect<std::ssize_t> procWindow( 3, 2, 45, 35 );
+	for( std::size_t o = 0; o < kNbOutOfImages; ++o )
+	{
+		BOOST_REQUIRE( resample_is_separable( dst_to_src, kOutOfImages[o] ) );
+
+		rgba32f_image_t expectedImage( 48, 36 );
+		fill_pixels( view( expectedImage ), untouched );
+		NoProgress progress;
+		resample_pixels_progress( const_view( srcImage ), view( expectedImage ), dst_to_src, procWindow, kOutOfImages[o], progress, Sampler() );
+
+		rgba32f_image_t outImage( 48, 36 );
+		fill_pixels( view( outImage ), untouched );
+		resample_pixels_separable_progress( const_view( srcImage ), view( outImage ), dst_to_src, procWindow, kOutOfImages[o], progress, Sampler() );
+
+		float maxDiff = 0;
+		for( std::ptrdiff_t y = 0; y < outImage.height(); ++y )
+		{
+			for( std::ptrdiff_t x = 0; x < outImage.width(); ++x )
+			{
+				for( int c = 0; c < 4; ++c )
+					maxDiff = std::max( maxDiff, std::abs( const_view( outImage )( x, y )[c] - const_view( expectedImage )( x, y )[c] ) );
+			}
+		}
+		BOOST_TEST_MESSAGE( "out of image " << kOutOfImages[o] << ", max difference " << maxDiff );
+		// the weights are floats in the separable resampling, doubles in the 2D resampling
+		BOOST_CHECK_SMALL( maxDiff, 1e-4f );
+	}
+}
+
+template<typename Sampler>
+void checkSeparableTransforms()
+{
+	typedef terry::matrix3x2<double> Matrix;
+	// magnification, the output goes out of the source on the left and at the bottom
+	checkSeparable<Sampler>( Matrix::get_scale( 0.6, 0.45 ) * Matrix::get_translate( -4.3, -2.6 ) );
+	// minification, the output goes out of the source on the right and at the top
+	checkSeparable<Sampler>( Matrix::get_scale( 1.7, 2.3 ) * Matrix::get_translate( 3.5, -6.25 ) );
+	// translation only, far out of the source on the left
+	checkSeparable<Sampler>( Matrix::get_translate( -30.5, 7.2 ) );
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE( terry_sampler_resample_separable )
+
+BOOST_AUTO_TEST_CASE( separableBilinear )
+{
+	checkSeparableTransforms<terry::sampler::bilinear_sampler>();
+}
+
+BOOST_AUTO_TEST_CASE( separableBicubic )
+{
+	checkSeparableTransforms<terry::sampler::bicubic_sampler>();
+}
+
+BOOST_AUTO_TEST_CASE( separableLanczos )
+{
+	checkSeparableTransforms<terry::sampler::lanczos3_sampler>();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
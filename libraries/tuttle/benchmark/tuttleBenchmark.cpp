@@ -0,0 +1,418 @@
+/**
+ * @brief Benchmark of the host on synthetic graphs.
+ *
+ * Each benchmark case is a generator (no input media needed) followed by a
+ * standard process, rendered at a resolution and a bit depth. The cases are
+ * rendered multiple times and the benchmark reports the frames per second,
+ * the peak memory used in the MemoryPool and the time spent in each node.
+ *
+ * Usage: tuttleBenchmark [--filter name] [--iterations n] [--frames n]
+ *                        [--parallel-nodes n] [--parallel-frames n]
+ *                        [--json file] [--trace directory]
+ */
+#include <tuttle/host/Graph.hpp>
+#include <tuttle/host/Node.hpp>
+#include <tuttle/host/Core.hpp>
+#include <tuttle/host/RenderProfile.hpp>
+#include <tuttle/host/memory/MemoryCache.hpp>
+#include <tuttle/host/memory/NodeOutputCache.hpp>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <boost/timer/timer.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/exception/diagnostic_information.hpp>
+#include <boost/foreach.hpp>
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <cstring>
+
+namespace bfs = boost::filesystem;
+using namespace tuttle::host;
+
+namespace {
+
+struct Resolution
+{
+	const char* _name;
+	const char* _format; ///< format option of the generators
+};
+
+struct BitDepth
+{
+	const char* _name;
+	const char* _explicitConversion; ///< explicitConversion option of the generators
+};
+
+const Resolution resolutions[] = {
+	{ "SD", "PAL" },
+	{ "2K", "2K-Super35-full-ap" },
+	{ "4K", "4K-Super35-full-ap" },
+};
+
+const BitDepth bitDepths[] = {
+	{ "8i", "8i" },
+	{ "16i", "16i" },
+	{ "32f", "32f" },
+};
+
+const char* generators[] = { "tuttle.checkerboard", "tuttle.constant", "tuttle.ramp" };
+
+const char* chains[] = { "blur", "resize", "lut", "merge", "colorspace" };
+
+template<class T, std::size_t N>
+std::size_t arraySize( const T (&)[N] ) { return N; }
+
+struct BenchmarkOptions
+{
+	BenchmarkOptions()
+		: _nbIterations( 3 )
+		, _nbFrames( 4 )
+		, _nbParallelNodes( 1 )
+		, _nbParallelFrames( 1 )
+	{}
+
+	std::string _filter; ///< only run the cases with this string in their name
+	std::size_t _nbIterations;
+	std::size_t _nbFrames; ///< number of frames rendered by each iteration
+	std::size_t _nbParallelNodes;
+	std::size_t _nbParallelFrames;
+	std::string _jsonFilename;
+	std::string _traceDirectory;
+};
+
+struct BenchmarkCase
+{
+	std::string _name;
+	std::string _generator;
+	std::string _chain;
+	const Resolution* _resolution;
+	const BitDepth* _bitDepth;
+};
+
+struct BenchmarkResult
+{
+	BenchmarkResult()
+		: _framesPerSecond( 0 )
+		, _frameTime( 0 )
+		, _peakMemory( 0 )
+		, _failed( false )
+	{}
+
+	double _framesPerSecond;
+	double _frameTime; ///< wall time per frame in milliseconds
+	std::size_t _peakMemory; ///< peak memory used in the MemoryPool in bytes
+	std::map<std::string, double> _nodeTimes; ///< process time per frame for each node in milliseconds
+	bool _failed;
+};
+
+void usage( std::ostream& os )
+{
+	os << "Usage: tuttleBenchmark [options]\n"
+	   << "  --filter name         only run the cases containing this name (e.g. \"blur-2K\")\n"
+	   << "  --iterations n        number of timed renders of each case (default 3)\n"
+	   << "  --frames n            number of frames of each render (default 4)\n"
+	   << "  --parallel-nodes n    see ComputeOptions::setNbParallelNodes (default 1)\n"
+	   << "  --parallel-frames n   see ComputeOptions::setNbParallelFrames (default 1)\n"
+	   << "  --json file           write the results in JSON\n"
+	   << "  --trace directory     write a Chrome trace of each case\n"
+	   << "  --list                list the cases\n"
+	   << "  --help\n";
+}
+
+std::vector<BenchmarkCase> getBenchmarkCases( const std::string& filter )
+{
+	std::vector<BenchmarkCase> cases;
+	for( std::size_t g = 0; g < arraySize( generators ); ++g )
+	for( std::size_t c = 0; c < arraySize( chains ); ++c )
+	for( std::size_t r = 0; r < arraySize( resolutions ); ++r )
+	for( std::size_t b = 0; b < arraySize( bitDepths ); ++b )
+	{
+		BenchmarkCase bcase;
+		bcase._generator = generators[g];
+		bcase._chain = chains[c];
+		bcase._resolution = &resolutions[r];
+		bcase._bitDepth = &bitDepths[b];
+		bcase._name = bcase._generator.substr( std::strlen( "tuttle." ) ) + "-" + bcase._chain + "-" + resolutions[r]._name + "-" + bitDepths[b]._name;
+		if( bcase._name.find( filter ) != std::string::npos )
+			cases.push_back( bcase );
+	}
+	return cases;
+}
+
+/**
+ * @brief Write a 3D LUT with 17 steps, close to the identity.
+ */
+void writeLutFile( const bfs::path& filename )
+{
+	static const int nbSteps = 17;
+	bfs::ofstream file( filename );
+	file << "# tuttleBenchmark lut\n";
+	for( int i = 0; i < nbSteps; ++i )
+		file << ( i ? " " : "" ) << i * 1023 / ( nbSteps - 1 );
+	file << "\n";
+	for( int r = 0; r < nbSteps; ++r )
+	for( int g = 0; g < nbSteps; ++g )
+	for( int b = 0; b < nbSteps; ++b )
+	{
+		// a small contrast change, so the lut isn't an identity
+		file << std::min( 4095, r * 4095 / ( nbSteps - 1 ) + r % 3 ) << " "
+		     << std::min( 4095, g * 4095 / ( nbSteps - 1 ) ) << " "
+		     << std::min( 4095, b * 4095 / ( nbSteps - 1 ) + b % 2 ) << "\n";
+	}
+}
+
+INode& addGenerator( Graph& graph, const std::string& id, const BenchmarkCase& bcase )
+{
+	return graph.addNode(
+		NodeInit( id )
+			.setParamExp( "explicitConversion", bcase._bitDepth->_explicitConversion )
+			.setParamExp( "mode", "format" )
+			.setParamExp( "format", bcase._resolution->_format ) );
+}
+
+/**
+ * @brief Build the graph of a benchmark case.
+ * @return the final node
+ */
+INode& buildGraph( Graph& graph, const BenchmarkCase& bcase, const bfs::path& lutFilename )
+{
+	INode& generator = addGenerator( graph, bcase._generator, bcase );
+
+	if( bcase._chain == "merge" )
+	{
+		const std::string otherId = bcase._generator == "tuttle.ramp" ? "tuttle.checkerboard" : "tuttle.ramp";
+		INode& other = addGenerator( graph, otherId, bcase );
+		INode& merge = graph.addNode( NodeInit( "tuttle.merge" ).setParamExp( "mergingFunction", "over" ) );
+		graph.connect( generator, merge.getAttribute( "A" ) );
+		graph.connect( other, merge.getAttribute( "B" ) );
+		return merge;
+	}
+
+	NodeInit process;
+	if( bcase._chain == "blur" )
+	{
+		process = NodeInit( "tuttle.blur" ).setParam( "size", 8.0, 8.0 );
+	}
+	else if( bcase._chain == "resize" )
+	{
+		process = NodeInit( "tuttle.resize" ).setParamExp( "mode", "scale" ).setParam( "scale", 0.5, 0.5 );
+	}
+	else if( bcase._chain == "lut" )
+	{
+		process = NodeInit( "tuttle.lut" ).setParam( "filename", lutFilename.string().c_str() );
+	}
+	else // colorspace
+	{
+		process = NodeInit( "tuttle.colorspace" ).setParamExp( "outputReferenceSpace", "1" );
+	}
+	INode& processNode = graph.addNode( process );
+	graph.connect( generator, processNode );
+	return processNode;
+}
+
+BenchmarkResult runBenchmarkCase( const BenchmarkCase& bcase, const BenchmarkOptions& benchOptions, const bfs::path& lutFilename )
+{
+	BenchmarkResult result;
+
+	Graph graph;
+	INode& output = buildGraph( graph, bcase, lutFilename );
+
+	ComputeOptions options;
+	options.setTimeRange( 0, benchOptions._nbFrames - 1 );
+	options.setReturnBuffers( false );
+	options.setNbParallelNodes( benchOptions._nbParallelNodes );
+	options.setNbParallelFrames( benchOptions._nbParallelFrames );
+
+	memory::MemoryCache outCache;
+
+	// warm up: load the plugins and fill the MemoryPool
+	if( ! graph.compute( outCache, NodeListArg( output ), options ) )
+	{
+		result._failed = true;
+		return result;
+	}
+
+	options.setProfiling();
+	core().getMemoryPool().resetPeakUsedMemorySize();
+	boost::timer::cpu_timer timer;
+	for( std::size_t i = 0; i < benchOptions._nbIterations; ++i )
+	{
+		if( ! graph.compute( outCache, NodeListArg( output ), options ) )
+		{
+			result._failed = true;
+			return result;
+		}
+	}
+	const double wallTime = timer.elapsed().wall * 1e-9;
+	const double nbFrames = static_cast<double>( benchOptions._nbIterations * benchOptions._nbFrames );
+
+	result._framesPerSecond = wallTime > 0 ? nbFrames / wallTime : 0;
+	result._frameTime = wallTime * 1e3 / nbFrames;
+	result._peakMemory = core().getMemoryPool().getPeakUsedMemorySize();
+
+	const RenderProfile& profile = *options.getRenderProfile();
+	BOOST_FOREACH( const RenderProfile::Event& event, profile.getEvents() )
+	{
+		if( event._phase == "process" )
+			result._nodeTimes[event._name] += event._duration * 1e-3 / nbFrames;
+	}
+	if( ! benchOptions._traceDirectory.empty() )
+	{
+		profile.exportChromeTrace( ( bfs::path( benchOptions._traceDirectory ) / ( bcase._name + ".json" ) ).string() );
+	}
+	return result;
+}
+
+void printResult( std::ostream& os, const BenchmarkCase& bcase, const BenchmarkResult& result )
+{
+	if( result._failed )
+	{
+		os << std::setw( 32 ) << std::left << bcase._name << " FAILED" << std::endl;
+		return;
+	}
+	os << std::setw( 32 ) << std::left << bcase._name << std::right << std::fixed
+	   << std::setw( 10 ) << std::setprecision( 2 ) << result._framesPerSecond << " fps"
+	   << std::setw( 10 ) << std::setprecision( 2 ) << result._frameTime << " ms/frame"
+	   << std::setw( 10 ) << std::setprecision( 1 ) << result._peakMemory / ( 1024.0 * 1024.0 ) << " MB peak" << std::endl;
+	for( std::map<std::string, double>::const_iterator it = result._nodeTimes.begin(), itEnd = result._nodeTimes.end(); it != itEnd; ++it )
+	{
+		os << "    " << std::setw( 28 ) << std::left << it->first << std::right
+		   << std::setw( 10 ) << std::setprecision( 2 ) << it->second << " ms/frame" << std::endl;
+	}
+}
+
+void writeJson( const std::string& filename, const std::vector<BenchmarkCase>& cases, const std::vector<BenchmarkResult>& results )
+{
+	std::ofstream file( filename.c_str() );
+	if( ! file )
+	{
+		BOOST_THROW_EXCEPTION( exception::File()
+			<< exception::user() + "Can't write the benchmark results."
+			<< exception::filename( filename ) );
+	}
+	file << "[";
+	for( std::size_t i = 0; i < cases.size(); ++i )
+	{
+		const BenchmarkResult& result = results[i];
+		file << ( i ? ",\n" : "\n" )
+		     << "{\"name\": \"" << cases[i]._name << "\""
+		     << ", \"failed\": " << ( result._failed ? "true" : "false" )
+		     << ", \"fps\": " << result._framesPerSecond
+		     << ", \"frameTime\": " << result._frameTime
+		     << ", \"peakMemory\": " << result._peakMemory
+		     << ", \"nodes\": {";
+		bool first = true;
+		for( std::map<std::string, double>::const_iterator it = result._nodeTimes.begin(), itEnd = result._nodeTimes.end(); it != itEnd; ++it, first = false )
+		{
+			file << ( first ? "" : ", " ) << "\"" << it->first << "\": " << it->second;
+		}
+		file << "}}";
+	}
+	file << "\n]\n";
+}
+
+}
+
+int main( int argc, char** argv )
+{
+	BenchmarkOptions benchOptions;
+	bool listOnly = false;
+	try
+	{
+		for( int i = 1; i < argc; ++i )
+		{
+			const std::string arg = argv[i];
+			const bool hasValue = i + 1 < argc;
+			if( arg == "--help" || arg == "-h" )
+			{
+				usage( std::cout );
+				return 0;
+			}
+			else if( arg == "--list" )
+				listOnly = true;
+			else if( arg == "--filter" && hasValue )
+				benchOptions._filter = argv[++i];
+			else if( arg == "--iterations" && hasValue )
+				benchOptions._nbIterations = boost::lexical_cast<std::size_t>( argv[++i] );
+			else if( arg == "--frames" && hasValue )
+				benchOptions._nbFrames = boost::lexical_cast<std::size_t>( argv[++i] );
+			else if( arg == "--parallel-nodes" && hasValue )
+				benchOptions._nbParallelNodes = boost::lexical_cast<std::size_t>( argv[++i] );
+			else if( arg == "--parallel-frames" && hasValue )
+				benchOptions._nbParallelFrames = boost::lexical_cast<std::size_t>( argv[++i] );
+			else if( arg == "--json" && hasValue )
+				benchOptions._jsonFilename = argv[++i];
+			else if( arg == "--trace" && hasValue )
+				benchOptions._traceDirectory = argv[++i];
+			else
+			{
+				std::cerr << "Unknown or incomplete option: " << arg << std::endl;
+				usage( std::cerr );
+				return 1;
+			}
+		}
+	}
+	catch( const boost::bad_lexical_cast& )
+	{
+		usage( std::cerr );
+		return 1;
+	}
+	if( benchOptions._nbIterations == 0 || benchOptions._nbFrames == 0 )
+	{
+		std::cerr << "The number of iterations and frames can't be 0." << std::endl;
+		return 1;
+	}
+
+	const std::vector<BenchmarkCase> cases = getBenchmarkCases( benchOptions._filter );
+	if( listOnly )
+	{
+		BOOST_FOREACH( const BenchmarkCase& bcase, cases )
+			std::cout << bcase._name << std::endl;
+		return 0;
+	}
+
+	core().preload();
+	// the outputs must be computed at each iteration
+	core().getNodeOutputCache().setMaxMemorySize( 0 );
+
+	const bfs::path lutFilename = bfs::temp_directory_path() / bfs::unique_path( "tuttleBenchmark-%%%%-%%%%.3dl" );
+	writeLutFile( lutFilename );
+
+	std::cout << cases.size() << " cases, " << benchOptions._nbIterations << " iterations of "
+	          << benchOptions._nbFrames << " frames" << std::endl;
+
+	int status = 0;
+	std::vector<BenchmarkResult> results;
+	BOOST_FOREACH( const BenchmarkCase& bcase, cases )
+	{
+		BenchmarkResult result;
+		try
+		{
+			result = runBenchmarkCase( bcase, benchOptions, lutFilename );
+		}
+		catch( ... )
+		{
+			std::cerr << bcase._name << ": " << boost::current_exception_diagnostic_information() << std::endl;
+			result._failed = true;
+		}
+		if( result._failed )
+			status = 1;
+		printResult( std::cout, bcase, result );
+		results.push_back( result );
+	}
+
+	bfs::remove( lutFilename );
+
+	if( ! benchOptions._jsonFilename.empty() )
+	{
+		writeJson( benchOptions._jsonFilename, cases, results );
+	}
+	return status;
+}
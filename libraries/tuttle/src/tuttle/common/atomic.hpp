@@ -22,6 +22,10 @@ class atomic
 {
 public:
     typedef T value_type;
+	atomic()
+	: _value()
+	{}
+
 	atomic(const T v)
 	: _value(v)
 	{}
@@ -38,6 +42,22 @@ public:
 		return _value;
 	}
 
+	value_type fetch_add( const T v, const memory_order unused = memory_order_seq_cst )
+	{
+		boost::mutex::scoped_lock locker( _mutex );
+		const T old = _value;
+		_value += v;
+		return old;
+	}
+
+	value_type fetch_sub( const T v, const memory_order unused = memory_order_seq_cst )
+	{
+		boost::mutex::scoped_lock locker( _mutex );
+		const T old = _value;
+		_value -= v;
+		return old;
+	}
+
 private:
 	T _value;
 	mutable boost::mutex _mutex;
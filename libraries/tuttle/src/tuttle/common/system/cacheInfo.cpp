@@ -0,0 +1,28 @@
+#include "system.hpp"
+#include "cacheInfo.hpp"
+
+#if defined( __LINUX__ )
+ #include <unistd.h>
+#elif defined( __APPLE__ )
+ #include <sys/types.h>
+ #include <sys/sysctl.h>
+#endif
+
+namespace {
+const std::size_t defaultL2CacheSize = 256 * 1024;
+}
+
+std::size_t getL2CacheSize()
+{
+	#if defined( __LINUX__ ) && defined( _SC_LEVEL2_CACHE_SIZE )
+	const long size = sysconf( _SC_LEVEL2_CACHE_SIZE );
+	if( size > 0 )
+		return static_cast<std::size_t>( size );
+	#elif defined( __APPLE__ )
+	std::size_t size = 0;
+	std::size_t len = sizeof( size );
+	if( sysctlbyname( "hw.l2cachesize", &size, &len, NULL, 0 ) == 0 && size > 0 )
+		return size;
+	#endif
+	return defaultL2CacheSize;
+}
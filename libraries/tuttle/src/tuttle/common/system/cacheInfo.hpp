@@ -0,0 +1,12 @@
+#ifndef TUTTLE_SYSTEM_CACHEINFO_HPP_
+#define TUTTLE_SYSTEM_CACHEINFO_HPP_
+
+#include <cstddef>
+
+/**
+ * @brief Size of the level 2 data cache of the CPU in bytes.
+ * @return a default value of 256KB if the size is unknown.
+ */
+std::size_t getL2CacheSize();
+
+#endif
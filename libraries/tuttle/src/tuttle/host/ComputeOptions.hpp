@@ -8,6 +8,8 @@
 #include <tuttle/common/utils/Formatter.hpp>
 
 #include <tuttle/common/atomic.hpp>
+#include <tuttle/host/RenderProfile.hpp>
+
 #include <boost/shared_ptr.hpp>
 
 #include <limits>
@@ -105,6 +107,10 @@ public:
 		_forceIdentityNodesProcess = other._forceIdentityNodesProcess;
 		_returnBuffers = other._returnBuffers;
 		_isInteractive = other._isInteractive;
+		_nbParallelFrames = other._nbParallelFrames;
+		_nbParallelNodes = other._nbParallelNodes;
+		_tileSize = other._tileSize;
+		_renderProfile = other._renderProfile;
 
 		// don't modify the abort status?
 		//_abort.store( false, boost::memory_order_relaxed );
@@ -122,6 +128,9 @@ private:
 		setColorEnable              ( false );
 		setIsInteractive            ( false );
 		setForceIdentityNodesProcess( false );
+		setNbParallelFrames         ( 1 );
+		setNbParallelNodes          ( 1 );
+		setTileSize                 ( 0, 0 );
 	}
 	
 public:
@@ -240,6 +249,73 @@ public:
 	}
 	bool getForceIdentityNodesProcess() const { return _forceIdentityNodesProcess; }
 	
+	/**
+	 * @brief Render up to @p nbFrames frames concurrently.
+	 * Each frame is rendered in its own thread with its own render graph.
+	 * The number of frames rendered together is also limited by the memory available in the MemoryPool.
+	 * Nodes which are not fully thread safe (or which need a sequential render, like video writers)
+	 * are processed frame after frame, in the time order.
+	 * @remark 0 or 1 means a frame by frame process.
+	 */
+	This& setNbParallelFrames( const std::size_t nbFrames )
+	{
+		_nbParallelFrames = nbFrames;
+		return *this;
+	}
+	std::size_t getNbParallelFrames() const { return _nbParallelFrames; }
+	
+	/**
+	 * @brief Process up to @p nbNodes independent nodes of a frame concurrently.
+	 * A node is processed as soon as all its inputs are processed, so the
+	 * branches of the graph (like the inputs of a merge) overlap.
+	 * The threads of the Core ThreadPool are shared between the nodes
+	 * processed together.
+	 * @remark 0 or 1 means a node by node process, in a depth first order.
+	 */
+	This& setNbParallelNodes( const std::size_t nbNodes )
+	{
+		_nbParallelNodes = nbNodes;
+		return *this;
+	}
+	std::size_t getNbParallelNodes() const { return _nbParallelNodes; }
+	
+	/**
+	 * @brief Render the output nodes tile by tile (size in canonical coordinates).
+	 * Each tile is rendered with its own pass on the graph, and each node only
+	 * computes the region needed by the tile. So the memory needed is bounded
+	 * by the tile size.
+	 * @remark The output nodes need to support tiles (writers don't), else the
+	 *         frames are rendered in one piece.
+	 *         Not used when multiple frames are rendered concurrently.
+	 * @remark 0 disables the tiled rendering.
+	 */
+	This& setTileSize( const double width, const double height )
+	{
+		_tileSize.x = width;
+		_tileSize.y = height;
+		return *this;
+	}
+	const OfxPointD& getTileSize() const { return _tileSize; }
+	bool isTiled() const { return _tileSize.x > 0 && _tileSize.y > 0; }
+	
+	/**
+	 * @brief Record the time spent by each node on each frame, see getRenderProfile.
+	 * Enabling the profiling starts a new profile. The profile is shared by the copies of these options.
+	 */
+	This& setProfiling( const bool enable = true )
+	{
+		if( enable )
+			_renderProfile.reset( new RenderProfile() );
+		else
+			_renderProfile.reset();
+		return *this;
+	}
+	bool isProfiling() const { return _renderProfile.get() != NULL; }
+	/**
+	 * @brief The profile of the renders, NULL if the profiling is disabled.
+	 */
+	boost::shared_ptr<RenderProfile> getRenderProfile() const { return _renderProfile; }
+	
 	/**
 	 * @brief The application would like to abort the process (from another thread).
 	 */
@@ -307,10 +383,14 @@ private:
 	bool _forceIdentityNodesProcess;
 	bool _returnBuffers;
 	bool _isInteractive;
+	std::size_t _nbParallelFrames;
+	std::size_t _nbParallelNodes;
+	OfxPointD _tileSize;
 	
 	boost::atomic_bool _abort;
 
 	boost::shared_ptr<IProgressHandle> _progressHandle;
+	boost::shared_ptr<RenderProfile> _renderProfile;
 };
 
 }
@@ -10,6 +10,9 @@
 %}
 
 %shared_ptr(tuttle::host::IProgressHandle)
+%shared_ptr(tuttle::host::RenderProfile)
+
+%include <tuttle/host/RenderProfile.i>
 
 namespace std {
 %template(TimeRangeList) list<tuttle::host::TimeRange>;
@@ -1,4 +1,5 @@
 #include "Core.hpp"
+#include "PluginCacheFile.hpp"
 
 #include <tuttle/host/ofx/OfxhImageEffectPlugin.hpp>
 #include <tuttle/host/memory/MemoryPool.hpp>
@@ -39,19 +40,23 @@ namespace host {
 namespace {
 memory::MemoryPool pool;
 memory::MemoryCache cache;
+memory::NodeOutputCache nodeOutputCache; ///< after the pool, it contains pool datas
 }
 
 Core::Core()
 	: _imageEffectPluginCache( _host )
 	, _memoryPool( pool )
 	, _memoryCache( cache )
+	, _nodeOutputCache( nodeOutputCache )
 	, _isPreloaded( false )
 	, _formatter( tuttle::common::Formatter::get() )
+	, _threadPool( _preferences.getNbThreads() )
 {
 #ifdef TUTTLE_HOST_WITH_PYTHON_EXPRESSION
 	Py_Initialize( );
 #endif
 	_pluginCache.setCacheVersion( "tuttleV1" );
+	_renderDiskCache.setRootDir( _preferences.getTuttleHomePath() / "renderCache" );
 
 	// register the image effect cache with the global plugin cache
 	_pluginCache.registerAPICache( _imageEffectPluginCache );
@@ -67,17 +72,10 @@ void Core::preload( const bool useCache )
 {
 	_isPreloaded = true;
 	
-	//	typedef boost::archive::binary_oarchive OArchive;
-	//	typedef boost::archive::binary_iarchive IArchive;
-	//	typedef boost::archive::text_oarchive OArchive;
-	//	typedef boost::archive::text_iarchive IArchive;
-	typedef boost::archive::xml_oarchive OArchive;
-	typedef boost::archive::xml_iarchive IArchive;
-	
 	std::string cacheFile;
 	if( useCache )
 	{
-		cacheFile = (getPreferences().getTuttleHomePath() / "tuttlePluginCacheSerialize.xml").string();
+		cacheFile = (getPreferences().getTuttleHomePath() / "tuttlePluginCache.bin").string();
 		
 		TUTTLE_LOG_DEBUG( "plugin cache file = " << cacheFile );
 
@@ -85,12 +83,11 @@ void Core::preload( const bool useCache )
 		{
 			try
 			{
-				std::ifstream ifsb( cacheFile.c_str(), std::ios::in );
+				TUTTLE_LOG_DEBUG( "Read plugins cache." );
+				if( ! readPluginCacheFile( cacheFile, _pluginCache ) )
 				{
-					TUTTLE_LOG_DEBUG( "Read plugins cache." );
-					IArchive iArchive( ifsb );
-					iArchive >> BOOST_SERIALIZATION_NVP( _pluginCache );
-					// Destructor for an archive should be called before the stream is closed. It restores any altered stream facets to thier state before the the archive was opened.
+					// The cache file comes from another version, it will be recreated.
+					_pluginCache.clearPluginFiles();
 				}
 			}
 			catch( std::exception& e )
@@ -109,20 +106,13 @@ void Core::preload( const bool useCache )
 		// generate unique name for writing
 		boost::uuids::random_generator gen;
 		boost::uuids::uuid u = gen();
-		const std::string tmpCacheFile( cacheFile + ".writing." + boost::uuids::to_string(u) + ".xml" );
+		const std::string tmpCacheFile( cacheFile + ".writing." + boost::uuids::to_string(u) );
 		
 		TUTTLE_LOG_DEBUG(  "Write plugins cache " << tmpCacheFile );
 		try
 		{
 			// Serialize into a temporary file
-			{
-				std::ofstream ofsb( tmpCacheFile.c_str(), std::ios::out );
-				{
-					OArchive oArchive( ofsb );
-					oArchive << BOOST_SERIALIZATION_NVP( _pluginCache );
-					// Destructor for an archive should be called before the stream is closed. It restores any altered stream facets to thier state before the the archive was opened.
-				}
-			}
+			writePluginCacheFile( tmpCacheFile, _pluginCache );
 			// Replace the cache file
 			boost::filesystem::rename( tmpCacheFile, cacheFile );
 		}
@@ -3,8 +3,11 @@
 
 #include "version.hpp"
 #include "Preferences.hpp"
+#include "ThreadPool.hpp"
 
 #include <tuttle/host/memory/IMemoryCache.hpp>
+#include <tuttle/host/memory/NodeOutputCache.hpp>
+#include <tuttle/host/diskCache/RenderDiskCache.hpp>
 #include <tuttle/host/HostDescriptor.hpp>
 #include <tuttle/host/ofx/OfxhPluginCache.hpp>
 #include <tuttle/host/ofx/OfxhImageEffectPluginCache.hpp>
@@ -34,10 +37,13 @@ private:
 	ofx::OfxhPluginCache _pluginCache;
 	memory::IMemoryPool& _memoryPool;
 	memory::IMemoryCache& _memoryCache;
+	memory::NodeOutputCache& _nodeOutputCache;
 	bool _isPreloaded;
 	boost::shared_ptr<tuttle::common::Formatter> _formatter;
 	
 	Preferences _preferences;
+	ThreadPool _threadPool;
+	RenderDiskCache _renderDiskCache;
 
 public:
 	      ofx::OfxhPluginCache& getPluginCache()       { return _pluginCache; }
@@ -52,13 +58,28 @@ public:
 	      Preferences& getPreferences()       { return _preferences; }
 	const Preferences& getPreferences() const { return _preferences; }
 
+	/**
+	 * @brief Threads shared by all the renders, sized by Preferences::setNbThreads().
+	 */
+	ThreadPool& getThreadPool() { return _threadPool; }
+
+	/**
+	 * @brief Node outputs kept on disk, for the nodes with a render disk cache (see INode::setRenderDiskCache).
+	 * The default directory is "renderCache" in the tuttle home.
+	 */
+	      RenderDiskCache& getRenderDiskCache()       { return _renderDiskCache; }
+	const RenderDiskCache& getRenderDiskCache() const { return _renderDiskCache; }
+
 public:
+	      ofx::imageEffect::OfxhImageEffectPluginCache& getImageEffectPluginCache()       { return _imageEffectPluginCache; }
 	const ofx::imageEffect::OfxhImageEffectPluginCache& getImageEffectPluginCache() const { return _imageEffectPluginCache; }
 
 	memory::IMemoryPool&        getMemoryPool()        { return _memoryPool; }
 	const memory::IMemoryPool&  getMemoryPool() const  { return _memoryPool; }
 	memory::IMemoryCache&       getMemoryCache()       { return _memoryCache; }
 	const memory::IMemoryCache& getMemoryCache() const { return _memoryCache; }
+	memory::NodeOutputCache&       getNodeOutputCache()       { return _nodeOutputCache; }
+	const memory::NodeOutputCache& getNodeOutputCache() const { return _nodeOutputCache; }
 
 public:
 	ofx::imageEffect::OfxhImageEffectPlugin* getImageEffectPluginById( const std::string& id, int vermaj = -1, int vermin = -1 )
@@ -3,6 +3,8 @@
 %include <tuttle/host/HostDescriptor.i>
 %include <tuttle/host/memory/MemoryCache.i>
 %include <tuttle/host/memory/MemoryPool.i>
+%include <tuttle/host/memory/NodeOutputCache.i>
+%include <tuttle/host/diskCache/RenderDiskCache.i>
 %include <tuttle/host/ofx/OfxhPlugin.i>
 %include <tuttle/host/ofx/OfxhPluginCache.i>
 %include <tuttle/host/ofx/OfxhImageEffectPluginCache.i>
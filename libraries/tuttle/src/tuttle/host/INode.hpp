@@ -65,10 +65,12 @@ public:
 	INode()
 		: _data(NULL)
 		, _beforeRenderCallback(0)
+		, _renderDiskCache(false)
 	{}
 	INode( const INode& e )
 		: _data(NULL)
 		, _beforeRenderCallback(0)
+		, _renderDiskCache(e._renderDiskCache)
 	{}
 	
 	virtual ~INode();
@@ -87,6 +89,9 @@ public:
 	
 	virtual std::string getLabel() const = 0;
 
+	/// @brief The node can render a part of its output.
+	virtual bool supportsTiles() const = 0;
+
 	virtual const ofx::property::OfxhSet& getProperties() const = 0;
 	virtual ofx::property::OfxhSet&       getEditableProperties() = 0;
 
@@ -169,6 +174,12 @@ public:
 	 * @return if the node is an identity operation
 	 */
 	virtual bool isIdentity( const graph::ProcessVertexAtTimeData& processData, std::string& clip, OfxTime& time ) const = 0;
+
+	/**
+	 * @brief The output of the node can be reused from a previous render with the same hash.
+	 * Nodes with side effects (like writers) need to be processed each time.
+	 */
+	virtual bool isOutputCacheable() const { return true; }
 	
 	/**
 	 * @brief Fill ProcessInfo to compute statistics for the current process,
@@ -209,6 +220,13 @@ public:
      */
     void setBeforeRenderCallback(Callback *cb);
 
+	/**
+	 * @brief Keep the output of this node on disk (see Core::getRenderDiskCache).
+	 * Next renders with the same hash read the file instead of processing this node and all its inputs.
+	 */
+	void setRenderDiskCache( const bool enable = true ) { _renderDiskCache = enable; }
+	bool getRenderDiskCache() const { return _renderDiskCache; }
+
 	virtual std::ostream& print( std::ostream& os ) const = 0;
 
 	friend std::ostream& operator<<( std::ostream& os, const This& v );
@@ -222,6 +240,9 @@ public:
     void beforeRenderCallback(INode &, DataAtTime &);
     Callback *_beforeRenderCallback;
 
+private:
+	bool _renderDiskCache;
+
 protected:
 	Data* _data; ///< link to external datas
 	DataAtTimeMap _dataAtTime; ///< link to external datas at each time
@@ -795,7 +795,7 @@ void ImageEffectNode::preProcess1( graph::ProcessVertexAtTimeData& vData )
 //	TUTTLE_LOG_VAR( TUTTLE_INFO, &getData(vData._time) );
 //	TUTTLE_LOG_VAR( TUTTLE_INFO, &vData );
 	vData._apiImageEffect._renderRoD = rod;
-	vData._apiImageEffect._renderRoI = rod; ///< @todo tuttle: tile supports
+	vData._apiImageEffect._renderRoI = rod; // restricted to the region used by the next nodes in preProcess2
 
 	TUTTLE_LOG_INFO( "[Pre Process 1] rod: x1:" << rod.x1 << " y1:" << rod.y1 << " x2:" << rod.x2 << " y2:" << rod.y2 );
 }
@@ -813,6 +813,12 @@ void ImageEffectNode::preProcess2_reverse( graph::ProcessVertexAtTimeData& vData
 }
 
 
+bool ImageEffectNode::isOutputCacheable() const
+{
+	// writers need to be processed to write their files
+	return getContext() != kOfxImageEffectContextWriter;
+}
+
 bool ImageEffectNode::isIdentity( const graph::ProcessVertexAtTimeData& vData, std::string& clip, OfxTime& time ) const
 {
 	time = vData._time;
@@ -845,6 +851,7 @@ void ImageEffectNode::process( graph::ProcessVertexAtTimeData& vData )
 		memory::IMemoryCache& memoryCache = vData._nodeData->getInternMemoryCache();
 		// keep the hand on all needed datas during the process function
 		std::list<memory::CACHE_ELEMENT> allNeededDatas;
+		vData._allocatedMemory = 0;
 
 		double par = this->getOutputClip().getPixelAspectRatio();
 		if( par == 0.0 )
@@ -911,23 +918,46 @@ void ImageEffectNode::process( graph::ProcessVertexAtTimeData& vData )
 						attribute::Image::eImageOrientationFromBottomToTop,
 						0 )
 					);
-				imageCache->setPoolData( core().getMemoryPool().allocate( imageCache->getMemorySize() ) );
+				if( vData._cachedOutput )
+				{
+					TUTTLE_LOG_TRACE( "[Node Process] Reuse output from the node output cache" );
+					// checked by ProcessGraph::useNodeOutputCache
+					if( vData._cachedOutput->size() != imageCache->getMemorySize() )
+					{
+						BOOST_THROW_EXCEPTION( exception::Bug()
+							<< exception::dev( "The output from the node output cache doesn't have the size of the image." ) );
+					}
+					imageCache->setPoolData( vData._cachedOutput );
+				}
+				else if( memory::CACHE_ELEMENT inPlaceImage = getInPlaceInputImage( vData, *imageCache ) )
+				{
+					TUTTLE_LOG_TRACE( "[Node Process] Render in place in " << inPlaceImage->getFullName() );
+					imageCache->setPoolData( inPlaceImage->getPoolData() );
+				}
+				else
+				{
+					imageCache->setPoolData( core().getMemoryPool().allocate( imageCache->getMemorySize() ) );
+					vData._allocatedMemory += imageCache->getMemorySize();
+				}
 				memoryCache.put( clip.getClipIdentifier(), vData._time, imageCache );
 
 				allNeededDatas.push_back( imageCache );
 			}
 		}
 
-		TUTTLE_LOG_TRACE( "[Node Process] Plugin Render Action" );
+		if( ! vData._cachedOutput )
+		{
+			TUTTLE_LOG_TRACE( "[Node Process] Plugin Render Action" );
 
-		renderAction( vData._time,
-					  vData._apiImageEffect._field,
-					  renderWindow,
-					  vData._nodeData->_renderScale );
+			renderAction( vData._time,
+						  vData._apiImageEffect._field,
+						  renderWindow,
+						  vData._nodeData->_renderScale );
 
-		TUTTLE_LOG_TRACE( "[Node Process] Plugin Render Action - End" );
+			TUTTLE_LOG_TRACE( "[Node Process] Plugin Render Action - End" );
 
-		debugOutputImage( vData._time );
+			debugOutputImage( vData._time );
+		}
 
 		// release input images
 		BOOST_FOREACH( const graph::ProcessVertexAtTimeData::ProcessEdgeAtTimeByClipName::value_type& inEdgePair, vData._inEdges )
@@ -948,7 +978,15 @@ void ImageEffectNode::process( graph::ProcessVertexAtTimeData& vData )
 			}
 			TUTTLE_LOG_TRACE( "[ImageEffectNode] releaseReference: " << imageCache->getFullName() );
 			// TODO: use RAII technique for add/releaseReference...
-			imageCache->releaseReference( ofx::imageEffect::OfxhImage::eReferenceOwnerHost );
+			if( imageCache->releaseReference( ofx::imageEffect::OfxhImage::eReferenceOwnerHost ) &&
+			    imageCache->getReferenceCount( ofx::imageEffect::OfxhImage::eReferenceOwnerPlugin ) < 1 )
+			{
+				// Last usage of this image in the graph,
+				// so the buffer goes back to the MemoryPool when we release it,
+				// except if it is kept by the NodeOutputCache or returned to the user.
+				// If the plugin still uses it, it is removed by clearUnused once released.
+				memoryCache.remove( imageCache );
+			}
 		}
 
 		// declare future usages of the output
@@ -966,6 +1004,14 @@ void ImageEffectNode::process( graph::ProcessVertexAtTimeData& vData )
 					BOOST_THROW_EXCEPTION( exception::Memory()
 						<< exception::dev() + "Clip " + quotes( clip.getFullName() ) + " not in memory cache (identifier:" + quotes( clip.getClipIdentifier() ) + ")." );
 				}
+				if( vData._outputHash != 0 && ! vData._cachedOutput )
+				{
+					// keep the output for the next renders
+					if( core().getNodeOutputCache().isEnabled() )
+						core().getNodeOutputCache().put( vData._outputHash, vData._apiImageEffect._renderRoI, imageCache->getPoolData() );
+					if( getRenderDiskCache() )
+						core().getRenderDiskCache().put( vData._outputHash, vData._apiImageEffect._renderRoI, *imageCache->getPoolData() );
+				}
 				const std::size_t realOutDegree = vData._outDegree - vData._isFinalNode;  // final nodes have a connection to the fake output node.
 				TUTTLE_LOG_INFO( "[Node Process] Declare future usages: " << clip.getClipIdentifier() << ", add reference: " << realOutDegree );
 				if( realOutDegree > 0 )
@@ -990,6 +1036,51 @@ void ImageEffectNode::process( graph::ProcessVertexAtTimeData& vData )
 
 }
 
+/**
+ * @brief Find an input image which could share its buffer with the output image.
+ * The node needs to support in place rendering, the input image needs to have the same bounds and pixel format,
+ * no other future usage and a buffer not shared with the NodeOutputCache or the user.
+ * @return an empty pointer if there is no such input image
+ */
+memory::CACHE_ELEMENT ImageEffectNode::getInPlaceInputImage( const graph::ProcessVertexAtTimeData& vData, const attribute::Image& outputImage ) const
+{
+	if( ! supportsInPlace() )
+		return memory::CACHE_ELEMENT();
+
+	memory::IMemoryCache& memoryCache = vData._nodeData->getInternMemoryCache();
+	const OfxRectI outputBounds = outputImage.getBounds();
+	BOOST_FOREACH( const graph::ProcessVertexAtTimeData::ProcessEdgeAtTimeByClipName::value_type& inEdgePair, vData._inEdges )
+	{
+		const graph::ProcessEdgeAtTime* inEdge = inEdgePair.second;
+		const attribute::ClipImage& clip = getClip( inEdge->getInAttrName() );
+		const OfxTime outTime = inEdge->getOutTime();
+
+		memory::CACHE_ELEMENT image = memoryCache.get( clip.getClipIdentifier(), outTime );
+		if( image.get() == NULL || ! image->getPoolData() )
+			continue;
+		// the image is only used by this node
+		if( image->getReferenceCount( ofx::imageEffect::OfxhImage::eReferenceOwnerHost ) != 1 ||
+		    image->getReferenceCount( ofx::imageEffect::OfxhImage::eReferenceOwnerPlugin ) != 0 )
+			continue;
+		const OfxRectI bounds = image->getBounds();
+		if( bounds.x1 != outputBounds.x1 || bounds.y1 != outputBounds.y1 ||
+		    bounds.x2 != outputBounds.x2 || bounds.y2 != outputBounds.y2 ||
+		    image->getComponentsType() != outputImage.getComponentsType() ||
+		    image->getBitDepth() != outputImage.getBitDepth() ||
+		    image->getMemorySize() != outputImage.getMemorySize() )
+			continue;
+		// the buffer is not kept after the render of the frame
+		const INode& inputNode = clip.getConnectedClip().getNode();
+		if( ! inputNode.hasData( outTime ) )
+			continue;
+		const graph::ProcessVertexAtTimeData& inputData = inputNode.getData( outTime );
+		if( inputData._isFinalNode || inputData._outputHash != 0 || inputData._cachedOutput )
+			continue;
+		return image;
+	}
+	return memory::CACHE_ELEMENT();
+}
+
 void ImageEffectNode::postProcess( graph::ProcessVertexAtTimeData& vData )
 {
 //	TUTTLE_LOG_INFO( "postProcess: " << getName() );
@@ -33,6 +33,7 @@ public:
 	std::string getLabel() const { return ofx::imageEffect::OfxhImageEffectNodeBase::getLabel(); }
 	const std::string&               getName() const                           { return ofx::imageEffect::OfxhImageEffectNodeBase::getName(); }
 	void                             setName( const std::string& name )        { return ofx::imageEffect::OfxhImageEffectNodeBase::setName(name); }
+	bool                             supportsTiles() const                     { return ofx::imageEffect::OfxhImageEffectNodeBase::supportsTiles(); }
 	std::size_t                      getNbParams() const { return ofx::attribute::OfxhParamSet::getNbParams(); }
 	const ofx::attribute::OfxhParam& getParam( const std::string& name ) const { return ofx::attribute::OfxhParamSet::getParam( name ); }
 	ofx::attribute::OfxhParam&       getParam( const std::string& name )       { return ofx::attribute::OfxhParamSet::getParam( name ); }
@@ -116,6 +117,8 @@ public:
 	void preProcess2_reverse( graph::ProcessVertexAtTimeData& vData );
 	
 	bool isIdentity( const graph::ProcessVertexAtTimeData& vData, std::string& clip, OfxTime& time ) const;
+
+	bool isOutputCacheable() const;
 	void preProcess_infos( const graph::ProcessVertexAtTimeData& vData, const OfxTime time, graph::ProcessVertexAtTimeInfo& nodeInfos ) const;
 	void process( graph::ProcessVertexAtTimeData& vData );
 	void postProcess( graph::ProcessVertexAtTimeData& vData );
@@ -260,6 +263,8 @@ public:
 	                        OfxPointD renderScale ) OFX_EXCEPTION_SPEC;
 
 private:
+	memory::CACHE_ELEMENT getInPlaceInputImage( const graph::ProcessVertexAtTimeData& vData, const attribute::Image& outputImage ) const;
+
 	void checkClipsConnected() const;
 
 	void initComponents();
@@ -0,0 +1,118 @@
+#include "PluginCacheFile.hpp"
+
+#include <tuttle/host/ofx/OfxhImageEffectPlugin.hpp>
+#include <tuttle/host/exceptions.hpp>
+#include <tuttle/common/utils/global.hpp>
+
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/serialization/nvp.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/stream.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/version.hpp>
+
+#include <fstream>
+#include <cstring>
+
+namespace tuttle {
+namespace host {
+
+namespace {
+
+static const char kPluginCacheMagic[8] = { 'T', 'U', 'T', 'T', 'L', 'E', 'P', 'C' };
+
+/// Version of the file format, to increase when the serialization of the plugins changes.
+static const boost::uint32_t kPluginCacheFormatVersion = 1;
+
+struct PluginCacheFileHeader
+{
+	char            _magic[8];
+	boost::uint32_t _formatVersion;
+	boost::uint32_t _boostVersion;    ///< the binary archives are not portable between boost versions
+	boost::uint32_t _pointerSize;     ///< nor between architectures
+	boost::uint32_t _endianness;
+	char            _cacheVersion[16]; ///< OfxhPluginCache::getCacheVersion()
+	boost::uint64_t _archiveSize;     ///< size of the archive following the header
+};
+
+PluginCacheFileHeader buildHeader( const ofx::OfxhPluginCache& pluginCache, const boost::uint64_t archiveSize )
+{
+	PluginCacheFileHeader header;
+	std::memset( &header, 0, sizeof( header ) );
+	std::memcpy( header._magic, kPluginCacheMagic, sizeof( kPluginCacheMagic ) );
+	header._formatVersion = kPluginCacheFormatVersion;
+	header._boostVersion  = BOOST_VERSION;
+	header._pointerSize   = sizeof( void* );
+	header._endianness    = 0x01020304;
+	pluginCache.getCacheVersion().copy( header._cacheVersion, sizeof( header._cacheVersion ) - 1 );
+	header._archiveSize   = archiveSize;
+	return header;
+}
+
+}
+
+bool readPluginCacheFile( const std::string& filepath, ofx::OfxhPluginCache& pluginCache )
+{
+	boost::iostreams::mapped_file_source file( filepath );
+
+	PluginCacheFileHeader header;
+	if( file.size() < sizeof( header ) )
+	{
+		TUTTLE_LOG_DEBUG( "The plugins cache file " << quotes( filepath ) << " is too small." );
+		return false;
+	}
+	std::memcpy( &header, file.data(), sizeof( header ) );
+
+	const PluginCacheFileHeader expectedHeader = buildHeader( pluginCache, header._archiveSize );
+	if( std::memcmp( &header, &expectedHeader, sizeof( header ) ) != 0 )
+	{
+		TUTTLE_LOG_DEBUG( "The plugins cache file " << quotes( filepath ) << " was written by another version." );
+		return false;
+	}
+	if( header._archiveSize > file.size() - sizeof( header ) )
+	{
+		TUTTLE_LOG_WARNING( "The plugins cache file " << quotes( filepath ) << " is truncated." );
+		return false;
+	}
+
+	boost::iostreams::stream<boost::iostreams::array_source> is( file.data() + sizeof( header ), static_cast<std::size_t>( header._archiveSize ) );
+	boost::archive::binary_iarchive iArchive( is );
+	iArchive >> BOOST_SERIALIZATION_NVP( pluginCache );
+	return true;
+}
+
+void writePluginCacheFile( const std::string& filepath, const ofx::OfxhPluginCache& pluginCache )
+{
+	std::ofstream ofsb( filepath.c_str(), std::ios::out | std::ios::binary );
+	if( ! ofsb )
+	{
+		BOOST_THROW_EXCEPTION( exception::File()
+			<< exception::user() + "Can't write the plugins cache."
+			<< exception::filename( filepath ) );
+	}
+
+	PluginCacheFileHeader header = buildHeader( pluginCache, 0 );
+	ofsb.write( reinterpret_cast<const char*>( &header ), sizeof( header ) );
+	{
+		boost::archive::binary_oarchive oArchive( ofsb );
+		oArchive << BOOST_SERIALIZATION_NVP( pluginCache );
+		// Destructor for an archive should be called before the stream is closed.
+	}
+	// the size of the archive is only known at the end
+	header._archiveSize = static_cast<boost::uint64_t>( ofsb.tellp() ) - sizeof( header );
+	ofsb.seekp( 0 );
+	ofsb.write( reinterpret_cast<const char*>( &header ), sizeof( header ) );
+	ofsb.close();
+
+	if( ! ofsb )
+	{
+		BOOST_THROW_EXCEPTION( exception::File()
+			<< exception::user() + "Can't write the plugins cache."
+			<< exception::filename( filepath ) );
+	}
+}
+
+}
+}
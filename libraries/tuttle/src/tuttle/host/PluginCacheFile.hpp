@@ -0,0 +1,34 @@
+#ifndef _TUTTLE_HOST_PLUGINCACHEFILE_HPP_
+#define _TUTTLE_HOST_PLUGINCACHEFILE_HPP_
+
+#include <tuttle/host/ofx/OfxhPluginCache.hpp>
+
+#include <string>
+
+namespace tuttle {
+namespace host {
+
+/**
+ * @brief Read the plugin cache from a binary cache file.
+ *
+ * The file starts with a versioned header, followed by a boost binary archive
+ * of the cache. The binary archives depend on the boost version and on the
+ * architecture, so a file written by another build is not read.
+ * The file is mapped in memory, and the descriptors of the plugins stay
+ * serialized until they are used (see OfxhImageEffectPlugin::getDescriptor).
+ *
+ * @return false if the header doesn't match this build, the cache is unchanged.
+ * @exception std::exception if the archive is corrupted
+ */
+bool readPluginCacheFile( const std::string& filepath, ofx::OfxhPluginCache& pluginCache );
+
+/**
+ * @brief Write the plugin cache into a binary cache file.
+ * @exception std::exception if the file can't be written
+ */
+void writePluginCacheFile( const std::string& filepath, const ofx::OfxhPluginCache& pluginCache );
+
+}
+}
+
+#endif
@@ -1,10 +1,14 @@
 #include "Preferences.hpp"
+#include "Core.hpp"
+#include "exceptions.hpp"
 
 #include <tuttle/common/system/system.hpp>
 #include <tuttle/common/utils/global.hpp>
 
 #include <boost/filesystem/path.hpp>
 #include <boost/filesystem/operations.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/lexical_cast.hpp>
 
 #ifdef __WINDOWS__
 #include <windows.h>
@@ -20,8 +24,29 @@ namespace host {
 Preferences::Preferences()
 : _home( buildTuttleHome() )
 , _temp( buildTuttleTemp() )
+, _nbThreads( buildNbThreads() )
+, _bufferAlignment( 64 )
+, _imageRowAlignment( 0 )
+, _useHugePages( false )
 {}
 
+void Preferences::setNbThreads( const std::size_t nbThreads )
+{
+	_nbThreads = nbThreads;
+	core().getThreadPool().setNbThreads( nbThreads );
+}
+
+void Preferences::setBufferAlignment( const std::size_t alignment )
+{
+	// posix_memalign needs a power of two multiple of sizeof(void*)
+	if( alignment < sizeof(void*) || ( alignment & ( alignment - 1 ) ) != 0 )
+	{
+		BOOST_THROW_EXCEPTION( exception::Value()
+			<< exception::user() + "Bad buffer alignment: " + alignment + " bytes, it should be a power of two, at least " + sizeof(void*) + "." );
+	}
+	_bufferAlignment = alignment;
+}
+
 boost::filesystem::path Preferences::buildTuttleHome() const
 {
 	boost::filesystem::path tuttleHome;
@@ -102,6 +127,23 @@ boost::filesystem::path Preferences::buildTuttleTemp() const
 	return tuttleTmp;
 }
 
+std::size_t Preferences::buildNbThreads() const
+{
+	if( const char* env_nb_threads = std::getenv("TUTTLE_NB_THREADS") )
+	{
+		try
+		{
+			return boost::lexical_cast<std::size_t>( env_nb_threads );
+		}
+		catch( const boost::bad_lexical_cast& )
+		{
+			TUTTLE_LOG_WARNING( "Bad value for TUTTLE_NB_THREADS: \"" << env_nb_threads << "\"." );
+		}
+	}
+	const std::size_t nbCPUs = boost::thread::hardware_concurrency();
+	return nbCPUs ? nbCPUs : 1;
+}
+
 boost::filesystem::path Preferences::buildTuttleTestPath() const
 {
 	const boost::filesystem::path tuttleTest = boost::filesystem::current_path() / ".tests";
@@ -4,6 +4,7 @@
 #include <boost/filesystem/path.hpp>
 
 #include <string>
+#include <cstddef>
 
 namespace tuttle {
 namespace host {
@@ -13,6 +14,10 @@ class Preferences
 private:
 	boost::filesystem::path _home;
 	boost::filesystem::path _temp;
+	std::size_t _nbThreads;
+	std::size_t _bufferAlignment;
+	std::size_t _imageRowAlignment;
+	bool _useHugePages;
 	
 public:
 	Preferences();
@@ -25,9 +30,40 @@ public:
 	
 	boost::filesystem::path buildTuttleTestPath() const;
 	
+	/**
+	 * @brief Number of threads used to render an image (default: TUTTLE_NB_THREADS environment variable or the number of CPUs).
+	 * 1 disables the multithreading.
+	 * The Core ThreadPool is resized directly, so it can't be called during a render.
+	 */
+	void setNbThreads( const std::size_t nbThreads );
+	std::size_t getNbThreads() const { return _nbThreads; }
+	
+	/**
+	 * @brief Alignment in bytes of the new image buffers, a power of two (default: 64, for SIMD instructions).
+	 * The biggest buffers are always aligned on the page size.
+	 * An exception is thrown if @p alignment is not a power of two or is smaller than a pointer.
+	 */
+	void setBufferAlignment( const std::size_t alignment );
+	std::size_t getBufferAlignment() const { return _bufferAlignment; }
+	
+	/**
+	 * @brief Align each row of the images on @p alignment bytes, by padding the end of the rows (default: 0).
+	 * 0 means no padding, the rows are contiguous in memory.
+	 */
+	void setImageRowAlignment( const std::size_t alignment ) { _imageRowAlignment = alignment; }
+	std::size_t getImageRowAlignment() const { return _imageRowAlignment; }
+	
+	/**
+	 * @brief Ask the system to use transparent huge pages for the big image buffers (default: false).
+	 * It reduces the TLB misses on big images, but may increase the memory used.
+	 */
+	void setUseHugePages( const bool use = true ) { _useHugePages = use; }
+	bool getUseHugePages() const { return _useHugePages; }
+	
 private:
 	boost::filesystem::path buildTuttleHome() const;
 	boost::filesystem::path buildTuttleTemp() const;
+	std::size_t buildNbThreads() const;
 };
 
 }
@@ -0,0 +1,264 @@
+#include "RenderProfile.hpp"
+
+#include <tuttle/host/exceptions.hpp>
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/foreach.hpp>
+#include <boost/io/ios_state.hpp>
+
+#include <fstream>
+#include <ostream>
+#include <iomanip>
+#include <ctime>
+
+namespace tuttle {
+namespace host {
+
+namespace {
+
+/// CPU time used by the calling thread, in microseconds.
+double getThreadCpuTime()
+{
+#ifdef CLOCK_THREAD_CPUTIME_ID
+	timespec t;
+	if( clock_gettime( CLOCK_THREAD_CPUTIME_ID, &t ) == 0 )
+		return t.tv_sec * 1e6 + t.tv_nsec * 1e-3;
+#endif
+	return 0;
+}
+
+std::string escapeJson( const std::string& s )
+{
+	std::string res;
+	res.reserve( s.size() );
+	BOOST_FOREACH( const char c, s )
+	{
+		switch( c )
+		{
+			case '"':  res += "\\\""; break;
+			case '\\': res += "\\\\"; break;
+			case '\n': res += "\\n"; break;
+			case '\t': res += "\\t"; break;
+			default:
+				if( static_cast<unsigned char>( c ) >= 0x20 )
+					res += c;
+		}
+	}
+	return res;
+}
+
+struct NodeSummary
+{
+	NodeSummary()
+		: _nbFrames( 0 )
+		, _duration( 0 )
+		, _cpuTime( 0 )
+		, _waitTime( 0 )
+		, _allocatedMemory( 0 )
+		, _nbCacheHits( 0 )
+	{}
+	std::size_t _nbFrames;
+	double _duration;
+	double _cpuTime;
+	double _waitTime;
+	std::size_t _allocatedMemory;
+	std::size_t _nbCacheHits;
+};
+
+template<class Stream>
+void openFile( Stream& file, const std::string& filename )
+{
+	file.open( filename.c_str() );
+	if( ! file )
+	{
+		BOOST_THROW_EXCEPTION( exception::File()
+			<< exception::user() + "Can't write the render profile."
+			<< exception::filename( filename ) );
+	}
+}
+
+}
+
+RenderProfile::RenderProfile()
+	: _startTime( boost::posix_time::microsec_clock::universal_time() )
+{}
+
+double RenderProfile::getElapsedTime() const
+{
+	boost::mutex::scoped_lock lock( _mutex );
+	return static_cast<double>( ( boost::posix_time::microsec_clock::universal_time() - _startTime ).total_microseconds() );
+}
+
+std::size_t RenderProfile::getThreadIndex()
+{
+	boost::mutex::scoped_lock lock( _mutex );
+	const boost::thread::id id = boost::this_thread::get_id();
+	std::map<boost::thread::id, std::size_t>::const_iterator it = _threadIndexes.find( id );
+	if( it != _threadIndexes.end() )
+		return it->second;
+	const std::size_t index = _threadIndexes.size();
+	_threadIndexes[id] = index;
+	return index;
+}
+
+RenderProfile::Event RenderProfile::beginEvent( const std::string& phase, const std::string& name, const OfxTime time )
+{
+	Event event;
+	event._phase = phase;
+	event._name = name;
+	event._time = time;
+	event._threadIndex = getThreadIndex();
+	event._start = getElapsedTime();
+	event._cpuTime = getThreadCpuTime();
+	return event;
+}
+
+void RenderProfile::endEvent( Event& event )
+{
+	event._duration = getElapsedTime() - event._start;
+	event._cpuTime = getThreadCpuTime() - event._cpuTime;
+	addEvent( event );
+}
+
+void RenderProfile::addEvent( const Event& event )
+{
+	boost::mutex::scoped_lock lock( _mutex );
+	_events.push_back( event );
+}
+
+std::vector<RenderProfile::Event> RenderProfile::getEvents() const
+{
+	boost::mutex::scoped_lock lock( _mutex );
+	return _events;
+}
+
+std::size_t RenderProfile::getNbEvents() const
+{
+	boost::mutex::scoped_lock lock( _mutex );
+	return _events.size();
+}
+
+void RenderProfile::clear()
+{
+	boost::mutex::scoped_lock lock( _mutex );
+	_events.clear();
+	_threadIndexes.clear();
+	_startTime = boost::posix_time::microsec_clock::universal_time();
+}
+
+void RenderProfile::exportJson( std::ostream& os ) const
+{
+	const std::vector<Event> events = getEvents();
+	// the times are in microseconds, keep them all, even for long renders
+	boost::io::ios_all_saver streamState( os );
+	os << std::fixed << std::setprecision( 3 );
+
+	std::map<std::string, NodeSummary> nodes;
+	double begin = 0;
+	double end = 0;
+	double processTime = 0;
+	os << "{\n\"events\": [";
+	for( std::size_t i = 0; i < events.size(); ++i )
+	{
+		const Event& e = events[i];
+		os << ( i ? ",\n" : "\n" )
+		   << "{\"name\": \"" << escapeJson( e._name ) << "\""
+		   << ", \"phase\": \"" << e._phase << "\""
+		   << ", \"time\": " << e._time
+		   << ", \"start\": " << e._start
+		   << ", \"duration\": " << e._duration
+		   << ", \"cpuTime\": " << e._cpuTime
+		   << ", \"allocatedMemory\": " << e._allocatedMemory
+		   << ", \"cacheHit\": " << ( e._cacheHit ? "true" : "false" )
+		   << ", \"thread\": " << e._threadIndex
+		   << ", \"nbThreads\": " << e._nbThreads
+		   << "}";
+
+		if( i == 0 || e._start < begin )
+			begin = e._start;
+		if( e._start + e._duration > end )
+			end = e._start + e._duration;
+		if( e._name.empty() )
+			continue;
+		NodeSummary& node = nodes[e._name];
+		if( e._phase == "wait" )
+		{
+			node._waitTime += e._duration;
+			continue;
+		}
+		++node._nbFrames;
+		node._duration += e._duration;
+		node._cpuTime += e._cpuTime;
+		node._allocatedMemory += e._allocatedMemory;
+		node._nbCacheHits += e._cacheHit;
+		processTime += e._duration;
+	}
+	os << "\n],\n\"nodes\": {";
+	bool first = true;
+	for( std::map<std::string, NodeSummary>::const_iterator it = nodes.begin(), itEnd = nodes.end(); it != itEnd; ++it, first = false )
+	{
+		const NodeSummary& node = it->second;
+		os << ( first ? "\n" : ",\n" )
+		   << "\"" << escapeJson( it->first ) << "\": {"
+		   << "\"nbFrames\": " << node._nbFrames
+		   << ", \"duration\": " << node._duration
+		   << ", \"cpuTime\": " << node._cpuTime
+		   << ", \"waitTime\": " << node._waitTime
+		   << ", \"allocatedMemory\": " << node._allocatedMemory
+		   << ", \"cacheHits\": " << node._nbCacheHits
+		   << "}";
+	}
+	const double wallTime = end - begin;
+	// average number of nodes processed at the same time
+	const double parallelism = wallTime > 0 ? processTime / wallTime : 0;
+	os << "\n},\n\"summary\": {"
+	   << "\"wallTime\": " << wallTime
+	   << ", \"processTime\": " << processTime
+	   << ", \"parallelism\": " << parallelism
+	   << "}\n}\n";
+}
+
+void RenderProfile::exportJson( const std::string& filename ) const
+{
+	std::ofstream file;
+	openFile( file, filename );
+	exportJson( file );
+}
+
+void RenderProfile::exportChromeTrace( std::ostream& os ) const
+{
+	const std::vector<Event> events = getEvents();
+	boost::io::ios_all_saver streamState( os );
+	os << std::fixed << std::setprecision( 3 );
+	os << "{\"traceEvents\": [";
+	for( std::size_t i = 0; i < events.size(); ++i )
+	{
+		const Event& e = events[i];
+		os << ( i ? ",\n" : "\n" )
+		   << "{\"name\": \"" << escapeJson( e._name.empty() ? e._phase : e._name ) << "\""
+		   << ", \"cat\": \"" << e._phase << "\""
+		   << ", \"ph\": \"X\""
+		   << ", \"ts\": " << e._start
+		   << ", \"dur\": " << e._duration
+		   << ", \"pid\": 0"
+		   << ", \"tid\": " << e._threadIndex
+		   << ", \"args\": {"
+		   << "\"time\": " << e._time
+		   << ", \"cpuTime\": " << e._cpuTime
+		   << ", \"allocatedMemory\": " << e._allocatedMemory
+		   << ", \"cacheHit\": " << ( e._cacheHit ? "true" : "false" )
+		   << ", \"nbThreads\": " << e._nbThreads
+		   << "}}";
+	}
+	os << "\n],\n\"displayTimeUnit\": \"ms\"}\n";
+}
+
+void RenderProfile::exportChromeTrace( const std::string& filename ) const
+{
+	std::ofstream file;
+	openFile( file, filename );
+	exportChromeTrace( file );
+}
+
+}
+}
@@ -0,0 +1,104 @@
+#ifndef _TUTTLE_HOST_RENDERPROFILE_HPP_
+#define _TUTTLE_HOST_RENDERPROFILE_HPP_
+
+#include <ofxCore.h>
+
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
+#include <string>
+#include <vector>
+#include <map>
+#include <iosfwd>
+#include <cstddef>
+
+namespace tuttle {
+namespace host {
+
+/**
+ * @brief Record where the time is spent during a render (see ComputeOptions::setProfiling).
+ *
+ * Events are recorded for each frame (phases "frame", "setup",
+ * "regionsOfInterest") and for each node at each frame (phases "process",
+ * and "wait" when the node waits for the other frames).
+ * They can be exported in JSON, or in the Chrome trace format to be
+ * displayed by chrome://tracing.
+ *
+ * @remark Thread safe.
+ */
+class RenderProfile
+{
+public:
+	typedef RenderProfile This;
+
+	struct Event
+	{
+		Event()
+			: _time( 0 )
+			, _start( 0 )
+			, _duration( 0 )
+			, _cpuTime( 0 )
+			, _allocatedMemory( 0 )
+			, _cacheHit( false )
+			, _threadIndex( 0 )
+			, _nbThreads( 0 )
+		{}
+
+		std::string _name; ///< node name, empty for the events of the whole frame
+		std::string _phase;
+		OfxTime _time;
+		double _start; ///< in microseconds from the beginning of the profile
+		double _duration; ///< wall time in microseconds
+		double _cpuTime; ///< CPU time of the thread in microseconds, without the worker threads
+		std::size_t _allocatedMemory; ///< memory allocated in the MemoryPool
+		bool _cacheHit; ///< the node output comes from a cache
+		std::size_t _threadIndex; ///< index of the thread in this profile
+		std::size_t _nbThreads; ///< number of threads allowed to the node
+	};
+
+public:
+	RenderProfile();
+
+	/**
+	 * @brief Start an event now, in the calling thread.
+	 */
+	Event beginEvent( const std::string& phase, const std::string& name, const OfxTime time );
+	/**
+	 * @brief Finish an event started by beginEvent in the same thread, and record it.
+	 */
+	void endEvent( Event& event );
+
+	void addEvent( const Event& event );
+
+	std::vector<Event> getEvents() const;
+	std::size_t getNbEvents() const;
+	void clear();
+
+	/**
+	 * @brief Events and a summary by node in JSON.
+	 */
+	void exportJson( std::ostream& os ) const;
+	void exportJson( const std::string& filename ) const;
+
+	/**
+	 * @brief Events in the Chrome trace event format.
+	 */
+	void exportChromeTrace( std::ostream& os ) const;
+	void exportChromeTrace( const std::string& filename ) const;
+
+private:
+	double getElapsedTime() const;
+	std::size_t getThreadIndex();
+
+private:
+	mutable boost::mutex _mutex;
+	boost::posix_time::ptime _startTime;
+	std::vector<Event> _events;
+	std::map<boost::thread::id, std::size_t> _threadIndexes;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,17 @@
+%include <tuttle/host/global.i>
+
+%include <std_string.i>
+%include <std_vector.i>
+
+%{
+#include <tuttle/host/RenderProfile.hpp>
+%}
+
+%ignore tuttle::host::RenderProfile::exportJson( std::ostream& ) const;
+%ignore tuttle::host::RenderProfile::exportChromeTrace( std::ostream& ) const;
+
+%include <tuttle/host/RenderProfile.hpp>
+
+namespace std {
+%template(RenderProfileEventVector) vector<tuttle::host::RenderProfile::Event>;
+}
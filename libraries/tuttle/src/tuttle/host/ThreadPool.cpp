@@ -0,0 +1,324 @@
+#include "ThreadPool.hpp"
+
+#include <tuttle/host/exceptions.hpp>
+#include <tuttle/common/utils/global.hpp>
+
+#include <boost/thread/tss.hpp>
+#include <boost/exception_ptr.hpp>
+#include <boost/bind.hpp>
+
+#include <algorithm>
+
+namespace tuttle {
+namespace host {
+
+namespace {
+
+struct WorkerContext
+{
+	WorkerContext( const ThreadPool& pool, const std::size_t index )
+		: _pool( &pool )
+		, _index( index )
+	{}
+	const ThreadPool* _pool;
+	std::size_t _index;
+};
+
+/// Identify the worker threads of the pools. No cleanup function, the context is owned by the worker loop.
+void noCleanup( WorkerContext* ) {}
+boost::thread_specific_ptr<WorkerContext> currentWorker( noCleanup );
+
+/// Number of threads allowed to the current thread, not set means no limit.
+boost::thread_specific_ptr<std::size_t> threadBudget;
+
+/// Take a task of @p group (any task if NULL), from the back or from the front of @p tasks.
+template<class Task, class TaskGroup>
+bool takeTask( std::deque<Task>& tasks, const bool fromBack, const TaskGroup* group, Task& task )
+{
+	if( tasks.empty() )
+		return false;
+	if( group == NULL )
+	{
+		if( fromBack )
+		{
+			task = tasks.back();
+			tasks.pop_back();
+		}
+		else
+		{
+			task = tasks.front();
+			tasks.pop_front();
+		}
+		return true;
+	}
+	if( fromBack )
+	{
+		for( typename std::deque<Task>::iterator it = tasks.end(); it != tasks.begin(); )
+		{
+			--it;
+			if( it->_group == group )
+			{
+				task = *it;
+				tasks.erase( it );
+				return true;
+			}
+		}
+		return false;
+	}
+	for( typename std::deque<Task>::iterator it = tasks.begin(), itEnd = tasks.end(); it != itEnd; ++it )
+	{
+		if( it->_group == group )
+		{
+			task = *it;
+			tasks.erase( it );
+			return true;
+		}
+	}
+	return false;
+}
+
+}
+
+struct ThreadPool::TaskGroup
+{
+	TaskGroup( const TaskFunction& func, const std::size_t nbTasks )
+		: _func( func )
+		, _nbRemainingTasks( nbTasks )
+	{}
+
+	const TaskFunction& _func;
+	boost::mutex _mutex;
+	boost::condition_variable _finished;
+	std::size_t _nbRemainingTasks;
+	boost::exception_ptr _error;
+};
+
+ThreadPool::ThreadPool( const std::size_t nbThreads )
+	: _nbPendingTasks( 0 )
+	, _nextWorker( 0 )
+	, _stop( false )
+{
+	if( nbThreads > 1 )
+		start( nbThreads - 1 );
+}
+
+ThreadPool::~ThreadPool()
+{
+	stop();
+}
+
+void ThreadPool::setNbThreads( const std::size_t nbThreads )
+{
+	if( getCurrentWorkerIndex() < _workers.size() )
+	{
+		// the worker would wait for its own end
+		BOOST_THROW_EXCEPTION( exception::Bug()
+			<< exception::dev( "The thread pool can't be resized from one of its tasks." ) );
+	}
+	boost::mutex::scoped_lock locker( _mutexSetup );
+	const std::size_t nbWorkers = nbThreads > 1 ? nbThreads - 1 : 0;
+	if( nbWorkers == _workers.size() )
+		return;
+	TUTTLE_LOG_DEBUG( "[Thread pool] use " << nbWorkers << " worker threads." );
+	stop();
+	start( nbWorkers );
+}
+
+void ThreadPool::setThreadBudget( const std::size_t nbThreads )
+{
+	if( nbThreads == 0 )
+		threadBudget.reset();
+	else
+		threadBudget.reset( new std::size_t( nbThreads ) );
+}
+
+std::size_t ThreadPool::getThreadBudget() const
+{
+	const std::size_t nbThreads = getNbThreads();
+	if( threadBudget.get() == NULL )
+		return nbThreads;
+	return std::min( nbThreads, *threadBudget );
+}
+
+void ThreadPool::start( const std::size_t nbWorkers )
+{
+	_stop = false;
+	_nextWorker = 0;
+	for( std::size_t i = 0; i < nbWorkers; ++i )
+	{
+		_workers.push_back( new Worker() );
+	}
+	for( std::size_t i = 0; i < nbWorkers; ++i )
+	{
+		_threads.push_back( new boost::thread( boost::bind( &ThreadPool::workerLoop, this, i ) ) );
+	}
+}
+
+void ThreadPool::stop()
+{
+	{
+		boost::mutex::scoped_lock locker( _mutexSleep );
+		_stop = true;
+	}
+	_wakeUp.notify_all();
+	for( std::size_t i = 0; i < _threads.size(); ++i )
+	{
+		_threads[i].join();
+	}
+	_threads.clear();
+	_workers.clear();
+}
+
+void ThreadPool::execute( const TaskFunction& func, const std::size_t nbTasks )
+{
+	if( nbTasks == 0 )
+		return;
+
+	const std::size_t nbWorkers = _workers.size();
+	if( nbWorkers == 0 || nbTasks == 1 )
+	{
+		for( std::size_t i = 0; i < nbTasks; ++i )
+		{
+			func( i );
+		}
+		return;
+	}
+
+	TaskGroup group( func, nbTasks );
+	const std::size_t workerIndex = getCurrentWorkerIndex();
+	{
+		boost::mutex::scoped_lock locker( _mutexSleep );
+		_nbPendingTasks += nbTasks;
+	}
+	if( workerIndex < nbWorkers )
+	{
+		// nested call: the tasks stay local, idle workers will steal them
+		Worker& worker = _workers[workerIndex];
+		boost::mutex::scoped_lock locker( worker._mutex );
+		for( std::size_t i = 0; i < nbTasks; ++i )
+		{
+			worker._tasks.push_back( Task( group, i ) );
+		}
+	}
+	else
+	{
+		std::size_t w;
+		{
+			boost::mutex::scoped_lock locker( _mutexSleep );
+			w = _nextWorker;
+			_nextWorker = ( _nextWorker + nbTasks ) % nbWorkers;
+		}
+		for( std::size_t i = 0; i < nbTasks; ++i, w = ( w + 1 ) % nbWorkers )
+		{
+			Worker& worker = _workers[w];
+			boost::mutex::scoped_lock locker( worker._mutex );
+			worker._tasks.push_back( Task( group, i ) );
+		}
+	}
+	_wakeUp.notify_all();
+
+	// help the workers until all the tasks of the group are done
+	for(;;)
+	{
+		{
+			boost::mutex::scoped_lock locker( group._mutex );
+			if( group._nbRemainingTasks == 0 )
+				break;
+		}
+		Task task;
+		if( popTask( task, workerIndex, &group ) )
+		{
+			runTask( task );
+			continue;
+		}
+		// no task of the group left in the queues, the remaining tasks are running
+		boost::mutex::scoped_lock locker( group._mutex );
+		while( group._nbRemainingTasks != 0 )
+		{
+			group._finished.wait( locker );
+		}
+		break;
+	}
+
+	if( group._error )
+		boost::rethrow_exception( group._error );
+}
+
+void ThreadPool::workerLoop( const std::size_t workerIndex )
+{
+	WorkerContext context( *this, workerIndex );
+	currentWorker.reset( &context );
+
+	for(;;)
+	{
+		Task task;
+		if( popTask( task, workerIndex ) )
+		{
+			runTask( task );
+			continue;
+		}
+		boost::mutex::scoped_lock locker( _mutexSleep );
+		while( ! _stop && _nbPendingTasks == 0 )
+		{
+			_wakeUp.wait( locker );
+		}
+		if( _stop && _nbPendingTasks == 0 )
+			break;
+	}
+	currentWorker.reset();
+}
+
+bool ThreadPool::popTask( Task& task, const std::size_t workerIndex, const TaskGroup* group )
+{
+	const std::size_t nbWorkers = _workers.size();
+	bool found = false;
+	if( workerIndex < nbWorkers )
+	{
+		// last in first out on our own queue, the data is still in the cache
+		Worker& worker = _workers[workerIndex];
+		boost::mutex::scoped_lock locker( worker._mutex );
+		found = takeTask( worker._tasks, true, group, task );
+	}
+	for( std::size_t i = 1; ! found && i <= nbWorkers; ++i )
+	{
+		// steal the oldest task of another worker
+		Worker& worker = _workers[( workerIndex + i ) % nbWorkers];
+		boost::mutex::scoped_lock locker( worker._mutex );
+		found = takeTask( worker._tasks, false, group, task );
+	}
+	if( found )
+	{
+		boost::mutex::scoped_lock locker( _mutexSleep );
+		--_nbPendingTasks;
+	}
+	return found;
+}
+
+void ThreadPool::runTask( const Task& task )
+{
+	TaskGroup& group = *task._group;
+	try
+	{
+		group._func( task._index );
+	}
+	catch( ... )
+	{
+		boost::mutex::scoped_lock locker( group._mutex );
+		if( ! group._error )
+			group._error = boost::current_exception();
+	}
+	boost::mutex::scoped_lock locker( group._mutex );
+	if( --group._nbRemainingTasks == 0 )
+		group._finished.notify_all();
+}
+
+std::size_t ThreadPool::getCurrentWorkerIndex() const
+{
+	const WorkerContext* context = currentWorker.get();
+	if( context && context->_pool == this )
+		return context->_index;
+	return _workers.size();
+}
+
+}
+}
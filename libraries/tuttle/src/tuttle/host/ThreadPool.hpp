@@ -0,0 +1,115 @@
+#ifndef _TUTTLE_HOST_THREADPOOL_HPP_
+#define _TUTTLE_HOST_THREADPOOL_HPP_
+
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/function.hpp>
+#include <boost/ptr_container/ptr_vector.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <deque>
+#include <cstddef>
+
+namespace tuttle {
+namespace host {
+
+/**
+ * @brief Persistent pool of worker threads with one task queue per worker.
+ *
+ * Workers take their tasks from the back of their own queue and steal tasks
+ * from the front of the other queues when they are idle.
+ * The thread which launches tasks executes some of them while waiting for the
+ * end of the others, so nested calls (a task launching new tasks) never
+ * create more threads than the pool size.
+ * While waiting, it only executes the tasks of its own call, so a task which
+ * waits for another one (like the frames rendered in the time order) can't
+ * be executed under the task it waits for.
+ */
+class ThreadPool : private boost::noncopyable
+{
+public:
+	typedef ThreadPool This;
+	/// Function called with the index of the task.
+	typedef boost::function<void ( const std::size_t )> TaskFunction;
+
+private:
+	struct TaskGroup;
+
+	struct Task
+	{
+		Task() : _group( NULL ), _index( 0 ) {}
+		Task( TaskGroup& group, const std::size_t index ) : _group( &group ), _index( index ) {}
+		TaskGroup* _group;
+		std::size_t _index;
+	};
+
+	struct Worker
+	{
+		boost::mutex _mutex;
+		std::deque<Task> _tasks;
+	};
+
+public:
+	/**
+	 * @param nbThreads Number of threads used to execute tasks, including the
+	 *        thread which launches the tasks. So @p nbThreads - 1 workers are
+	 *        created. 0 or 1 means that all tasks are executed sequentially.
+	 */
+	explicit ThreadPool( const std::size_t nbThreads = 0 );
+	~ThreadPool();
+
+	/**
+	 * @brief Change the number of threads.
+	 * @warning Not allowed while tasks are executed, an exception is thrown if it's called from a task.
+	 */
+	void setNbThreads( const std::size_t nbThreads );
+	std::size_t getNbThreads() const { return _workers.size() + 1; }
+
+	/**
+	 * @brief Limit the number of threads the current thread should use for its tasks.
+	 * Used when multiple nodes are processed concurrently, to share the pool between them.
+	 * @param nbThreads 0 removes the limit.
+	 */
+	static void setThreadBudget( const std::size_t nbThreads );
+	/**
+	 * @return the number of threads the current thread should use for its tasks (see setThreadBudget).
+	 */
+	std::size_t getThreadBudget() const;
+
+	/**
+	 * @brief Execute @p func for each index in [0, @p nbTasks) and wait the end of all tasks.
+	 * If tasks throw exceptions, the first one is rethrown in the calling thread.
+	 */
+	void execute( const TaskFunction& func, const std::size_t nbTasks );
+
+private:
+	void start( const std::size_t nbWorkers );
+	void stop();
+
+	void workerLoop( const std::size_t workerIndex );
+	/**
+	 * @param workerIndex Index of the calling worker or the number of workers if the caller is not a worker.
+	 * @param group Only take the tasks of this group, or any task if NULL.
+	 */
+	bool popTask( Task& task, const std::size_t workerIndex, const TaskGroup* group = NULL );
+	void runTask( const Task& task );
+	/// @return index of the current worker in this pool, or the number of workers.
+	std::size_t getCurrentWorkerIndex() const;
+
+private:
+	boost::ptr_vector<Worker> _workers;
+	boost::ptr_vector<boost::thread> _threads;
+
+	boost::mutex _mutexSetup; ///< protect the pool resize
+	boost::mutex _mutexSleep; ///< protect _nbPendingTasks and _stop
+	boost::condition_variable _wakeUp;
+	std::size_t _nbPendingTasks; ///< number of tasks waiting in the queues
+	std::size_t _nextWorker; ///< where to push the tasks of the next external call
+	bool _stop;
+};
+
+}
+}
+
+#endif
@@ -37,8 +37,11 @@ Image::Image( ClipImage& clip, const OfxTime time, const OfxRectD& bounds, const
 	const OfxPointI dimensions = { _bounds.x2 - _bounds.x1, _bounds.y2 - _bounds.y1 };
 
 	// make some memory according to the bit depth
-	const std::size_t automaticRowSize = dimensions.x * _pixelBytes;
-	_memorySize = automaticRowSize * dimensions.y;
+	// the rows may be padded to be aligned (see Preferences::setImageRowAlignment)
+	std::size_t automaticRowSize = dimensions.x * _pixelBytes;
+	const std::size_t rowAlignment = core().getPreferences().getImageRowAlignment();
+	if( rowAlignment > 1 )
+		automaticRowSize = ( automaticRowSize + rowAlignment - 1 ) / rowAlignment * rowAlignment;
 
 	// render scale x and y of 1.0
 	setDoubleProperty( kOfxImageEffectPropRenderScale, 1.0, 0 );
@@ -58,6 +61,7 @@ Image::Image( ClipImage& clip, const OfxTime time, const OfxRectD& bounds, const
 
 	// row bytes
 	_rowAbsDistanceBytes = rowDistanceBytes != 0 ? rowDistanceBytes : automaticRowSize;
+	_memorySize = _rowAbsDistanceBytes * dimensions.y;
 	setIntProperty( kOfxImagePropRowBytes, getOrientedRowDistanceBytes( eImageOrientationFromBottomToTop ) );
 }
 
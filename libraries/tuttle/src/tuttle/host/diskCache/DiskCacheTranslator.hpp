@@ -32,6 +32,7 @@ public:
      * @brief Set the base directory for all cached files.
      */
     void setRootDir( const boost::filesystem::path& rootDir ) { _rootDir = rootDir; }
+    const boost::filesystem::path& getRootDir() const { return _rootDir; }
     
     /**
      * @brief Convert a @p key into a filepath.
@@ -0,0 +1,181 @@
+#include "RenderDiskCache.hpp"
+
+#include <tuttle/host/Core.hpp>
+#include <tuttle/host/exceptions.hpp>
+#include <tuttle/common/utils/global.hpp>
+
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+#include <boost/iostreams/filter/zlib.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/functional/hash.hpp>
+#include <boost/cstdint.hpp>
+
+#include <fstream>
+#include <vector>
+#include <cstring>
+
+namespace tuttle {
+namespace host {
+
+namespace {
+
+const char s_magic[8] = { 'T', 'U', 'T', 'T', 'L', 'E', 'R', 'C' };
+const boost::uint32_t s_version = 1;
+/// The image buffer starts after the header, aligned on the page size.
+const std::size_t s_headerSize = 4096;
+
+struct FileHeader
+{
+	char _magic[8];
+	boost::uint32_t _version;
+	boost::uint32_t _compressed;
+	double _bounds[4];
+	boost::uint64_t _dataSize; ///< size of the image buffer
+	boost::uint64_t _storedSize; ///< size of the image buffer in the file
+};
+
+}
+
+const std::string RenderDiskCache::s_renderCacheExtension( ".tuttlecache" );
+
+boost::filesystem::path RenderDiskCache::getFilePath( const KeyType key, const OfxRectD& bounds ) const
+{
+	KeyType fileKey = key;
+	boost::hash_combine( fileKey, bounds.x1 );
+	boost::hash_combine( fileKey, bounds.y1 );
+	boost::hash_combine( fileKey, bounds.x2 );
+	boost::hash_combine( fileKey, bounds.y2 );
+	return _diskCacheTranslator.keyToAbsolutePath( fileKey ).replace_extension( s_renderCacheExtension );
+}
+
+bool RenderDiskCache::contains( const KeyType key, const OfxRectD& bounds ) const
+{
+	if( getRootDir().empty() )
+		return false;
+	return _diskCacheTranslator.contains( getFilePath( key, bounds ) );
+}
+
+memory::IPoolDataPtr RenderDiskCache::get( const KeyType key, const OfxRectD& bounds, const std::size_t dataSize ) const
+{
+	if( ! contains( key, bounds ) )
+		return memory::IPoolDataPtr();
+
+	const boost::filesystem::path filePath = getFilePath( key, bounds );
+	try
+	{
+		boost::iostreams::mapped_file_source file( filePath.string() );
+		FileHeader header;
+		if( file.size() < s_headerSize )
+		{
+			TUTTLE_LOG_WARNING( "[Render Disk Cache] Bad file size: " << quotes( filePath.string() ) );
+			return memory::IPoolDataPtr();
+		}
+		std::memcpy( &header, file.data(), sizeof( FileHeader ) );
+		if( std::memcmp( header._magic, s_magic, sizeof( s_magic ) ) != 0 ||
+		    header._version != s_version ||
+		    header._bounds[0] != bounds.x1 || header._bounds[1] != bounds.y1 ||
+		    header._bounds[2] != bounds.x2 || header._bounds[3] != bounds.y2 ||
+		    header._dataSize != dataSize ||
+		    file.size() < s_headerSize + header._storedSize )
+		{
+			TUTTLE_LOG_WARNING( "[Render Disk Cache] Bad file header: " << quotes( filePath.string() ) );
+			return memory::IPoolDataPtr();
+		}
+
+		const char* storedData = file.data() + s_headerSize;
+		memory::IPoolDataPtr data = core().getMemoryPool().allocate( dataSize );
+		if( header._compressed )
+		{
+			boost::iostreams::filtering_istream in;
+			in.push( boost::iostreams::zlib_decompressor() );
+			in.push( boost::iostreams::array_source( storedData, static_cast<std::size_t>( header._storedSize ) ) );
+			in.read( data->data(), dataSize );
+			if( static_cast<std::size_t>( in.gcount() ) != dataSize )
+			{
+				TUTTLE_LOG_WARNING( "[Render Disk Cache] Bad compressed data: " << quotes( filePath.string() ) );
+				return memory::IPoolDataPtr();
+			}
+		}
+		else
+		{
+			std::memcpy( data->data(), storedData, dataSize );
+		}
+		TUTTLE_LOG_TRACE( "[Render Disk Cache] Read " << quotes( filePath.string() ) );
+		return data;
+	}
+	catch( std::exception& e )
+	{
+		TUTTLE_LOG_WARNING( "[Render Disk Cache] Can't read " << quotes( filePath.string() ) << ": " << e.what() );
+	}
+	return memory::IPoolDataPtr();
+}
+
+void RenderDiskCache::put( const KeyType key, const OfxRectD& bounds, const memory::IPoolData& data )
+{
+	if( getRootDir().empty() )
+		return;
+
+	const boost::filesystem::path filePath = getFilePath( key, bounds );
+	// write in a temporary file, so other renders never read an incomplete file
+	const boost::filesystem::path tmpPath = boost::filesystem::unique_path( filePath.string() + ".%%%%-%%%%-%%%%" );
+	try
+	{
+		boost::filesystem::create_directories( filePath.parent_path() );
+
+		FileHeader header;
+		std::memset( &header, 0, sizeof( FileHeader ) );
+		std::memcpy( header._magic, s_magic, sizeof( s_magic ) );
+		header._version = s_version;
+		header._compressed = _compression;
+		header._bounds[0] = bounds.x1;
+		header._bounds[1] = bounds.y1;
+		header._bounds[2] = bounds.x2;
+		header._bounds[3] = bounds.y2;
+		header._dataSize = data.size();
+
+		std::ofstream out( tmpPath.string().c_str(), std::ios::out | std::ios::binary );
+		const std::vector<char> headerSpace( s_headerSize, 0 );
+		out.write( &headerSpace[0], s_headerSize );
+		if( _compression )
+		{
+			boost::iostreams::filtering_ostream compressedOut;
+			compressedOut.push( boost::iostreams::zlib_compressor( boost::iostreams::zlib::best_speed ) );
+			compressedOut.push( out );
+			compressedOut.write( data.data(), data.size() );
+			compressedOut.reset(); // flush
+		}
+		else
+		{
+			out.write( data.data(), data.size() );
+		}
+		header._storedSize = static_cast<boost::uint64_t>( out.tellp() ) - s_headerSize;
+		out.seekp( 0 );
+		out.write( reinterpret_cast<const char*>( &header ), sizeof( FileHeader ) );
+		out.close();
+		if( ! out )
+		{
+			BOOST_THROW_EXCEPTION( std::runtime_error( "write error" ) );
+		}
+		boost::filesystem::rename( tmpPath, filePath );
+		TUTTLE_LOG_TRACE( "[Render Disk Cache] Write " << quotes( filePath.string() ) );
+	}
+	catch( std::exception& e )
+	{
+		TUTTLE_LOG_WARNING( "[Render Disk Cache] Can't write " << quotes( filePath.string() ) << ": " << e.what() );
+		boost::system::error_code error;
+		boost::filesystem::remove( tmpPath, error );
+	}
+}
+
+void RenderDiskCache::clear()
+{
+	if( getRootDir().empty() )
+		return;
+	boost::system::error_code error;
+	boost::filesystem::remove_all( getRootDir(), error );
+}
+
+}
+}
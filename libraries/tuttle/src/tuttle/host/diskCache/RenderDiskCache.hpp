@@ -0,0 +1,89 @@
+#ifndef _TUTTLEOFX_HOST_RENDERDISKCACHE_HPP_
+#define _TUTTLEOFX_HOST_RENDERDISKCACHE_HPP_
+
+#include <tuttle/host/diskCache/DiskCacheTranslator.hpp>
+#include <tuttle/host/memory/IMemoryPool.hpp>
+
+#include <ofxCore.h>
+
+#include <boost/filesystem/path.hpp>
+
+#include <string>
+#include <cstddef>
+
+namespace tuttle {
+namespace host {
+
+/**
+ * @brief An helper to keep node outputs on your HDD between renders.
+ *
+ * Each buffer is stored in a file named from the global hash of the node at
+ * time (see NodeOutputCache). The file contains a header followed by the raw
+ * image buffer, aligned on the page size, so it could be memory-mapped.
+ * The buffer could be compressed with zlib.
+ *
+ * @warning The hash of a node doesn't contain external datas (like the
+ *          content of the files read by a reader), so the cache needs to be
+ *          cleared if these datas change.
+ */
+class RenderDiskCache
+{
+public:
+	typedef DiskCacheTranslator::KeyType KeyType;
+	static const std::string s_renderCacheExtension;
+
+public:
+	RenderDiskCache()
+		: _compression( false )
+	{}
+
+	/**
+	 * @brief Set the base directory for all cached files.
+	 */
+	void setRootDir( const boost::filesystem::path& rootDir ) { _diskCacheTranslator.setRootDir( rootDir ); }
+	void setRootDir( const std::string& rootDir ) { setRootDir( boost::filesystem::path(rootDir) ); }
+	const boost::filesystem::path& getRootDir() const { return _diskCacheTranslator.getRootDir(); }
+
+	/**
+	 * @brief Compress the new cached files (default: false).
+	 */
+	void setCompression( const bool compression = true ) { _compression = compression; }
+	bool getCompression() const { return _compression; }
+
+	/**
+	 * @brief Check if the buffer of a node output is in the cache.
+	 * @param[in] key global hash of the node output
+	 * @param[in] bounds region of the image contained in the buffer
+	 */
+	bool contains( const KeyType key, const OfxRectD& bounds ) const;
+
+	/**
+	 * @brief Read the buffer of a node output into a new buffer of the MemoryPool.
+	 * @param[in] dataSize expected size of the buffer
+	 * @return an empty pointer if there is no such buffer in the cache
+	 */
+	memory::IPoolDataPtr get( const KeyType key, const OfxRectD& bounds, const std::size_t dataSize ) const;
+
+	/**
+	 * @brief Write the buffer of a node output in the cache.
+	 * Errors are only reported as warnings, the cache is an optimization.
+	 */
+	void put( const KeyType key, const OfxRectD& bounds, const memory::IPoolData& data );
+
+	/**
+	 * @brief Remove all cached files.
+	 */
+	void clear();
+
+private:
+	boost::filesystem::path getFilePath( const KeyType key, const OfxRectD& bounds ) const;
+
+private:
+	DiskCacheTranslator _diskCacheTranslator;
+	bool _compression;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,7 @@
+%include <tuttle/host/global.i>
+
+%{
+#include <tuttle/host/diskCache/RenderDiskCache.hpp>
+%}
+
+%include <tuttle/host/diskCache/RenderDiskCache.hpp>
@@ -0,0 +1,90 @@
+#include "FrameOrderGate.hpp"
+
+#include <tuttle/host/ImageEffectNode.hpp>
+#include <tuttle/host/ofx/property/OfxhSet.hpp>
+
+#include <ofxImageEffect.h>
+
+#include <algorithm>
+
+namespace tuttle {
+namespace host {
+namespace graph {
+
+FrameOrderGate::Resource getFrameOrderResource( const INode& node )
+{
+	if( node.getNodeType() != INode::eNodeTypeImageEffect )
+		return &node;
+
+	const ImageEffectNode& effect = node.asImageEffectNode();
+	const std::string& threadSafety = effect.getRenderThreadSafety();
+	if( threadSafety == kOfxImageEffectRenderUnsafe )
+	{
+		// only one render at a time on all instances of this plugin
+		return &effect.getPlugin();
+	}
+	if( threadSafety != kOfxImageEffectRenderFullySafe ||
+	    node.getProperties().getIntProperty( kOfxImageEffectInstancePropSequentialRender ) != 0 )
+	{
+		return &node;
+	}
+	return NULL;
+}
+
+void FrameOrderGate::declare( Resource resource, const std::size_t frameIndex )
+{
+	boost::mutex::scoped_lock locker( _mutex );
+	_frames[resource].push_back( frameIndex );
+}
+
+void FrameOrderGate::acquire( Resource resource, const std::size_t frameIndex )
+{
+	boost::mutex::scoped_lock locker( _mutex );
+	FramesByResource::iterator it = _frames.find( resource );
+	if( it == _frames.end() )
+		return;
+	std::deque<std::size_t>& frames = it->second;
+	if( std::find( frames.begin(), frames.end(), frameIndex ) == frames.end() )
+		return;
+	while( frames.front() != frameIndex )
+	{
+		_condition.wait( locker );
+	}
+}
+
+void FrameOrderGate::release( Resource resource, const std::size_t frameIndex )
+{
+	{
+		boost::mutex::scoped_lock locker( _mutex );
+		FramesByResource::iterator it = _frames.find( resource );
+		if( it == _frames.end() || it->second.empty() || it->second.front() != frameIndex )
+			return;
+		it->second.pop_front();
+	}
+	_condition.notify_all();
+}
+
+void FrameOrderGate::abandon( const std::size_t frameIndex )
+{
+	{
+		boost::mutex::scoped_lock locker( _mutex );
+		for( FramesByResource::iterator it = _frames.begin(), itEnd = _frames.end();
+		     it != itEnd;
+		     ++it )
+		{
+			std::deque<std::size_t>& frames = it->second;
+			frames.erase( std::remove( frames.begin(), frames.end(), frameIndex ), frames.end() );
+		}
+	}
+	_condition.notify_all();
+}
+
+void FrameOrderGate::clear()
+{
+	boost::mutex::scoped_lock locker( _mutex );
+	_frames.clear();
+}
+
+}
+}
+}
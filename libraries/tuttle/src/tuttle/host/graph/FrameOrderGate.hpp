@@ -0,0 +1,77 @@
+#ifndef _TUTTLE_HOST_FRAMEORDERGATE_HPP_
+#define _TUTTLE_HOST_FRAMEORDERGATE_HPP_
+
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+#include <cstddef>
+#include <deque>
+#include <map>
+
+namespace tuttle {
+namespace host {
+
+class INode;
+
+namespace graph {
+
+/**
+ * @brief Serialize the access to some resources when multiple frames are rendered concurrently.
+ *
+ * A resource is a node which can't be processed concurrently on multiple frames
+ * (not fully thread safe, sequential render), or a plugin which is not thread safe at all.
+ * Each frame declares all the usages it will make of these resources,
+ * in the frame order. Then the frames get the access to a resource in this
+ * declaration order, so these nodes receive the frames in the time order.
+ */
+class FrameOrderGate
+{
+public:
+	typedef const void* Resource;
+
+public:
+	FrameOrderGate() {}
+
+	/**
+	 * @brief Declare a future usage of @p resource by the frame @p frameIndex.
+	 * @warning All declarations have to be done before starting the process.
+	 */
+	void declare( Resource resource, const std::size_t frameIndex );
+
+	/**
+	 * @brief Wait until all previous frames have finished to use @p resource.
+	 * @remark returns directly if the frame has not declared this resource.
+	 */
+	void acquire( Resource resource, const std::size_t frameIndex );
+
+	/**
+	 * @brief The frame @p frameIndex has finished to use @p resource.
+	 */
+	void release( Resource resource, const std::size_t frameIndex );
+
+	/**
+	 * @brief Remove all remaining usages of the frame @p frameIndex.
+	 * Needs to be called when a frame ends, especially if an error occurred.
+	 */
+	void abandon( const std::size_t frameIndex );
+
+	void clear();
+
+private:
+	typedef std::map<Resource, std::deque<std::size_t> > FramesByResource;
+	FramesByResource _frames;
+	boost::mutex _mutex;
+	boost::condition_variable _condition;
+};
+
+/**
+ * @brief Get the resource to lock to process @p node on multiple frames at the same time.
+ * @return NULL if the node could be processed concurrently on multiple frames.
+ */
+FrameOrderGate::Resource getFrameOrderResource( const INode& node );
+
+}
+}
+}
+
+#endif
@@ -515,12 +515,15 @@ public:
 	 */
 	std::size_t removeUnconnectedVertices( const vertex_descriptor& vroot );
 
+	/**
+	 * @brief Update the map from vertex keys to vertex descriptors.
+	 * Needed if the keys of the vertices are modified in place.
+	 */
+	void rebuildVertexDescriptorMap();
+
 	template< typename Vertex, typename Edge >
 	friend std::ostream& operator<<( std::ostream& os, const This& g );
 
-private:
-	void rebuildVertexDescriptorMap();
-
 protected:
 	GraphContainer _graph;
 	boost::unordered_map<VertexKey, vertex_descriptor> _vertexDescriptorMap;
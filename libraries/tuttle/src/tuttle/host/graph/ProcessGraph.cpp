@@ -1,13 +1,21 @@
 #include "ProcessGraph.hpp"
 #include "ProcessVisitors.hpp"
+#include "ProcessScheduler.hpp"
 #include <tuttle/common/utils/color.hpp>
+#include <tuttle/host/Core.hpp>
 #include <tuttle/host/graph/GraphExporter.hpp>
+#include <tuttle/host/attribute/ClipImage.hpp>
+#include <tuttle/host/attribute/Image.hpp>
+#include <tuttle/host/memory/MemoryCache.hpp>
+#include <tuttle/common/ofx/utilities.hpp>
 
 #include <boost/foreach.hpp>
+#include <boost/bind.hpp>
 
-#if(TUTTLE_EXPORT_WITH_TIMER)
 #include <boost/timer/timer.hpp>
-#endif
+
+#include <algorithm>
+#include <cstring>
 
 namespace tuttle {
 namespace host {
@@ -15,11 +23,80 @@ namespace graph {
 
 const std::string ProcessGraph::_outputId( "TUTTLE_FAKE_OUTPUT" );
 
+namespace {
+
+/**
+ * @brief Copy the pixels of @p src which are inside the bounds of @p dst.
+ * The images need to have the same pixel format.
+ */
+void copyTile( attribute::Image& dst, attribute::Image& src )
+{
+	const OfxRectI dstBounds = dst.getBounds();
+	const OfxRectI srcBounds = src.getBounds();
+	const OfxRectI region = {
+		std::max( dstBounds.x1, srcBounds.x1 ),
+		std::max( dstBounds.y1, srcBounds.y1 ),
+		std::min( dstBounds.x2, srcBounds.x2 ),
+		std::min( dstBounds.y2, srcBounds.y2 )
+	};
+	if( region.x2 <= region.x1 || region.y2 <= region.y1 )
+		return;
+
+	const std::size_t pixelBytes = dst.getBitDepthMemorySize() * dst.getNbComponents();
+	const std::size_t rowSize = ( region.x2 - region.x1 ) * pixelBytes;
+	const attribute::Image::EImageOrientation orientation = attribute::Image::eImageOrientationFromBottomToTop;
+	boost::uint8_t* dstData = dst.getOrientedPixelData( orientation ) + ( region.x1 - dstBounds.x1 ) * pixelBytes;
+	const boost::uint8_t* srcData = src.getOrientedPixelData( orientation ) + ( region.x1 - srcBounds.x1 ) * pixelBytes;
+	const int dstRowDistance = dst.getOrientedRowDistanceBytes( orientation );
+	const int srcRowDistance = src.getOrientedRowDistanceBytes( orientation );
+	for( int y = region.y1; y < region.y2; ++y )
+	{
+		std::memcpy( dstData + ( y - dstBounds.y1 ) * dstRowDistance, srcData + ( y - srcBounds.y1 ) * srcRowDistance, rowSize );
+	}
+}
+
+/**
+ * @brief Describe the times deployed on each vertex and edge of the graph, relative to @p time.
+ * Two frames with the same description have render graphs at time with the same topology.
+ */
+void computeTimeDeployment( std::vector<OfxTime>& topology, const ProcessGraph::InternalGraphImpl& graph, const OfxTime time )
+{
+	BOOST_FOREACH( const ProcessGraph::InternalGraphImpl::vertex_descriptor vd, graph.getVertices() )
+	{
+		const ProcessGraph::Vertex& v = graph.instance( vd );
+		topology.push_back( v._data._times.size() );
+		BOOST_FOREACH( const OfxTime t, v._data._times )
+		{
+			topology.push_back( t - time );
+		}
+	}
+	BOOST_FOREACH( const ProcessGraph::InternalGraphImpl::edge_descriptor ed, graph.getEdges() )
+	{
+		const ProcessGraph::Edge& e = graph.instance( ed );
+		topology.push_back( e._timesNeeded.size() );
+		BOOST_FOREACH( const ProcessGraph::Edge::TimeMap::value_type& tm, e._timesNeeded )
+		{
+			topology.push_back( tm.first - time );
+			topology.push_back( tm.second.size() );
+			BOOST_FOREACH( const OfxTime t, tm.second )
+			{
+				topology.push_back( t - time );
+			}
+		}
+	}
+}
+
+}
+
 ProcessGraph::ProcessGraph( const ComputeOptions& options, Graph& userGraph, const std::list<std::string>& outputNodes, memory::IMemoryCache& internMemoryCache )
-	: _instanceCount( userGraph.getInstanceCount() )
+	: _renderGraphAtTimeDeployed( false )
+	, _renderTime( 0 )
+	, _deployedTime( 0 )
+	, _instanceCount( userGraph.getInstanceCount() )
 	, _options(options)
 	, _internMemoryCache(internMemoryCache)
 	, _procOptions(&_internMemoryCache)
+	, _sequenceStarted( false )
 {
 	_procOptions._interactive = _options.getIsInteractive();
 	// imageEffect specific...
@@ -37,9 +114,9 @@ ProcessGraph::VertexAtTime::Key ProcessGraph::getOutputKeyAtTime( const OfxTime
 	return VertexAtTime(Vertex(_procOptions, _outputId), time).getKey();
 }
 
-ProcessGraph::InternalGraphAtTimeImpl::vertex_descriptor ProcessGraph::getOutputVertexAtTime( const OfxTime time )
+ProcessGraph::InternalGraphAtTimeImpl::vertex_descriptor ProcessGraph::getOutputVertexAtTime( InternalGraphAtTimeImpl& renderGraphAtTime, const OfxTime time )
 {
-	return _renderGraphAtTime.getVertexDescriptor( getOutputKeyAtTime( time ) );
+	return renderGraphAtTime.getVertexDescriptor( getOutputKeyAtTime( time ) );
 }
 
 /**
@@ -182,6 +259,7 @@ void ProcessGraph::beginSequence( const TimeRange& timeRange )
 	_procOptions._renderTimeRange.min = timeRange._begin;
 	_procOptions._renderTimeRange.max = timeRange._end;
 	_procOptions._step                = timeRange._step;
+	_sequenceStarted = true;
 
 	TUTTLE_LOG_INFO( "[begin sequence] start" );
 	//	BOOST_FOREACH( NodeMap::value_type& p, _nodes )
@@ -194,19 +272,52 @@ void ProcessGraph::beginSequence( const TimeRange& timeRange )
 	}
 }
 
+/**
+ * @brief End the sequence on all the nodes.
+ * The errors of the nodes, like the frames written in background threads by
+ * the writers, are handled like the errors of the frames, once all the nodes
+ * ended the sequence.
+ */
 void ProcessGraph::endSequence()
 {
+	if( ! _sequenceStarted )
+		return;
+	_sequenceStarted = false;
+
 	_options.endSequenceHandle();
 	TUTTLE_LOG_INFO( "[Process render] process end sequence" );
 	//--- END sequence render
+	std::vector<boost::exception_ptr> errors;
 	BOOST_FOREACH( NodeMap::value_type& p, _nodes )
 	{
-		p.second->endSequence( _procOptions ); // node option... or no option here ?
+		try
+		{
+			p.second->endSequence( _procOptions ); // node option... or no option here ?
+		}
+		catch(...)
+		{
+			TUTTLE_LOG_ERROR( "[Process render] Error at the end of the sequence on node \"" << p.first << "\"." );
+			errors.push_back( boost::current_exception() );
+		}
+	}
+	BOOST_FOREACH( const boost::exception_ptr& error, errors )
+	{
+		try
+		{
+			boost::rethrow_exception( error );
+		}
+		catch(...)
+		{
+			handleFrameError( _procOptions._renderTimeRange.max );
+		}
 	}
 }
 
 void ProcessGraph::updateGraph( Graph& userGraph, const std::list<std::string>& outputNodes )
 {
+	_deployedGraphAtTime.clear();
+	_deployedTopology.clear();
+	_renderGraphAtTimeDeployed = false;
 	_renderGraph.copyTransposed( userGraph.getGraph() );
 
 	Vertex outputVertex( _procOptions, _outputId );
@@ -240,6 +351,10 @@ void ProcessGraph::setup()
 	using namespace boost;
 	using namespace boost::graph;
 	TUTTLE_LOG_INFO( "[Process render] setup" );
+	// the process datas of the vertices are reinitialized
+	_deployedGraphAtTime.clear();
+	_deployedTopology.clear();
+	_renderGraphAtTimeDeployed = false;
 	
 	// Initialize variables
 //	OfxRectD renderWindow = { 0, 0, 0, 0 };
@@ -330,12 +445,99 @@ std::list<TimeRange> ProcessGraph::computeTimeRange()
 	return timeRanges;
 }
 
+/**
+ * @brief Move all the vertices and edges of @p renderGraphAtTime of @p offset in time.
+ */
+void ProcessGraph::shiftGraphAtTime( InternalGraphAtTimeImpl& renderGraphAtTime, const OfxTime offset )
+{
+	if( offset == 0 )
+		return;
+	BOOST_FOREACH( const InternalGraphAtTimeImpl::vertex_descriptor vd, renderGraphAtTime.getVertices() )
+	{
+		renderGraphAtTime.instance( vd ).shiftTime( offset );
+	}
+	BOOST_FOREACH( const InternalGraphAtTimeImpl::edge_descriptor ed, renderGraphAtTime.getEdges() )
+	{
+		renderGraphAtTime.instance( ed ).shiftTime( offset );
+	}
+	renderGraphAtTime.rebuildVertexDescriptorMap();
+}
+
+/**
+ * @brief Update _deployedGraphAtTime with the times deployed on _renderGraph for @p time.
+ *
+ * If the times needed by each node, relative to the frame time, are the same than
+ * for the previous frame, the topology of the graph is the same. So the graph is
+ * kept, and only moved to the new time when it is used (see setupAtTime),
+ * instead of building a new graph.
+ *
+ * @return if the previous topology has been reused
+ */
+bool ProcessGraph::updateDeployedGraphAtTime( const OfxTime time )
+{
+	std::vector<OfxTime> topology;
+	computeTimeDeployment( topology, _renderGraph, time );
+
+	if( _deployedGraphAtTime.getNbVertices() && topology == _deployedTopology )
+		return true;
+
+	// create a new graph with time information
+	_deployedGraphAtTime.clear();
+	BOOST_FOREACH( InternalGraphAtTimeImpl::vertex_descriptor vd, _renderGraph.getVertices() )
+	{
+		Vertex& v = _renderGraph.instance( vd );
+		BOOST_FOREACH( const OfxTime t, v._data._times )
+		{
+			TUTTLE_LOG_TRACE( "[Setup at time " << time << "] add connection from node: " << v << " for time: " << t );
+			_deployedGraphAtTime.addVertex( ProcessVertexAtTime(v, t) );
+		}
+	}
+	BOOST_FOREACH( const InternalGraphAtTimeImpl::edge_descriptor ed, _renderGraph.getEdges() )
+	{
+		const Edge& e = _renderGraph.instance( ed );
+		const Vertex& in = _renderGraph.sourceInstance( ed );
+		const Vertex& out = _renderGraph.targetInstance( ed );
+		TUTTLE_LOG_TRACE( "[Setup at time " << time << "] set connection " << e );
+		BOOST_FOREACH( const Edge::TimeMap::value_type& tm, e._timesNeeded )
+		{
+			const VertexAtTime procIn( in, tm.first );
+			BOOST_FOREACH( const OfxTime t2, tm.second )
+			{
+				const VertexAtTime procOut( out, t2 );
+
+				const VertexAtTime::Key inKey( procIn.getKey() );
+				const VertexAtTime::Key outKey( procOut.getKey() );
+
+				const EdgeAtTime eAtTime( outKey, inKey, e.getInAttrName() );
+
+				_deployedGraphAtTime.addEdge(
+					_deployedGraphAtTime.getVertexDescriptor( inKey ),
+					_deployedGraphAtTime.getVertexDescriptor( outKey ),
+					eAtTime );
+			}
+		}
+	}
+	_deployedTopology.swap( topology );
+	_deployedTime = time;
+	return false;
+}
+
 void ProcessGraph::setupAtTime( const OfxTime time )
+{
+	setupAtTime( time, _renderGraphAtTime );
+}
+
+void ProcessGraph::setupAtTime( const OfxTime time, InternalGraphAtTimeImpl& renderGraphAtTime )
 {
 	_options.setupAtTimeHandle();
 #if(TUTTLE_EXPORT_WITH_TIMER)
+	boost::timer::cpu_timer setupTimer;
 	boost::timer::cpu_timer timer;
 #endif
+	RenderProfile* profile = _options.getRenderProfile().get();
+	RenderProfile::Event setupEvent;
+	if( profile )
+		setupEvent = profile->beginEvent( "setup", "", time );
 	
 	TUTTLE_LOG_TRACE( "[Setup at time " << time << "] start" );
 	graph::visitor::DeployTime<InternalGraphImpl> deployTimeVisitor( _renderGraph, time );
@@ -345,66 +547,52 @@ void ProcessGraph::setupAtTime( const OfxTime time )
 #endif
 
 	TUTTLE_LOG_TRACE( "[Setup at time " << time << "] build render graph" );
-	// create a new graph with time information
-	_renderGraphAtTime.clear();
-	
+	const bool reused = updateDeployedGraphAtTime( time );
+	TUTTLE_LOG_TRACE( "[Setup at time " << time << "] " << ( reused ? "reuse" : "new" ) << " render graph topology" );
+	const bool isRenderGraph = ( &renderGraphAtTime == &_renderGraphAtTime );
+	if( reused && isRenderGraph && _renderGraphAtTimeDeployed )
 	{
-		BOOST_FOREACH( InternalGraphAtTimeImpl::vertex_descriptor vd, _renderGraph.getVertices() )
-		{
-			Vertex& v = _renderGraph.instance( vd );
-			BOOST_FOREACH( const OfxTime t, v._data._times )
-			{
-				TUTTLE_LOG_INFO( "[Setup at time " << time << "] add connection from node: " << v << " for time: " << t );
-				_renderGraphAtTime.addVertex( ProcessVertexAtTime(v, t) );
-			}
-		}
-		BOOST_FOREACH( const InternalGraphAtTimeImpl::edge_descriptor ed, _renderGraph.getEdges() )
+		// The graph of the previous frame has the deployed topology,
+		// so only move it to the new time and reset the datas of the previous frame.
+		shiftGraphAtTime( renderGraphAtTime, time - _renderTime );
+		BOOST_FOREACH( const InternalGraphAtTimeImpl::vertex_descriptor vd, renderGraphAtTime.getVertices() )
 		{
-			const Edge& e = _renderGraph.instance( ed );
-			const Vertex& in = _renderGraph.sourceInstance( ed );
-			const Vertex& out = _renderGraph.targetInstance( ed );
-			TUTTLE_LOG_INFO( "[Setup at time " << time << "] set connection " << e );
-			BOOST_FOREACH( const Edge::TimeMap::value_type& tm, e._timesNeeded )
-			{
-				const VertexAtTime procIn( in, tm.first );
-				BOOST_FOREACH( const OfxTime t2, tm.second )
-				{
-					//TUTTLE_LOG_VAR( TUTTLE_TRACE, tm.first );
-					//TUTTLE_LOG_VAR( TUTTLE_TRACE, t2 );
-					const VertexAtTime procOut( out, t2 );
-
-					const VertexAtTime::Key inKey( procIn.getKey() );
-					const VertexAtTime::Key outKey( procOut.getKey() );
-
-					//TUTTLE_LOG_VAR( TUTTLE_TRACE, inKey );
-					//TUTTLE_LOG_VAR( TUTTLE_TRACE, outKey );
-					//TUTTLE_LOG_VAR( TUTTLE_TRACE, e.getInAttrName() );
-
-					const EdgeAtTime eAtTime( outKey, inKey, e.getInAttrName() );
-
-					_renderGraphAtTime.addEdge(
-						_renderGraphAtTime.getVertexDescriptor( inKey ),
-						_renderGraphAtTime.getVertexDescriptor( outKey ),
-						eAtTime );
-				}
-			}
+			ProcessVertexAtTimeData& vData = renderGraphAtTime.instance( vd ).getProcessDataAtTime();
+			vData = ProcessVertexAtTimeData( *vData._nodeData, vData._time );
 		}
 	}
+	else
+	{
+		shiftGraphAtTime( _deployedGraphAtTime, time - _deployedTime );
+		_deployedTime = time;
+		renderGraphAtTime = _deployedGraphAtTime;
+	}
+	// the topology is modified by the removal of identity nodes and cached nodes
+	bool topologyModified = false;
+	if( isRenderGraph )
+	{
+		_renderGraphAtTimeDeployed = false;
+		_renderTime = time;
+	}
+#if(TUTTLE_EXPORT_WITH_TIMER)
+	TUTTLE_LOG_INFO( "[setup timer] build render graph (" << ( reused ? "reused" : "new" ) << " topology) " << boost::timer::format(timer.elapsed()) );
+	timer.start();
+#endif
 
-	InternalGraphAtTimeImpl::vertex_descriptor outputAtTime = getOutputVertexAtTime( time );
+	InternalGraphAtTimeImpl::vertex_descriptor outputAtTime = getOutputVertexAtTime( renderGraphAtTime, time );
 	
 	// declare final nodes
-	BOOST_FOREACH( const InternalGraphAtTimeImpl::edge_descriptor ed, boost::out_edges( outputAtTime, _renderGraphAtTime.getGraph() ) )
+	BOOST_FOREACH( const InternalGraphAtTimeImpl::edge_descriptor ed, boost::out_edges( outputAtTime, renderGraphAtTime.getGraph() ) )
 	{
-		VertexAtTime& v = _renderGraphAtTime.targetInstance( ed );
+		VertexAtTime& v = renderGraphAtTime.targetInstance( ed );
 		v.getProcessDataAtTime()._isFinalNode = true; /// @todo: this is maybe better to move this into the ProcessData? Doesn't depend on time?
 	}
 
 	TUTTLE_LOG_INFO( "[Setup at time " << time << "] set data at time" );
 	// give a link to the node on its attached process data
-	BOOST_FOREACH( const InternalGraphAtTimeImpl::vertex_descriptor vd, _renderGraphAtTime.getVertices() )
+	BOOST_FOREACH( const InternalGraphAtTimeImpl::vertex_descriptor vd, renderGraphAtTime.getVertices() )
 	{
-		VertexAtTime& v = _renderGraphAtTime.instance(vd);
+		VertexAtTime& v = renderGraphAtTime.instance(vd);
 		if( ! v.isFake() )
 		{
 			//TUTTLE_LOG_INFO( "setProcessDataAtTime: " << v._name << " id: " << v._id << " at time: " << v._data._time );
@@ -412,11 +600,14 @@ void ProcessGraph::setupAtTime( const OfxTime time )
 		}
 	}
 
-	bakeGraphInformationToNodes( _renderGraphAtTime );
-
+	bakeGraphInformationToNodes( renderGraphAtTime );
+#if(TUTTLE_EXPORT_WITH_TIMER)
+	TUTTLE_LOG_INFO( "[setup timer] bake graph " << boost::timer::format(timer.elapsed()) );
+	timer.start();
+#endif
 
 #if(TUTTLE_EXPORT_PROCESSGRAPH_DOT)
-	graph::exportDebugAsDOT( "graphProcessAtTime_a.dot", _renderGraphAtTime );
+	graph::exportDebugAsDOT( "graphProcessAtTime_a.dot", renderGraphAtTime );
 #endif
 
 	if( ! _options.getForceIdentityNodesProcess() )
@@ -425,45 +616,75 @@ void ProcessGraph::setupAtTime( const OfxTime time )
 		// The "Remove identity nodes" step need to be done after preprocess steps, because the RoI need to be computed.
 		std::vector<graph::visitor::IdentityNodeConnection<InternalGraphAtTimeImpl> > toRemove;
 
-		graph::visitor::RemoveIdentityNodes<InternalGraphAtTimeImpl> vis( _renderGraphAtTime, toRemove );
-		_renderGraphAtTime.depthFirstVisit( vis, outputAtTime );
+		graph::visitor::RemoveIdentityNodes<InternalGraphAtTimeImpl> vis( renderGraphAtTime, toRemove );
+		renderGraphAtTime.depthFirstVisit( vis, outputAtTime );
 		TUTTLE_LOG_TRACE( "[Setup at time " << time << "] removing " << toRemove.size() << " nodes" );
 		if( toRemove.size() )
 		{
-			graph::visitor::removeIdentityNodes( _renderGraphAtTime, toRemove );
+			topologyModified = true;
+			graph::visitor::removeIdentityNodes( renderGraphAtTime, toRemove );
 
 			// Bake graph information again as the connections have changed.
-			bakeGraphInformationToNodes( _renderGraphAtTime );
+			bakeGraphInformationToNodes( renderGraphAtTime );
 		}
 	}
+#if(TUTTLE_EXPORT_WITH_TIMER)
+	TUTTLE_LOG_INFO( "[setup timer] remove identity nodes " << boost::timer::format(timer.elapsed()) );
+	timer.start();
+#endif
 
 #if(TUTTLE_EXPORT_PROCESSGRAPH_DOT)
-	graph::exportDebugAsDOT( "graphProcessAtTime_b.dot", _renderGraphAtTime );
+	graph::exportDebugAsDOT( "graphProcessAtTime_b.dot", renderGraphAtTime );
 #endif
 
 	{
 		TUTTLE_LOG_TRACE( "[Setup at time " << time << "] preprocess 1" );
-		graph::visitor::PreProcess1<InternalGraphAtTimeImpl> preProcess1Visitor( _renderGraphAtTime );
-		_renderGraphAtTime.depthFirstVisit( preProcess1Visitor, outputAtTime );
+		graph::visitor::PreProcess1<InternalGraphAtTimeImpl> preProcess1Visitor( renderGraphAtTime );
+		renderGraphAtTime.depthFirstVisit( preProcess1Visitor, outputAtTime );
 	}
+#if(TUTTLE_EXPORT_WITH_TIMER)
+	TUTTLE_LOG_INFO( "[setup timer] preprocess 1 " << boost::timer::format(timer.elapsed()) );
+	timer.start();
+#endif
 
 	{
 		TUTTLE_LOG_TRACE( "[Setup at time " << time << "] preprocess 2" );
-		graph::visitor::PreProcess2<InternalGraphAtTimeImpl> preProcess2Visitor( _renderGraphAtTime );
-		_renderGraphAtTime.depthFirstVisit( preProcess2Visitor, outputAtTime );
+		RenderProfile::Event roiEvent;
+		if( profile )
+			roiEvent = profile->beginEvent( "regionsOfInterest", "", time );
+		computeRegionsOfInterest( renderGraphAtTime, outputAtTime, NULL );
+		if( profile )
+			profile->endEvent( roiEvent );
 	}
+#if(TUTTLE_EXPORT_WITH_TIMER)
+	TUTTLE_LOG_INFO( "[setup timer] regions of interest " << boost::timer::format(timer.elapsed()) );
+	timer.start();
+#endif
+
+	// The cache entries contain the full RoI of the nodes, which is not
+	// the region rendered for each tile (see processTilesAtTime).
+	if( ! _options.isTiled() && ( core().getNodeOutputCache().isEnabled() || hasRenderDiskCache() ) )
+	{
+		TUTTLE_LOG_TRACE( "[Setup at time " << time << "] use node output cache" );
+		// Needs the RoI computed by the preprocess steps.
+		topologyModified = useNodeOutputCache( time, renderGraphAtTime ) || topologyModified;
+	}
+#if(TUTTLE_EXPORT_WITH_TIMER)
+	TUTTLE_LOG_INFO( "[setup timer] node output cache " << boost::timer::format(timer.elapsed()) );
+	timer.start();
+#endif
 
 #if(TUTTLE_EXPORT_PROCESSGRAPH_DOT)
-	graph::exportDebugAsDOT( "graphProcessAtTime_c.dot", _renderGraphAtTime );
+	graph::exportDebugAsDOT( "graphProcessAtTime_c.dot", renderGraphAtTime );
 #endif
 
 	/*
 	TUTTLE_LOG_INFO( "---------------------------------------- optimize graph" );
-	graph::visitor::OptimizeGraph<InternalGraphAtTimeImpl> optimizeGraphVisitor( _renderGraphAtTime );
-	_renderGraphAtTime.depthFirstVisit( optimizeGraphVisitor, outputAtTime );
+	graph::visitor::OptimizeGraph<InternalGraphAtTimeImpl> optimizeGraphVisitor( renderGraphAtTime );
+	renderGraphAtTime.depthFirstVisit( optimizeGraphVisitor, outputAtTime );
 	*/
 #if(TUTTLE_EXPORT_PROCESSGRAPH_DOT)
-	graph::exportDebugAsDOT( "graphProcessAtTime_d.dot", _renderGraphAtTime );
+	graph::exportDebugAsDOT( "graphProcessAtTime_d.dot", renderGraphAtTime );
 #endif
 	/*
 	InternalGraphImpl tmpGraph;
@@ -511,6 +732,176 @@ void ProcessGraph::setupAtTime( const OfxTime time )
 #endif
 	*/
 
+	if( isRenderGraph )
+		_renderGraphAtTimeDeployed = ! topologyModified;
+
+#if(TUTTLE_EXPORT_WITH_TIMER)
+	TUTTLE_LOG_INFO( "[setup timer] setup at time " << time << " (" << ( reused ? "reused" : "new" ) << " topology) " << boost::timer::format( setupTimer.elapsed() ) );
+#endif
+	if( profile )
+		profile->endEvent( setupEvent );
+}
+
+/**
+ * @brief Compute the region to render for each node.
+ * The RoI of a node is the union of the regions needed by the nodes using its
+ * output (see getRegionOfInterestAction). Final nodes render their RoD or the
+ * @p tile if any.
+ */
+void ProcessGraph::computeRegionsOfInterest( InternalGraphAtTimeImpl& renderGraphAtTime, const InternalGraphAtTimeImpl::vertex_descriptor outputAtTime, const OfxRectD* tile )
+{
+	// inputs are visited before the nodes using them
+	std::vector<InternalGraphAtTimeImpl::vertex_descriptor> vertices;
+	graph::visitor::CollectVertices<InternalGraphAtTimeImpl> collectVisitor( vertices );
+	renderGraphAtTime.depthFirstVisit( collectVisitor, outputAtTime );
+
+	BOOST_REVERSE_FOREACH( const InternalGraphAtTimeImpl::vertex_descriptor vd, vertices )
+	{
+		VertexAtTime& v = renderGraphAtTime.instance( vd );
+		if( v.isFake() )
+			continue;
+		ProcessVertexAtTimeData& vData = v.getProcessDataAtTime();
+		const OfxRectD& rod = vData._apiImageEffect._renderRoD;
+
+		bool first = true;
+		OfxRectD roi = rod;
+		BOOST_FOREACH( const InternalGraphAtTimeImpl::edge_descriptor ed, renderGraphAtTime.getInEdges( vd ) )
+		{
+			VertexAtTime& user = renderGraphAtTime.sourceInstance( ed );
+			OfxRectD userRoI = rod;
+			if( user.isFake() )
+			{
+				if( tile )
+					userRoI = *tile;
+			}
+			else
+			{
+				const ProcessVertexAtTimeData::ImageEffect::MapClipImageRod& inputsRoI = user.getProcessDataAtTime()._apiImageEffect._inputsRoI;
+				attribute::ClipImage& clip = user.getProcessNode().getClip( renderGraphAtTime.instance( ed ).getInAttrName() );
+				ProcessVertexAtTimeData::ImageEffect::MapClipImageRod::const_iterator it = inputsRoI.find( &clip );
+				if( it != inputsRoI.end() )
+					userRoI = it->second;
+			}
+			roi = first ? userRoI : ::tuttle::ofx::rectUnion( roi, userRoI );
+			first = false;
+		}
+		// a node which doesn't support tiles always renders its full RoD
+		vData._apiImageEffect._renderRoI = v.getProcessNode().supportsTiles() ? ::tuttle::ofx::clamp( roi, rod ) : rod;
+		TUTTLE_LOG_TRACE( "[Regions of interest] " << v.getName() << " roi: " << vData._apiImageEffect._renderRoI );
+
+		v.getProcessNode().preProcess2_reverse( vData );
+	}
+}
+
+bool ProcessGraph::hasRenderDiskCache() const
+{
+	BOOST_FOREACH( const NodeMap::value_type& p, _nodes )
+	{
+		if( p.second->getRenderDiskCache() )
+			return true;
+	}
+	return false;
+}
+
+/**
+ * @brief Reuse the node outputs computed by previous renders.
+ * The nodes found in the NodeOutputCache or in the RenderDiskCache are
+ * disconnected from their inputs, so the part of the graph only used to
+ * compute them is not processed.
+ * @return if nodes have been disconnected
+ */
+bool ProcessGraph::useNodeOutputCache( const OfxTime time, InternalGraphAtTimeImpl& renderGraphAtTime )
+{
+	memory::NodeOutputCache& nodeOutputCache = core().getNodeOutputCache();
+	RenderDiskCache& renderDiskCache = core().getRenderDiskCache();
+	InternalGraphAtTimeImpl::vertex_descriptor outputAtTime = getOutputVertexAtTime( renderGraphAtTime, time );
+
+	NodeHashContainer nodesHash;
+	graph::visitor::ComputeHashAtTime<InternalGraphAtTimeImpl> computeHashAtTimeVisitor( renderGraphAtTime, nodesHash, time );
+	renderGraphAtTime.depthFirstVisit( computeHashAtTimeVisitor, outputAtTime );
+
+	// inputs are visited before the nodes using them
+	std::vector<InternalGraphAtTimeImpl::vertex_descriptor> vertices;
+	graph::visitor::CollectVertices<InternalGraphAtTimeImpl> collectVisitor( vertices );
+	renderGraphAtTime.depthFirstVisit( collectVisitor, outputAtTime );
+
+	std::vector<InternalGraphAtTimeImpl::vertex_descriptor> cachedVertices;
+	BOOST_FOREACH( const InternalGraphAtTimeImpl::vertex_descriptor vd, vertices )
+	{
+		VertexAtTime& v = renderGraphAtTime.instance( vd );
+		if( v.isFake() )
+			continue;
+		ProcessVertexAtTimeData& vData = v.getProcessDataAtTime();
+		vData._outputHash = 0;
+		vData._cachedOutput.reset();
+
+		INode& node = v.getProcessNode();
+		// a node is not cacheable if it depends on a node with side effects
+		bool cacheable = node.isOutputCacheable();
+		BOOST_FOREACH( const InternalGraphAtTimeImpl::edge_descriptor ed, renderGraphAtTime.getOutEdges( vd ) )
+		{
+			cacheable = cacheable && renderGraphAtTime.targetInstance( ed ).getProcessDataAtTime()._outputHash != 0;
+		}
+		if( ! cacheable )
+			continue;
+
+		std::size_t seed = nodesHash.getHash( v.getKey() );
+		boost::hash_combine( seed, vData._nodeData->_renderScale.x );
+		boost::hash_combine( seed, vData._nodeData->_renderScale.y );
+		boost::hash_combine( seed, node.getOutputClip().getComponentsString() );
+		boost::hash_combine( seed, node.getOutputClip().getBitDepthString() );
+		// the row alignment changes the buffer layout
+		boost::hash_combine( seed, core().getPreferences().getImageRowAlignment() );
+		vData._outputHash = ( seed != 0 ) ? seed : 1;
+
+		const OfxRectD& roi = vData._apiImageEffect._renderRoI;
+		const std::size_t memorySize = attribute::Image( node.getOutputClip(), vData._time, roi, attribute::Image::eImageOrientationFromBottomToTop, 0 ).getMemorySize();
+		vData._cachedOutput = nodeOutputCache.get( vData._outputHash, roi );
+		if( vData._cachedOutput && vData._cachedOutput->size() != memorySize )
+		{
+			TUTTLE_LOG_WARNING( "[Setup at time " << time << "] the output of " << v.getName() << " in the node output cache doesn't have the expected size" );
+			vData._cachedOutput.reset();
+		}
+		if( ! vData._cachedOutput && node.getRenderDiskCache() )
+		{
+			vData._cachedOutput = renderDiskCache.get( vData._outputHash, roi, memorySize );
+			if( vData._cachedOutput && nodeOutputCache.isEnabled() )
+			{
+				nodeOutputCache.put( vData._outputHash, roi, vData._cachedOutput );
+			}
+		}
+		if( vData._cachedOutput )
+		{
+			TUTTLE_LOG_TRACE( "[Setup at time " << time << "] reuse the output of " << v.getName() << " from the node output cache" );
+			cachedVertices.push_back( vd );
+		}
+	}
+	if( cachedVertices.empty() )
+		return false;
+
+	BOOST_FOREACH( const InternalGraphAtTimeImpl::vertex_descriptor vd, cachedVertices )
+	{
+		renderGraphAtTime.clearVertexOutputs( vd );
+	}
+
+	// release the outputs of the nodes which are not used anymore
+	std::vector<InternalGraphAtTimeImpl::vertex_descriptor> usedVertices;
+	graph::visitor::CollectVertices<InternalGraphAtTimeImpl> collectUsedVisitor( usedVertices );
+	renderGraphAtTime.depthFirstVisit( collectUsedVisitor, outputAtTime );
+	std::sort( usedVertices.begin(), usedVertices.end() );
+	BOOST_FOREACH( const InternalGraphAtTimeImpl::vertex_descriptor vd, cachedVertices )
+	{
+		if( ! std::binary_search( usedVertices.begin(), usedVertices.end(), vd ) )
+		{
+			ProcessVertexAtTimeData& vData = renderGraphAtTime.instance( vd ).getProcessDataAtTime();
+			vData._outputHash = 0;
+			vData._cachedOutput.reset();
+		}
+	}
+
+	// Bake graph information again as the connections have changed.
+	bakeGraphInformationToNodes( renderGraphAtTime );
+	return true;
 }
 
 void ProcessGraph::computeHashAtTime( NodeHashContainer& outNodesHash, const OfxTime time )
@@ -521,7 +912,7 @@ void ProcessGraph::computeHashAtTime( NodeHashContainer& outNodesHash, const Ofx
 	setupAtTime( time );
 	TUTTLE_LOG_INFO( "[Compute hash at time] begin" );
 	graph::visitor::ComputeHashAtTime<InternalGraphAtTimeImpl> computeHashAtTimeVisitor( _renderGraphAtTime, outNodesHash, time );
-	InternalGraphAtTimeImpl::vertex_descriptor outputAtTime = getOutputVertexAtTime( time );
+	InternalGraphAtTimeImpl::vertex_descriptor outputAtTime = getOutputVertexAtTime( _renderGraphAtTime, time );
 	_renderGraphAtTime.depthFirstVisit( computeHashAtTimeVisitor, outputAtTime );
 	TUTTLE_LOG_INFO( "[Compute hash at time] end" );
 }
@@ -533,46 +924,443 @@ void ProcessGraph::processAtTime( memory::IMemoryCache& outCache, const OfxTime
 	boost::timer::cpu_timer timer;
 #endif
 	
+	renderAtTime( outCache, time, _renderGraphAtTime );
+
+	///@todo clean datas...
+	TUTTLE_LOG_TRACE( "[Process at time " << time << "] Clear data at time" );
+	clearDataAtTime();
+
+	// clear cache at each frame
+	// @todo: remove
+	_internMemoryCache.clearUnused();
+
+	TUTTLE_LOG_TRACE( "[Process at time " << time << "] Memory cache size: " << _internMemoryCache.size() );
+	TUTTLE_LOG_TRACE( "[Process at time " << time << "] Out cache size: " << outCache.size() );
+}
+
+void ProcessGraph::renderAtTime( memory::IMemoryCache& outCache, const OfxTime time, InternalGraphAtTimeImpl& renderGraphAtTime, FrameOrderGate* gate, const std::size_t frameIndex )
+{
 	TUTTLE_LOG_TRACE( "[Process at time " << time << "] Output node : " << _renderGraph.getVertex( _outputId ).getName() );
-	InternalGraphAtTimeImpl::vertex_descriptor outputAtTime = getOutputVertexAtTime( time );
+	InternalGraphAtTimeImpl::vertex_descriptor outputAtTime = getOutputVertexAtTime( renderGraphAtTime, time );
 
     // Launch a pass of callbacks on the nodes
     graph::visitor::BeforeRenderCallbackVisitor<InternalGraphAtTimeImpl> 
-        callbackRun( _renderGraphAtTime );
-    _renderGraphAtTime.depthFirstVisit( callbackRun, outputAtTime );
+        callbackRun( renderGraphAtTime );
+    renderGraphAtTime.depthFirstVisit( callbackRun, outputAtTime );
 
 	// do the process
-	graph::visitor::Process<InternalGraphAtTimeImpl> processVisitor( _renderGraphAtTime, _internMemoryCache );
+	graph::visitor::Process<InternalGraphAtTimeImpl> processVisitor( renderGraphAtTime, _internMemoryCache );
 	if( _options.getReturnBuffers() )
 	{
 		// accumulate output nodes buffers into the @p outCache MemoryCache
 		processVisitor.setOutputMemoryCache( outCache );
 	}
+	if( gate )
+	{
+		processVisitor.setFrameOrderGate( *gate, frameIndex );
+	}
+	RenderProfile* profile = _options.getRenderProfile().get();
+	RenderProfile::Event frameEvent;
+	if( profile )
+	{
+		processVisitor.setRenderProfile( *profile );
+		frameEvent = profile->beginEvent( "frame", "", time );
+	}
 
-	_renderGraphAtTime.depthFirstVisit( processVisitor, outputAtTime );
+	if( _options.getNbParallelNodes() > 1 )
+	{
+		// process the independent branches concurrently
+		graph::ProcessScheduler<InternalGraphAtTimeImpl> scheduler( renderGraphAtTime, processVisitor );
+		scheduler.process( outputAtTime, _options.getNbParallelNodes() );
+	}
+	else
+	{
+		renderGraphAtTime.depthFirstVisit( processVisitor, outputAtTime );
+	}
 
 	TUTTLE_LOG_TRACE( "[Process at time " << time << "] Post process" );
-	graph::visitor::PostProcess<InternalGraphAtTimeImpl> postProcessVisitor( _renderGraphAtTime );
-	_renderGraphAtTime.depthFirstVisit( postProcessVisitor, outputAtTime );
+	graph::visitor::PostProcess<InternalGraphAtTimeImpl> postProcessVisitor( renderGraphAtTime );
+	renderGraphAtTime.depthFirstVisit( postProcessVisitor, outputAtTime );
 
-	///@todo clean datas...
-	TUTTLE_LOG_TRACE( "[Process at time " << time << "] Clear data at time" );
-	// give a link to the node on its attached process data
-	BOOST_FOREACH( const InternalGraphAtTimeImpl::vertex_descriptor vd, _renderGraphAtTime.getVertices() )
+	if( profile )
+		profile->endEvent( frameEvent );
+}
+
+/**
+ * @brief Render the frame at @p time tile by tile (see ComputeOptions::setTileSize).
+ * The graph is setup once for the frame, only the regions of interest are
+ * computed again for each tile.
+ * The node outputs are not reused from or stored into the caches.
+ * The tiles of the final nodes are gathered into full images for @p outCache.
+ */
+void ProcessGraph::processTilesAtTime( memory::IMemoryCache& outCache, const OfxTime time )
+{
+	setupAtTime( time );
+
+	// region rendered by the final nodes
+	InternalGraphAtTimeImpl::vertex_descriptor outputAtTime = getOutputVertexAtTime( _renderGraphAtTime, time );
+	bool supportsTiles = true;
+	bool first = true;
+	OfxRectD rod = { 0, 0, 0, 0 };
+	BOOST_FOREACH( const InternalGraphAtTimeImpl::edge_descriptor ed, boost::out_edges( outputAtTime, _renderGraphAtTime.getGraph() ) )
 	{
-		VertexAtTime& v = _renderGraphAtTime.instance(vd);
+		VertexAtTime& v = _renderGraphAtTime.targetInstance( ed );
+		const OfxRectD& nodeRoD = v.getProcessDataAtTime()._apiImageEffect._renderRoD;
+		rod = first ? nodeRoD : ::tuttle::ofx::rectUnion( rod, nodeRoD );
+		first = false;
+		supportsTiles = supportsTiles && v.getProcessNode().supportsTiles();
+	}
+	const OfxPointD& tileSize = _options.getTileSize();
+	if( ! supportsTiles || ( rod.x2 - rod.x1 <= tileSize.x && rod.y2 - rod.y1 <= tileSize.y ) )
+	{
+		TUTTLE_LOG_TRACE( "[Process at time " << time << "] render in one piece" );
+		processAtTime( outCache, time );
+		return;
+	}
+	clearDataAtTime();
+	_options.processAtTimeHandle();
+
+	memory::MemoryCache fullImages;
+	for( double y = rod.y1; y < rod.y2; y += tileSize.y )
+	{
+		for( double x = rod.x1; x < rod.x2; x += tileSize.x )
+		{
+			const OfxRectD tile = { x, y, std::min( x + tileSize.x, rod.x2 ), std::min( y + tileSize.y, rod.y2 ) };
+			TUTTLE_LOG_TRACE( "[Process at time " << time << "] render tile " << tile );
+
+			linkDataAtTime( _renderGraphAtTime );
+			computeRegionsOfInterest( _renderGraphAtTime, outputAtTime, &tile );
+			memory::MemoryCache tileImages;
+			renderAtTime( tileImages, time, _renderGraphAtTime );
+
+			BOOST_FOREACH( const InternalGraphAtTimeImpl::edge_descriptor ed, boost::out_edges( outputAtTime, _renderGraphAtTime.getGraph() ) )
+			{
+				VertexAtTime& v = _renderGraphAtTime.targetInstance( ed );
+				memory::CACHE_ELEMENT tileImage = tileImages.get( v._clipName, v._data._time );
+				if( ! tileImage.get() )
+					continue;
+				memory::CACHE_ELEMENT fullImage = fullImages.get( v._clipName, v._data._time );
+				if( ! fullImage.get() )
+				{
+					fullImage.reset( new attribute::Image(
+							v.getProcessNode().getOutputClip(),
+							v._data._time,
+							v.getProcessDataAtTime()._apiImageEffect._renderRoD,
+							attribute::Image::eImageOrientationFromBottomToTop,
+							0 )
+						);
+					fullImage->setPoolData( core().getMemoryPool().allocate( fullImage->getMemorySize() ) );
+					fullImages.put( v._clipName, v._data._time, fullImage );
+				}
+				copyTile( *fullImage, *tileImage );
+			}
+			clearDataAtTime();
+			_internMemoryCache.clearUnused();
+
+			if( _options.getAbort() )
+				return;
+		}
+	}
+
+	for( std::size_t i = 0; i < fullImages.size(); ++i )
+	{
+		memory::CACHE_ELEMENT fullImage = fullImages.get( i );
+		outCache.put( fullImages.getPluginName( fullImage ), fullImages.getTime( fullImage ), fullImage );
+	}
+}
+
+void ProcessGraph::clearDataAtTime()
+{
+	BOOST_FOREACH( NodeMap::value_type& p, _nodes )
+	{
+		p.second->clearProcessDataAtTime();
+	}
+}
+
+/**
+ * @brief Give a link to the nodes on their attached process data at time.
+ */
+void ProcessGraph::linkDataAtTime( InternalGraphAtTimeImpl& renderGraphAtTime )
+{
+	BOOST_FOREACH( const InternalGraphAtTimeImpl::vertex_descriptor vd, renderGraphAtTime.getVertices() )
+	{
+		VertexAtTime& v = renderGraphAtTime.instance( vd );
 		if( ! v.isFake() )
 		{
-			v.getProcessNode().clearProcessDataAtTime();
+			v.getProcessNode().setProcessDataAtTime( &v._data );
 		}
 	}
+}
 
-	// clear cache at each frame
-	// @todo: remove
-	_internMemoryCache.clearUnused();
+/**
+ * @brief Declare the nodes of a frame which need to be processed in the frame order.
+ * @return the memory needed to process this frame.
+ */
+std::size_t ProcessGraph::declareFrame( InternalGraphAtTimeImpl& renderGraphAtTime, const OfxTime time, const std::size_t frameIndex )
+{
+	std::vector<InternalGraphAtTimeImpl::vertex_descriptor> vertices;
+	graph::visitor::CollectVertices<InternalGraphAtTimeImpl> collectVisitor( vertices );
+	renderGraphAtTime.depthFirstVisit( collectVisitor, getOutputVertexAtTime( renderGraphAtTime, time ) );
 
-	TUTTLE_LOG_TRACE( "[Process at time " << time << "] Memory cache size: " << _internMemoryCache.size() );
-	TUTTLE_LOG_TRACE( "[Process at time " << time << "] Out cache size: " << outCache.size() );
+	std::size_t memory = 0;
+	BOOST_FOREACH( const InternalGraphAtTimeImpl::vertex_descriptor vd, vertices )
+	{
+		VertexAtTime& v = renderGraphAtTime.instance( vd );
+		if( v.isFake() )
+			continue;
+
+		ProcessVertexAtTimeData& vData = v.getProcessDataAtTime();
+		v.getProcessNode().preProcess_infos( vData, vData._time, vData._localInfos );
+		memory += vData._localInfos._memory;
+
+		const FrameOrderGate::Resource resource = getFrameOrderResource( v.getProcessNode() );
+		if( resource )
+			_frameOrderGate.declare( resource, frameIndex );
+	}
+	return memory;
+}
+
+void ProcessGraph::renderFrame( memory::IMemoryCache& outCache, FrameRenderVector& frames, const std::size_t frameIndex, const std::size_t nbThreads )
+{
+	FrameRender& frame = frames[frameIndex];
+	if( ! frame._error )
+	{
+		ThreadPool::setThreadBudget( nbThreads );
+		try
+		{
+			renderAtTime( outCache, frame._time, frame._renderGraphAtTime, &_frameOrderGate, frameIndex );
+		}
+		catch( ... )
+		{
+			frame._error = boost::current_exception();
+		}
+		ThreadPool::setThreadBudget( 0 );
+	}
+	// the next frames can't wait for this frame anymore
+	_frameOrderGate.abandon( frameIndex );
+}
+
+/**
+ * @brief Process a time range with multiple frames rendered concurrently.
+ *
+ * Frames are processed by batches. Each frame of a batch is setup in its own
+ * render graph, then all the frames of the batch are rendered in parallel,
+ * as tasks of the Core ThreadPool.
+ * A batch is limited by the number of parallel frames, by the memory available
+ * and it can't contain two frames which need the same node at the same time.
+ * A frame can wait for the previous ones (see FrameOrderGate), so a batch never
+ * contains more frames than the threads of the pool.
+ *
+ * @return false if the process has been aborted.
+ */
+bool ProcessGraph::processFramesInParallel( memory::IMemoryCache& outCache, const TimeRange& timeRange )
+{
+	ThreadPool& threadPool = core().getThreadPool();
+	const std::size_t nbParallelFrames = std::max( std::size_t(1), std::min( _options.getNbParallelFrames(), threadPool.getNbThreads() ) );
+	int time = timeRange._begin;
+	int lastFrameBegun = timeRange._begin - timeRange._step;
+
+	while( time <= timeRange._end )
+	{
+		FrameRenderVector frames;
+		std::set<VertexAtTime::Key> batchVertices;
+		std::size_t batchMemory = 0;
+		const std::size_t memoryAvailable = core().getMemoryPool().getAvailableMemorySize();
+
+		_frameOrderGate.clear();
+
+		// setup frames of the batch
+		while( frames.size() < nbParallelFrames && time <= timeRange._end )
+		{
+			if( time > lastFrameBegun )
+			{
+				_options.beginFrameHandle();
+				lastFrameBegun = time;
+			}
+			frames.push_back( new FrameRender( time ) );
+			FrameRender& frame = frames.back();
+			try
+			{
+				setupAtTime( time, frame._renderGraphAtTime );
+			}
+			catch( ... )
+			{
+				frame._error = boost::current_exception();
+			}
+
+			if( frames.size() > 1 )
+			{
+				// a frame which can't be rendered with the others will be the first one of the next batch
+				bool delayed = frame._error ? true : false;
+				BOOST_FOREACH( const InternalGraphAtTimeImpl::vertex_descriptor vd, frame._renderGraphAtTime.getVertices() )
+				{
+					if( batchVertices.count( frame._renderGraphAtTime.instance( vd ).getKey() ) )
+					{
+						delayed = true;
+						break;
+					}
+				}
+				if( delayed )
+				{
+					TUTTLE_LOG_TRACE( "[Process render] frame " << time << " delayed to the next batch" );
+					frames.pop_back();
+					break;
+				}
+			}
+
+			if( ! frame._error )
+			{
+				const std::size_t frameIndex = frames.size() - 1;
+				const std::size_t frameMemory = declareFrame( frame._renderGraphAtTime, time, frameIndex );
+				if( frameIndex > 0 && batchMemory + frameMemory > memoryAvailable )
+				{
+					TUTTLE_LOG_TRACE( "[Process render] frame " << time << " delayed to the next batch (not enough memory)" );
+					_frameOrderGate.abandon( frameIndex );
+					frames.pop_back();
+					break;
+				}
+				batchMemory += frameMemory;
+				BOOST_FOREACH( const InternalGraphAtTimeImpl::vertex_descriptor vd, frame._renderGraphAtTime.getVertices() )
+				{
+					const VertexAtTime& v = frame._renderGraphAtTime.instance( vd );
+					if( ! v.isFake() )
+						batchVertices.insert( v.getKey() );
+				}
+			}
+			time += timeRange._step;
+		}
+
+		// The setup of a delayed frame may have replaced the data at time of the frames in the batch.
+		clearDataAtTime();
+		BOOST_FOREACH( FrameRender& frame, frames )
+		{
+			if( ! frame._error )
+				linkDataAtTime( frame._renderGraphAtTime );
+		}
+
+		TUTTLE_LOG_TRACE( "[Process render] render " << frames.size() << " frames in parallel, from " << frames.front()._time << " to " << frames.back()._time );
+		std::size_t nbFramesToRender = 0;
+		BOOST_FOREACH( const FrameRender& frame, frames )
+		{
+			if( frame._error )
+				continue;
+			_options.processAtTimeHandle();
+			++nbFramesToRender;
+		}
+		// the threads of the pool are shared between the frames
+		const std::size_t nbThreadsByFrame = std::max( std::size_t(1), threadPool.getNbThreads() / std::max( std::size_t(1), nbFramesToRender ) );
+		threadPool.execute( boost::bind( &ProcessGraph::renderFrame, this, boost::ref( outCache ), boost::ref( frames ), _1, nbThreadsByFrame ), frames.size() );
+
+		clearDataAtTime();
+
+		// report errors in the frame order
+		BOOST_FOREACH( FrameRender& frame, frames )
+		{
+			if( frame._error )
+			{
+				try
+				{
+					boost::rethrow_exception( frame._error );
+				}
+				catch( ... )
+				{
+					handleFrameError( frame._time );
+				}
+			}
+			_options.endFrameHandle();
+		}
+		_internMemoryCache.clearUnused();
+
+		if( _options.getAbort() )
+		{
+			TUTTLE_LOG_ERROR( "[Process render] PROCESS ABORTED at time " << frames.back()._time << "." );
+			abortProcess( false );
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * @brief Continue or stop the process after an error on the frame at @p time.
+ * @remark Needs to be called inside a catch block. The exception is rethrown if we can't continue.
+ */
+void ProcessGraph::handleFrameError( const OfxTime time )
+{
+	try
+	{
+		throw;
+	}
+	catch( tuttle::exception::FileInSequenceNotExist& e ) // @todo tuttle: change that.
+	{
+		e << tuttle::exception::time(time);
+		if( _options.getContinueOnError() || _options.getContinueOnMissingFile() )
+		{
+			TUTTLE_LOG_WARNING( "[Process render] Missing input file at frame " << time << "." << std::endl );
+			TUTTLE_LOG_DEBUG( tuttle::exception::format_exception_message(e) << std::endl
+					<< tuttle::exception::format_exception_info(e)
+				);
+		}
+		else
+		{
+			TUTTLE_LOG_ERROR( "[Process render] Missing input file at frame " << time << "." << std::endl );
+			abortProcess();
+			throw;
+		}
+	}
+	catch( ::boost::exception& e )
+	{
+		e << tuttle::exception::time(time);
+		if( _options.getContinueOnError() )
+		{
+			TUTTLE_LOG_ERROR( "[Process render] Skip frame " << time << "." << std::endl );
+			TUTTLE_LOG_DEBUG( tuttle::exception::format_exception_message(e) << std::endl
+					<< tuttle::exception::format_exception_info(e)
+				);
+		}
+		else
+		{
+			TUTTLE_LOG_ERROR( "[Process render] Stopped at frame " << time << "." << std::endl );
+			abortProcess();
+			throw;
+		}
+	}
+	catch(...)
+	{
+		if( _options.getContinueOnError() )
+		{
+			TUTTLE_LOG_ERROR( "[Process render] Skip frame " << time << "." << std::endl
+					<< tuttle::exception::format_current_exception()
+				);
+		}
+		else
+		{
+			TUTTLE_LOG_ERROR( "[Process render] Error at frame " << time << "." << std::endl );
+			abortProcess();
+			throw;
+		}
+	}
+}
+
+/**
+ * @brief Stop the process.
+ * @param inFrame the process is stopped in the middle of a frame
+ */
+void ProcessGraph::abortProcess( const bool inFrame )
+{
+	if( inFrame )
+		_options.endFrameHandle();
+	try
+	{
+		endSequence();
+	}
+	catch(...)
+	{
+		// already reported, keep the error which stops the process
+	}
+	_renderGraphAtTime.clear();
+	_renderGraphAtTimeDeployed = false;
+	_internMemoryCache.clearUnused();
 }
 
 bool ProcessGraph::process( memory::IMemoryCache& outCache )
@@ -619,11 +1407,17 @@ bool ProcessGraph::process( memory::IMemoryCache& outCache )
 		if( _options.getAbort() )
 		{
 			TUTTLE_LOG_ERROR( "[Process render] PROCESS ABORTED before first frame." );
-			endSequence();
-			_internMemoryCache.clearUnused();
+			abortProcess( false );
 			return false;
 		}
 
+		if( _options.getNbParallelFrames() > 1 )
+		{
+			if( ! processFramesInParallel( outCache, timeRange ) )
+				return false;
+			continue;
+		}
+
 		for( int time = timeRange._begin; time <= timeRange._end; time += timeRange._step )
 		{
 			_options.beginFrameHandle();
@@ -633,85 +1427,35 @@ bool ProcessGraph::process( memory::IMemoryCache& outCache )
 #if(TUTTLE_EXPORT_WITH_TIMER)
 				boost::timer::cpu_timer setup_timer;
 #endif
-				setupAtTime( time );
+				if( _options.isTiled() )
+				{
+					processTilesAtTime( outCache, time );
+				}
+				else
+				{
+					setupAtTime( time );
 #if(TUTTLE_EXPORT_WITH_TIMER)
-				TUTTLE_LOG_INFO( "[process timer] setup " << boost::timer::format(setup_timer.elapsed()) );
+					TUTTLE_LOG_INFO( "[process timer] setup " << boost::timer::format(setup_timer.elapsed()) );
 #endif
 
 #if(TUTTLE_EXPORT_WITH_TIMER)
-				boost::timer::cpu_timer processAtTime_timer;
+					boost::timer::cpu_timer processAtTime_timer;
 #endif
-				processAtTime( outCache, time );
+					processAtTime( outCache, time );
 #if(TUTTLE_EXPORT_WITH_TIMER)
-				TUTTLE_LOG_INFO( "[process timer] took " << boost::timer::format(processAtTime_timer.elapsed()) );
+					TUTTLE_LOG_INFO( "[process timer] took " << boost::timer::format(processAtTime_timer.elapsed()) );
 #endif
-			}
-			catch( tuttle::exception::FileInSequenceNotExist& e ) // @todo tuttle: change that.
-			{
-				e << tuttle::exception::time(time);
-				if( _options.getContinueOnError() || _options.getContinueOnMissingFile() )
-				{
-					TUTTLE_LOG_WARNING( "[Process render] Missing input file at frame " << time << "." << std::endl );
-					TUTTLE_LOG_DEBUG( tuttle::exception::format_exception_message(e) << std::endl
-							<< tuttle::exception::format_exception_info(e)
-						);
-				}
-				else
-				{
-					TUTTLE_LOG_ERROR( "[Process render] Missing input file at frame " << time << "." << std::endl );
-					_options.endFrameHandle();
-					endSequence();
-					_renderGraphAtTime.clear();
-					_internMemoryCache.clearUnused();
-					throw;
-				}
-			}
-			catch( ::boost::exception& e )
-			{
-				e << tuttle::exception::time(time);
-				if( _options.getContinueOnError() )
-				{
-					TUTTLE_LOG_ERROR( "[Process render] Skip frame " << time << "." << std::endl );
-					TUTTLE_LOG_DEBUG( tuttle::exception::format_exception_message(e) << std::endl
-							<< tuttle::exception::format_exception_info(e)
-						);
-				}
-				else
-				{
-					TUTTLE_LOG_ERROR( "[Process render] Stopped at frame " << time << "." << std::endl );
-					_options.endFrameHandle();
-					endSequence();
-					_renderGraphAtTime.clear();
-					_internMemoryCache.clearUnused();
-					throw;
 				}
 			}
 			catch(...)
 			{
-				if( _options.getContinueOnError() )
-				{
-					TUTTLE_LOG_ERROR( "[Process render] Skip frame " << time << "." << std::endl
-							<< tuttle::exception::format_current_exception()
-						);
-				}
-				else
-				{
-					TUTTLE_LOG_ERROR( "[Process render] Error at frame " << time << "." << std::endl );
-					_options.endFrameHandle();
-					endSequence();
-					_renderGraphAtTime.clear();
-					_internMemoryCache.clearUnused();
-					throw;
-				}
+				handleFrameError( time );
 			}
 
 			if( _options.getAbort() )
 			{
 				TUTTLE_LOG_ERROR( "[Process render] PROCESS ABORTED at time " << time << "." );
-				_options.endFrameHandle();
-				endSequence();
-				_renderGraphAtTime.clear();
-				_internMemoryCache.clearUnused();
+				abortProcess();
 				return false;
 			}
 			_options.endFrameHandle();
@@ -720,6 +1464,8 @@ bool ProcessGraph::process( memory::IMemoryCache& outCache )
 
 	// End range of frames
 	endSequence();
+	// images kept by the plugins until the end of the sequence
+	_internMemoryCache.clearUnused();
 
 #if(TUTTLE_EXPORT_WITH_TIMER)
 	TUTTLE_LOG_INFO( "[all process timer] " << boost::timer::format(all_process_timer.elapsed()) );
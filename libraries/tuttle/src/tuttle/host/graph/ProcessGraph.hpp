@@ -7,10 +7,15 @@
 #include "ProcessEdgeAtTime.hpp"
 
 #include "InternalGraph.hpp"
+#include "FrameOrderGate.hpp"
 
 #include <tuttle/host/Graph.hpp>
 #include <tuttle/host/NodeHashContainer.hpp>
 
+#include <boost/exception_ptr.hpp>
+#include <boost/ptr_container/ptr_vector.hpp>
+
+#include <set>
 #include <string>
 
 /**
@@ -53,13 +58,42 @@ public:
 			const std::list<std::string>& nodes, memory::IMemoryCache& internMemoryCache ); ///@ todo: const Graph, no ?
 	~ProcessGraph();
 
+private:
+	/// A frame rendered with its own graph, when multiple frames are processed concurrently.
+	struct FrameRender
+	{
+		FrameRender( const OfxTime time ) : _time( time ) {}
+		OfxTime _time;
+		InternalGraphAtTimeImpl _renderGraphAtTime;
+		boost::exception_ptr _error;
+	};
+	typedef boost::ptr_vector<FrameRender> FrameRenderVector;
+
 private:
 	VertexAtTime::Key getOutputKeyAtTime( const OfxTime time );
-	InternalGraphAtTimeImpl::vertex_descriptor getOutputVertexAtTime( const OfxTime time );
+	InternalGraphAtTimeImpl::vertex_descriptor getOutputVertexAtTime( InternalGraphAtTimeImpl& renderGraphAtTime, const OfxTime time );
 	
 	void relink();
 	void bakeGraphInformationToNodes( InternalGraphAtTimeImpl& renderGraphAtTime );
 
+	static void shiftGraphAtTime( InternalGraphAtTimeImpl& renderGraphAtTime, const OfxTime offset );
+	bool updateDeployedGraphAtTime( const OfxTime time );
+	void setupAtTime( const OfxTime time, InternalGraphAtTimeImpl& renderGraphAtTime );
+	void computeRegionsOfInterest( InternalGraphAtTimeImpl& renderGraphAtTime, const InternalGraphAtTimeImpl::vertex_descriptor outputAtTime, const OfxRectD* tile );
+	bool hasRenderDiskCache() const;
+	bool useNodeOutputCache( const OfxTime time, InternalGraphAtTimeImpl& renderGraphAtTime );
+	void renderAtTime( memory::IMemoryCache& outCache, const OfxTime time, InternalGraphAtTimeImpl& renderGraphAtTime, FrameOrderGate* gate = NULL, const std::size_t frameIndex = 0 );
+	void processTilesAtTime( memory::IMemoryCache& outCache, const OfxTime time );
+	void clearDataAtTime();
+	void linkDataAtTime( InternalGraphAtTimeImpl& renderGraphAtTime );
+
+	std::size_t declareFrame( InternalGraphAtTimeImpl& renderGraphAtTime, const OfxTime time, const std::size_t frameIndex );
+	void renderFrame( memory::IMemoryCache& outCache, FrameRenderVector& frames, const std::size_t frameIndex, const std::size_t nbThreads );
+	bool processFramesInParallel( memory::IMemoryCache& outCache, const TimeRange& timeRange );
+
+	void handleFrameError( const OfxTime time );
+	void abortProcess( const bool inFrame = true );
+
 public:
 	void updateGraph( Graph& userGraph, const std::list<std::string>& outputNodes );
 
@@ -77,6 +111,15 @@ public:
 private:
 	InternalGraphImpl _renderGraph;
 	InternalGraphAtTimeImpl _renderGraphAtTime;
+	/// _renderGraphAtTime has the topology of _deployedGraphAtTime (no identity or cached node removed),
+	/// so the next frame moves it to its time in place instead of copying _deployedGraphAtTime.
+	bool _renderGraphAtTimeDeployed;
+	OfxTime _renderTime; ///< time of _renderGraphAtTime
+	/// Render graph at time before removing identity nodes and cached nodes.
+	/// Reused by the next frames if the times deployed on the graph are the same.
+	InternalGraphAtTimeImpl _deployedGraphAtTime;
+	std::vector<OfxTime> _deployedTopology; ///< times deployed on the graph, relative to _deployedTime
+	OfxTime _deployedTime;
 	NodeMap _nodes;
 	InstanceCountMap _instanceCount;
 
@@ -85,6 +128,8 @@ private:
 	const ComputeOptions& _options;
 	memory::IMemoryCache& _internMemoryCache;
 	ProcessVertexData _procOptions;
+	FrameOrderGate _frameOrderGate;
+	bool _sequenceStarted; ///< between beginSequence and endSequence
 };
 
 }
@@ -0,0 +1,212 @@
+#ifndef _TUTTLE_HOST_PROCESSSCHEDULER_HPP_
+#define _TUTTLE_HOST_PROCESSSCHEDULER_HPP_
+
+#include "ProcessVisitors.hpp"
+#include "FrameOrderGate.hpp"
+
+#include <tuttle/host/Core.hpp>
+#include <tuttle/host/ThreadPool.hpp>
+#include <tuttle/common/utils/global.hpp>
+
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/exception_ptr.hpp>
+#include <boost/foreach.hpp>
+#include <boost/bind.hpp>
+
+#include <algorithm>
+#include <vector>
+#include <set>
+#include <map>
+
+namespace tuttle {
+namespace host {
+namespace graph {
+
+/**
+ * @brief Process the vertices of a graph at time, with multiple nodes processed concurrently.
+ *
+ * A vertex is ready as soon as all its inputs are processed, so independent
+ * branches of the graph (like the two inputs of a merge) are processed at the
+ * same time. The ready vertices are taken in the order of the depth first
+ * process, to keep the memory usage close to the sequential process.
+ * Vertices which use the same FrameOrderGate resource (same node at multiple
+ * times, same thread unsafe plugin) are never processed together.
+ *
+ * The lanes processing the vertices are tasks of the Core ThreadPool, and
+ * each node processed gets a part of the threads available to the caller for
+ * its own multithreading (see ThreadPool::setThreadBudget), so a node waiting
+ * for I/O doesn't prevent the others from using all the CPUs.
+ */
+template<class TGraph>
+class ProcessScheduler
+{
+public:
+	typedef typename TGraph::vertex_descriptor vertex_descriptor;
+	typedef typename TGraph::edge_descriptor edge_descriptor;
+	typedef typename TGraph::Vertex Vertex;
+
+public:
+	ProcessScheduler( TGraph& graph, const visitor::Process<TGraph>& processVisitor )
+		: _graph( graph )
+		, _processVisitor( processVisitor )
+		, _nbRemaining( 0 )
+		, _nbRunning( 0 )
+		, _nbThreads( 1 )
+	{}
+
+	/**
+	 * @brief Process all the vertices needed by @p root.
+	 * @param nbParallelNodes maximum number of nodes processed at the same time
+	 */
+	void process( const vertex_descriptor root, const std::size_t nbParallelNodes )
+	{
+		init( root );
+
+		ThreadPool& threadPool = core().getThreadPool();
+		// threads available to the caller, shared by the nodes processed concurrently
+		_nbThreads = threadPool.getThreadBudget();
+		const std::size_t nbLanes = std::max( std::size_t(1), std::min( std::min( nbParallelNodes, _nbThreads ), _vertices.size() ) );
+		TUTTLE_LOG_TRACE( "[Process scheduler] " << _vertices.size() << " vertices, " << nbLanes << " lanes" );
+		if( nbLanes == 1 )
+		{
+			processLane( 0 );
+		}
+		else
+		{
+			threadPool.execute( boost::bind( &ProcessScheduler::processLane, this, _1 ), nbLanes );
+		}
+
+		if( _error )
+			boost::rethrow_exception( _error );
+	}
+
+private:
+	void init( const vertex_descriptor root )
+	{
+		// the depth first order of the sequential process
+		_vertices.clear();
+		visitor::CollectVertices<TGraph> collectVertices( _vertices );
+		_graph.depthFirstVisit( collectVertices, root );
+
+		_indexes.clear();
+		for( std::size_t i = 0; i < _vertices.size(); ++i )
+		{
+			_indexes[_vertices[i]] = i;
+		}
+
+		_nbPendingInputs.assign( _vertices.size(), 0 );
+		_resources.assign( _vertices.size(), NULL );
+		_ready.clear();
+		_busyResources.clear();
+		for( std::size_t i = 0; i < _vertices.size(); ++i )
+		{
+			const vertex_descriptor v = _vertices[i];
+			// out edges go to the input nodes
+			_nbPendingInputs[i] = boost::out_degree( v, _graph.getGraph() );
+			const Vertex& vertex = _graph.instance( v );
+			if( ! vertex.isFake() )
+				_resources[i] = getFrameOrderResource( vertex.getProcessNode() );
+			if( _nbPendingInputs[i] == 0 )
+				_ready.insert( i );
+		}
+		_nbRemaining = _vertices.size();
+		_nbRunning = 0;
+		_error = boost::exception_ptr();
+	}
+
+	/// @brief Process ready vertices until the end of the graph or an error.
+	void processLane( const std::size_t )
+	{
+		for(;;)
+		{
+			std::size_t index;
+			std::size_t budget;
+			{
+				boost::mutex::scoped_lock locker( _mutex );
+				while( ! _error && _nbRemaining != 0 && ! popReadyVertex( index ) )
+				{
+					_changed.wait( locker );
+				}
+				if( _error || _nbRemaining == 0 )
+					return;
+				++_nbRunning;
+				if( _resources[index] )
+					_busyResources.insert( _resources[index] );
+				budget = std::max( std::size_t(1), _nbThreads / _nbRunning );
+			}
+
+			try
+			{
+				ThreadPool::setThreadBudget( budget );
+				_processVisitor.processVertex( _graph.instance( _vertices[index] ) );
+				ThreadPool::setThreadBudget( 0 );
+			}
+			catch(...)
+			{
+				ThreadPool::setThreadBudget( 0 );
+				boost::mutex::scoped_lock locker( _mutex );
+				if( ! _error )
+					_error = boost::current_exception();
+				--_nbRunning;
+				_changed.notify_all();
+				return;
+			}
+
+			boost::mutex::scoped_lock locker( _mutex );
+			--_nbRunning;
+			--_nbRemaining;
+			if( _resources[index] )
+				_busyResources.erase( _busyResources.find( _resources[index] ) );
+			// in edges come from the nodes which use this one
+			BOOST_FOREACH( const edge_descriptor& e, boost::in_edges( _vertices[index], _graph.getGraph() ) )
+			{
+				typename std::map<vertex_descriptor, std::size_t>::const_iterator it = _indexes.find( boost::source( e, _graph.getGraph() ) );
+				if( it == _indexes.end() )
+					continue;
+				if( --_nbPendingInputs[it->second] == 0 )
+					_ready.insert( it->second );
+			}
+			_changed.notify_all();
+		}
+	}
+
+	/// @brief Take the first ready vertex which doesn't wait for a resource. Called with the lock.
+	bool popReadyVertex( std::size_t& index )
+	{
+		for( std::set<std::size_t>::iterator it = _ready.begin(), itEnd = _ready.end(); it != itEnd; ++it )
+		{
+			const FrameOrderGate::Resource resource = _resources[*it];
+			if( resource && _busyResources.find( resource ) != _busyResources.end() )
+				continue;
+			index = *it;
+			_ready.erase( it );
+			return true;
+		}
+		return false;
+	}
+
+private:
+	TGraph& _graph;
+	const visitor::Process<TGraph>& _processVisitor;
+
+	std::vector<vertex_descriptor> _vertices; ///< vertices to process, in the depth first order
+	std::map<vertex_descriptor, std::size_t> _indexes; ///< index of each vertex in _vertices
+	std::vector<std::size_t> _nbPendingInputs; ///< number of inputs not yet processed for each vertex
+	std::vector<FrameOrderGate::Resource> _resources; ///< resource used by each vertex
+	std::set<std::size_t> _ready; ///< vertices with all inputs processed
+	std::multiset<FrameOrderGate::Resource> _busyResources;
+	std::size_t _nbRemaining; ///< number of vertices not yet processed
+	std::size_t _nbRunning; ///< number of vertices in process
+	std::size_t _nbThreads; ///< threads shared by the vertices in process
+	boost::exception_ptr _error; ///< first error, stops the process
+
+	boost::mutex _mutex;
+	boost::condition_variable _changed;
+};
+
+}
+}
+}
+
+#endif
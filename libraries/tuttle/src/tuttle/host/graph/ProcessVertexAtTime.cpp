@@ -34,6 +34,12 @@ ProcessVertexAtTime::~ProcessVertexAtTime( )
 {
 }
 
+void ProcessVertexAtTime::shiftTime( const OfxTime offset )
+{
+	_data._time += offset;
+	_name = _clipName + "_at_" + boost::lexical_cast<std::string>(_data._time);
+}
+
 std::ostream& ProcessVertexAtTime::exportDotDebug( std::ostream& os ) const
 {
 	std::ostringstream s;
@@ -38,6 +38,12 @@ public:
 		return Key(_clipName, _data._time);
 	}
 
+	/**
+	 * @brief Move the vertex to another time, keeping all its datas.
+	 * @warning The key changes, so the vertex descriptor map of the graph needs to be rebuilt.
+	 */
+	void shiftTime( const OfxTime offset );
+
 	const ProcessVertexData& getProcessData() const { return *_data._nodeData; }
 	ProcessVertexAtTimeData&       getProcessDataAtTime()       { return _data; }
 	const ProcessVertexAtTimeData& getProcessDataAtTime() const { return _data; }
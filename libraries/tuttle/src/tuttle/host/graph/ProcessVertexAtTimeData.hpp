@@ -5,6 +5,7 @@
 
 #include <tuttle/host/ofx/attribute/OfxhClipImage.hpp>
 #include <tuttle/host/ofx/OfxhCore.hpp>
+#include <tuttle/host/memory/IMemoryPool.hpp>
 
 #include <string>
 
@@ -49,6 +50,8 @@ public:
 		, _isFinalNode( false )
 		, _outDegree( 0 )
 		, _inDegree( 0 )
+		, _outputHash( 0 )
+		, _allocatedMemory( 0 )
 	{
 		_localInfos._nodes = 1; // local infos can contain only 1 node by definition...
 	}
@@ -59,6 +62,8 @@ public:
 		, _isFinalNode( false )
 		, _outDegree( 0 )
 		, _inDegree( 0 )
+		, _outputHash( 0 )
+		, _allocatedMemory( 0 )
 	{
 		_localInfos._nodes = 1; // local infos can contain only 1 node by definition...
 	}
@@ -82,6 +87,10 @@ public:
 		_inputsInfos = v._inputsInfos;
 		_globalInfos = v._globalInfos;
 
+		_outputHash = v._outputHash;
+		_cachedOutput = v._cachedOutput;
+		_allocatedMemory = v._allocatedMemory;
+
 		_apiImageEffect = v._apiImageEffect;
 		
 		return *this;
@@ -118,6 +127,10 @@ public:
 	ProcessVertexAtTimeInfo _inputsInfos;
 	ProcessVertexAtTimeInfo _globalInfos;
 
+	std::size_t _outputHash; ///< key of the output in the NodeOutputCache, 0 if the output is not cached
+	memory::IPoolDataPtr _cachedOutput; ///< output reused from a previous render, the node is not processed
+	std::size_t _allocatedMemory; ///< memory allocated in the MemoryPool for the outputs by the last process
+
 	/// @group API Specific datas
 	/// @{
 	/**
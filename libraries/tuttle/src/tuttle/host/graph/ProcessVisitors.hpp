@@ -2,8 +2,11 @@
 #define _TUTTLE_HOST_PROCESSVISITORS_HPP_
 
 #include "ProcessVertexData.hpp"
+#include "FrameOrderGate.hpp"
 
 #include <tuttle/host/memory/MemoryCache.hpp>
+#include <tuttle/host/RenderProfile.hpp>
+#include <tuttle/host/Core.hpp>
 
 #include <boost/graph/properties.hpp>
 #include <boost/graph/visitors.hpp>
@@ -185,7 +188,7 @@ public:
 		if( vertex.isFake() )
 			return;
 
-		const std::size_t localHash = vertex.getProcessNode().getLocalHashAtTime(_time);
+		const std::size_t localHash = vertex.getProcessNode().getLocalHashAtTime( vertex._data._time );
 
 		typedef std::map<VertexKey, std::size_t> InputsHash;
 		InputsHash inputsGlobalHash;
@@ -612,33 +615,6 @@ private:
 	TGraph& _graph;
 };
 
-template<class TGraph>
-class PreProcess2 : public boost::default_dfs_visitor
-{
-public:
-	typedef typename TGraph::GraphContainer GraphContainer;
-	typedef typename TGraph::Vertex Vertex;
-
-	PreProcess2( TGraph& graph )
-		: _graph( graph )
-	{}
-
-	template<class VertexDescriptor, class Graph>
-	void discover_vertex( VertexDescriptor v, Graph& g )
-	{
-		Vertex& vertex = _graph.instance( v );
-
-		TUTTLE_LOG_TRACE( "[Preprocess 2] discover vertex " << vertex );
-		if( vertex.isFake() )
-			return;
-
-		vertex.getProcessNode().preProcess2_reverse( vertex.getProcessDataAtTime() );
-	}
-
-private:
-	TGraph& _graph;
-};
-
 template<class TGraph>
 class OptimizeGraph : public boost::default_dfs_visitor
 {
@@ -696,6 +672,30 @@ private:
 	TGraph& _graph;
 };
 
+/**
+ * @brief Collect vertices in the process order.
+ * Only vertices reachable from the root vertex are collected.
+ */
+template<class TGraph>
+class CollectVertices : public boost::default_dfs_visitor
+{
+public:
+	typedef typename TGraph::vertex_descriptor vertex_descriptor;
+
+	CollectVertices( std::vector<vertex_descriptor>& vertices )
+		: _vertices( vertices )
+	{}
+
+	template<class VertexDescriptor, class Graph>
+	void finish_vertex( VertexDescriptor v, Graph& g )
+	{
+		_vertices.push_back( v );
+	}
+
+private:
+	std::vector<vertex_descriptor>& _vertices;
+};
+
 template<class TGraph>
 class Process : public boost::default_dfs_visitor
 {
@@ -707,6 +707,9 @@ public:
 		: _graph( graph )
 		, _cache( cache )
 		, _result( NULL )
+		, _gate( NULL )
+		, _frameIndex( 0 )
+		, _profile( NULL )
 	{
 	}
 	
@@ -714,6 +717,9 @@ public:
 		: _graph( graph )
 		, _cache( cache )
 		, _result( &result )
+		, _gate( NULL )
+		, _frameIndex( 0 )
+		, _profile( NULL )
 	{
 	}
 	
@@ -724,27 +730,78 @@ public:
 	{
 		_result = &result;
 	}
+	
+	/**
+	 * Wait for the previous frames on the nodes declared in @p gate.
+	 * Used when multiple frames are processed concurrently.
+	 */
+	void setFrameOrderGate( FrameOrderGate& gate, const std::size_t frameIndex )
+	{
+		_gate = &gate;
+		_frameIndex = frameIndex;
+	}
+
+	/**
+	 * Record the process of each node in @p profile.
+	 */
+	void setRenderProfile( RenderProfile& profile )
+	{
+		_profile = &profile;
+	}
 
 	template<class VertexDescriptor, class Graph>
 	void finish_vertex( VertexDescriptor v, Graph& g )
 	{
 		Vertex& vertex = _graph.instance( v );
 		TUTTLE_LOG_TRACE( "[Process] finish_vertex " << vertex );
+		_cumulativeTime += processVertex( vertex );
+		TUTTLE_LOG_TRACE( "[Process] cumulative time: " << _cumulativeTime );
+	}
 
+	/**
+	 * @brief Process one node, all its inputs need to be processed.
+	 * @return the time spent in the node process
+	 * @remark Thread safe, used to process multiple vertices concurrently (see ProcessScheduler).
+	 */
+	boost::posix_time::time_duration processVertex( Vertex& vertex ) const
+	{
 		// do nothing on the empty output node
 		// it's just a link to final nodes
 		if( vertex.isFake() )
-			return;
+			return boost::posix_time::time_duration();
 
 		// check if abort ?
 
 		// launch the process
+		const FrameOrderGate::Resource resource = _gate ? getFrameOrderResource( vertex.getProcessNode() ) : NULL;
+		if( resource )
+		{
+			RenderProfile::Event waitEvent;
+			if( _profile )
+				waitEvent = _profile->beginEvent( "wait", vertex._clipName, vertex._data._time );
+			_gate->acquire( resource, _frameIndex );
+			if( _profile )
+				_profile->endEvent( waitEvent );
+		}
+		RenderProfile::Event processEvent;
+		if( _profile )
+		{
+			processEvent = _profile->beginEvent( "process", vertex._clipName, vertex._data._time );
+			processEvent._cacheHit = vertex.getProcessDataAtTime()._cachedOutput.get() != NULL;
+			processEvent._nbThreads = core().getThreadPool().getThreadBudget();
+		}
 		boost::posix_time::ptime t1(boost::posix_time::microsec_clock::local_time());
 		vertex.getProcessNode().process( vertex.getProcessDataAtTime() );
 		boost::posix_time::ptime t2(boost::posix_time::microsec_clock::local_time());
-		_cumulativeTime += t2 - t1;
+		if( _profile )
+		{
+			processEvent._allocatedMemory = vertex.getProcessDataAtTime()._allocatedMemory;
+			_profile->endEvent( processEvent );
+		}
+		if( resource )
+			_gate->release( resource, _frameIndex );
 		
-		TUTTLE_LOG_TRACE( "[Process] " << quotes(vertex._name) << " " << vertex._data._time << " took: " << t2 - t1 << " (cumul: " << _cumulativeTime << ")" << vertex );
+		TUTTLE_LOG_TRACE( "[Process] " << quotes(vertex._name) << " " << vertex._data._time << " took: " << t2 - t1 << vertex );
 		
 		if( _result && vertex.getProcessDataAtTime()._isFinalNode )
 		{
@@ -759,12 +816,16 @@ public:
 			}
 			_result->put( vertex._clipName, vertex._data._time, img );
 		}
+		return t2 - t1;
 	}
 
 private:
 	TGraph& _graph;
 	memory::IMemoryCache& _cache;
 	memory::IMemoryCache* _result;
+	FrameOrderGate* _gate;
+	std::size_t _frameIndex;
+	RenderProfile* _profile;
 	boost::posix_time::time_duration _cumulativeTime;
 };
 
@@ -0,0 +1,75 @@
+#include "BufferAllocator.hpp"
+
+#include <tuttle/common/system/system.hpp>
+#include <tuttle/common/utils/global.hpp>
+
+#include <new>
+#include <cstdlib>
+
+#ifdef __WINDOWS__
+ #include <malloc.h>
+#else
+ #include <sys/mman.h>
+#endif
+
+namespace tuttle {
+namespace host {
+namespace memory {
+
+namespace {
+/// The size of a huge page on x86.
+const std::size_t s_mappingThreshold = 2 * 1024 * 1024;
+}
+
+std::size_t getBufferMappingThreshold()
+{
+	return s_mappingThreshold;
+}
+
+char* allocateBuffer( const std::size_t size, const std::size_t alignment, const bool hugePages )
+{
+	// at least the alignment needed by all the C types
+	const std::size_t realAlignment = alignment < sizeof( void* ) ? sizeof( void* ) : alignment;
+#ifdef __WINDOWS__
+	void* buffer = _aligned_malloc( size ? size : 1, realAlignment );
+	if( buffer == NULL )
+		throw std::bad_alloc();
+	return static_cast<char*>( buffer );
+#else
+	if( size >= s_mappingThreshold )
+	{
+		void* buffer = mmap( NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+		if( buffer == MAP_FAILED )
+			throw std::bad_alloc();
+	#ifdef MADV_HUGEPAGE
+		if( hugePages && madvise( buffer, size, MADV_HUGEPAGE ) != 0 )
+		{
+			TUTTLE_LOG_TRACE( "[Buffer Allocator] Transparent huge pages not available." );
+		}
+	#endif
+		return static_cast<char*>( buffer );
+	}
+	void* buffer = NULL;
+	if( posix_memalign( &buffer, realAlignment, size ? size : 1 ) != 0 )
+		throw std::bad_alloc();
+	return static_cast<char*>( buffer );
+#endif
+}
+
+void freeBuffer( char* buffer, const std::size_t size )
+{
+	if( buffer == NULL )
+		return;
+#ifdef __WINDOWS__
+	_aligned_free( buffer );
+#else
+	if( size >= s_mappingThreshold )
+		munmap( buffer, size );
+	else
+		std::free( buffer );
+#endif
+}
+
+}
+}
+}
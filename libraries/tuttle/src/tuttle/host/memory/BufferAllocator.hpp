@@ -0,0 +1,39 @@
+#ifndef _TUTTLE_HOST_BUFFERALLOCATOR_HPP_
+#define _TUTTLE_HOST_BUFFERALLOCATOR_HPP_
+
+#include <cstddef>
+
+namespace tuttle {
+namespace host {
+namespace memory {
+
+/**
+ * @brief Allocate the memory of the image buffers.
+ *
+ * Small buffers are aligned on @p alignment bytes.
+ * Big buffers (see getBufferMappingThreshold) are mapped directly from the
+ * system, so they are aligned on the page size and their pages are only
+ * zeroed by the system when they are used for the first time. With
+ * @p hugePages, the system is asked to use transparent huge pages for them,
+ * to reduce the TLB misses on big images.
+ *
+ * @throw std::bad_alloc
+ */
+char* allocateBuffer( const std::size_t size, const std::size_t alignment, const bool hugePages );
+
+/**
+ * @brief Release a buffer allocated with allocateBuffer.
+ * @param size the size given to allocateBuffer
+ */
+void freeBuffer( char* buffer, const std::size_t size );
+
+/**
+ * @brief Size from which the buffers are mapped directly from the system.
+ */
+std::size_t getBufferMappingThreshold();
+
+}
+}
+}
+
+#endif
@@ -62,6 +62,7 @@ public:
 	virtual const std::string& getPluginName( const CACHE_ELEMENT& ) const                                  = 0;
 	virtual bool               remove( const CACHE_ELEMENT& )                                               = 0;
 	virtual void               clearUnused()                                                                = 0;
+	virtual std::size_t        clearUnused( const std::size_t size )                                        = 0;
 	virtual void               clearAll()                                                                   = 0;
 	virtual std::ostream&      outputStream( std::ostream& os ) const                                       = 0;
 	friend std::ostream& operator<<( std::ostream& os, const This& v );
@@ -4,6 +4,8 @@
 #include <boost/foreach.hpp>
 
 #include <functional>
+#include <algorithm>
+#include <vector>
 
 namespace tuttle {
 namespace host {
@@ -12,9 +14,11 @@ namespace memory {
 namespace  {
 
 /// Check if the cache element is kept in the cache, but is not required by someone else.
+/// A plugin can keep an image after its render (e.g. a writer which writes in background).
 bool isUnused( const CACHE_ELEMENT& cacheElement )
 {
-    return cacheElement->getReferenceCount( ofx::imageEffect::OfxhImage::eReferenceOwnerHost ) < 1;
+    return cacheElement->getReferenceCount( ofx::imageEffect::OfxhImage::eReferenceOwnerHost ) < 1 &&
+           cacheElement->getReferenceCount( ofx::imageEffect::OfxhImage::eReferenceOwnerPlugin ) < 1;
 }
 
 /// Functor to get the smallest unused element in cache
@@ -56,6 +60,16 @@ struct UnusedDataFitSize : public std::unary_function<CACHE_ELEMENT*, void>
 		CACHE_ELEMENT _pBestMatch;
 };
 
+/// Sort elements by last access
+struct LessAccess
+{
+	template<class Pair>
+	bool operator()( const Pair& a, const Pair& b ) const
+	{
+		return a.first < b.first;
+	}
+};
+
 }
 
 MemoryCache& MemoryCache::operator=( const MemoryCache& cache )
@@ -65,13 +79,17 @@ MemoryCache& MemoryCache::operator=( const MemoryCache& cache )
 	boost::mutex::scoped_lock lockerMap1( cache._mutexMap );
 	boost::mutex::scoped_lock lockerMap2( _mutexMap );
 	_map = cache._map;
+	_lastAccess = cache._lastAccess;
+	_accessCount = cache._accessCount;
 	return *this;
 }
 
 void MemoryCache::put( const std::string& identifier, const double time, CACHE_ELEMENT pData )
 {
 	boost::mutex::scoped_lock lockerMap( _mutexMap );
-	_map[Key( identifier, time )] = pData;
+	const Key key( identifier, time );
+	_map[key] = pData;
+	_lastAccess[key] = ++_accessCount;
 }
 
 CACHE_ELEMENT MemoryCache::get( const std::string& identifier, const double time ) const
@@ -81,6 +99,7 @@ CACHE_ELEMENT MemoryCache::get( const std::string& identifier, const double time
 
 	if( itr == _map.end() )
 		return CACHE_ELEMENT();
+	_lastAccess[itr->first] = ++_accessCount;
 	return itr->second;
 }
 
@@ -176,6 +195,7 @@ bool MemoryCache::remove( const CACHE_ELEMENT& pData )
 
 	if( itr == _map.end() )
 		return false;
+	_lastAccess.erase( itr->first );
 	_map.erase( itr );
 	return true;
 }
@@ -187,6 +207,7 @@ void MemoryCache::clearUnused()
 	{
 		if( isUnused( it->second ) )
 		{
+			_lastAccess.erase( it->first );
 			_map.erase( it++ ); // post-increment here, increments 'it' and returns a copy of the original 'it' to be used by erase()
 		}
 		else
@@ -196,11 +217,37 @@ void MemoryCache::clearUnused()
 	}
 }
 
+std::size_t MemoryCache::clearUnused( const std::size_t size )
+{
+	boost::mutex::scoped_lock lockerMap( _mutexMap );
+	// unused elements sorted by last access
+	std::vector<std::pair<std::size_t, MAP::iterator> > unusedElements;
+	for( MAP::iterator it = _map.begin(); it != _map.end(); ++it )
+	{
+		if( isUnused( it->second ) )
+			unusedElements.push_back( std::make_pair( _lastAccess[it->first], it ) );
+	}
+	std::sort( unusedElements.begin(), unusedElements.end(), LessAccess() );
+
+	std::size_t releasedSize = 0;
+	for( std::size_t i = 0; i < unusedElements.size() && releasedSize < size; ++i )
+	{
+		const MAP::iterator it = unusedElements[i].second;
+		if( it->second->getPoolData() )
+			releasedSize += it->second->getPoolData()->reservedSize();
+		_lastAccess.erase( it->first );
+		_map.erase( it );
+	}
+	TUTTLE_LOG_TRACE( "[Memory Cache] released " << releasedSize << " bytes (" << size << " bytes requested)" );
+	return releasedSize;
+}
+
 void MemoryCache::clearAll()
 {
 	TUTTLE_LOG_DEBUG( " - MEMORYCACHE::CLEARALL - " );
 	boost::mutex::scoped_lock lockerMap( _mutexMap );
 	_map.clear();
+	_lastAccess.clear();
 }
 
 std::ostream& operator<<( std::ostream& os, const MemoryCache& v )
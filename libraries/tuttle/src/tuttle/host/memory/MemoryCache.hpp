@@ -20,7 +20,7 @@ public:
 	{
 		*this = other;
 	}
-	MemoryCache() {}
+	MemoryCache() : _accessCount( 0 ) {}
 	~MemoryCache() {}
 
 	MemoryCache& operator=( const MemoryCache& cache );
@@ -29,6 +29,9 @@ private:
 	typedef boost::unordered_map<Key, CACHE_ELEMENT, KeyHash> MAP;
 	//	typedef std::map<Key, CACHE_ELEMENT> MAP;
 	MAP _map;
+	typedef boost::unordered_map<Key, std::size_t, KeyHash> ACCESS_MAP;
+	mutable ACCESS_MAP _lastAccess; ///< last access of each element, to release the least recently used first
+	mutable std::size_t _accessCount;
 	mutable boost::mutex _mutexMap;  ///< Mutex for cache data map.
 
 	MAP::const_iterator getIteratorForValue( const CACHE_ELEMENT& ) const;
@@ -46,6 +49,11 @@ public:
 	const std::string& getPluginName( const CACHE_ELEMENT& ) const;
 	bool               remove( const CACHE_ELEMENT& );
 	void               clearUnused();
+	/**
+	 * @brief Remove the least recently used unused elements until their buffers reach @p size bytes.
+	 * @return the size of the buffers of the removed elements.
+	 */
+	std::size_t        clearUnused( const std::size_t size );
 	void               clearAll();
 	std::ostream& outputStream( std::ostream& os ) const
 	{
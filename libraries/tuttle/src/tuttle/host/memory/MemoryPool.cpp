@@ -1,12 +1,15 @@
 #include "MemoryPool.hpp"
+#include "BufferAllocator.hpp"
 
 #include <tuttle/common/utils/global.hpp>
 #include <tuttle/common/system/memoryInfo.hpp>
 #include <tuttle/host/Core.hpp>
+#include <tuttle/common/atomic.hpp>
 
 #include <boost/throw_exception.hpp>
 
 #include <algorithm>
+#include <cassert>
 
 namespace tuttle {
 namespace host {
@@ -22,18 +25,20 @@ private:
 	friend class MemoryPool;
 
 public:
-	PoolData( IPool& pool, const std::size_t size )
+	PoolData( IPool& pool, const std::size_t size, const std::size_t alignment, const bool hugePages )
 		: _pool( pool )
 		, _id( _count++ )
 		, _reservedSize( size )
 		, _size( size )
-		, _pData( new char[size] )
+		, _pData( allocateBuffer( size, alignment, hugePages ) )
 		, _refCount( 0 )
+		, _state( eDataStateNew )
+		, _wastedSize( 0 )
 	{}
 
 	~PoolData()
 	{
-		delete [] _pData;
+		freeBuffer( _pData, _reservedSize );
 	}
 
 public:
@@ -57,13 +62,27 @@ public:
 	}
 
 private:
+	enum EDataState
+	{
+		eDataStateNew, ///< not yet known by the pool
+		eDataStateUsed,
+		eDataStateUnused
+	};
+
 	static std::size_t _count; ///< unique id generator
 	IPool& _pool; ///< ref to the owner pool
 	const std::size_t _id; ///< unique id to identify one memory data
 	const std::size_t _reservedSize; ///< memory allocated
 	std::size_t _size; ///< memory requested
 	char* const _pData; ///< own the data
-	int _refCount; ///< counter on clients currently using this data
+	boost::atomic<int> _refCount; ///< counter on clients currently using this data, shared between the render threads
+
+	// data managed by the pool
+	EDataState _state;
+	std::size_t _wastedSize; ///< wasted size accounted by the pool while the data is used
+	MemoryPool::DataSizeIndex::iterator _unusedIt; ///< position in the unused datas index
+	MemoryPool::DataLruList::iterator _lruIt; ///< position in the unused datas release order
+	MemoryPool::DataOwnerList::iterator _ownerIt; ///< position in the pool owner list
 };
 
 void intrusive_ptr_add_ref( IPoolData* pData )
@@ -80,18 +99,23 @@ std::size_t PoolData::_count = 0;
 
 void PoolData::addRef()
 {
-	if( ++_refCount == 1 )
+	if( _refCount.fetch_add( 1, boost::memory_order_relaxed ) == 0 )
 		_pool.referenced( this );
 }
 
 void PoolData::release()
 {
-	if( --_refCount == 0 )
+	// only the 1 to 0 transition gives the data back to the pool
+	if( _refCount.fetch_sub( 1, boost::memory_order_acq_rel ) == 1 )
 		_pool.released( this );
 }
 
 MemoryPool::MemoryPool( const std::size_t maxSize )
-	: _memoryAuthorized( maxSize )
+	: _usedMemorySize( 0 )
+	, _unusedMemorySize( 0 )
+	, _wastedMemorySize( 0 )
+	, _peakUsedMemorySize( 0 )
+	, _memoryAuthorized( maxSize )
 {}
 
 MemoryPool::~MemoryPool()
@@ -102,71 +126,57 @@ MemoryPool::~MemoryPool()
 	}
 }
 
-void MemoryPool::referenced( PoolData* pData )
+void MemoryPool::setUsed( PoolData* pData )
 {
-	boost::mutex::scoped_lock locker( _mutex );
-	DataList::iterator it = _dataUnused.find( pData );
-
-	if( it != _dataUnused.end() )
-	{
-		_dataUnused.erase( it );
-	}
-	else // a really new data
+	switch( pData->_state )
 	{
-		_allDatas.push_back( pData );
-		_dataMap[pData->data()] = pData;
+		case PoolData::eDataStateUsed:
+			return;
+		case PoolData::eDataStateUnused:
+			_dataUnused.erase( pData->_unusedIt );
+			_dataUnusedLru.erase( pData->_lruIt );
+			_unusedMemorySize -= pData->reservedSize();
+			break;
+		case PoolData::eDataStateNew: // a really new data
+			_allDatas.push_back( pData );
+			pData->_ownerIt = --_allDatas.end();
+			_dataMap[pData->data()] = pData;
+			break;
 	}
+	pData->_state = PoolData::eDataStateUsed;
+	pData->_wastedSize = pData->reservedSize() - pData->size();
 	_dataUsed.insert( pData );
+	_usedMemorySize += pData->reservedSize();
+	_wastedMemorySize += pData->_wastedSize;
+	_peakUsedMemorySize = std::max( _peakUsedMemorySize, _usedMemorySize );
 }
 
-void MemoryPool::released( PoolData* pData )
+void MemoryPool::referenced( PoolData* pData )
 {
 	boost::mutex::scoped_lock locker( _mutex );
-	_dataUsed.erase( pData );
-	_dataUnused.insert( pData );
+	// the data may already be used if it was taken by getOneAvailableData
+	setUsed( pData );
 }
 
-namespace  {
-
-/// Functor to get the smallest element in pool
-struct DataFitSize : public std::unary_function<PoolData*, void>
+void MemoryPool::released( PoolData* pData )
 {
-	DataFitSize( std::size_t size )
-		: _sizeNeeded( size )
-		, _bestMatchDiff( ULONG_MAX )
-		, _pBestMatch( NULL )
-	{}
-
-	void operator()( PoolData* pData )
-	{
-		const std::size_t dataSize = pData->reservedSize();
-		
-		// Check minimum amount of memory
-		if( _sizeNeeded > dataSize )
-			return;
-		// Do not reuse too big buffers
-		if( dataSize > _maxBufferRatio * _sizeNeeded )
-			return;
-		const std::size_t diff = dataSize - _sizeNeeded;
-		if( diff >= _bestMatchDiff )
-			return;
-		_bestMatchDiff = diff;
-		_pBestMatch    = pData;
-	}
+	boost::mutex::scoped_lock locker( _mutex );
+	// another thread may have taken a new reference since the release
+	if( pData->_state != PoolData::eDataStateUsed || pData->_refCount.load( boost::memory_order_acquire ) != 0 )
+		return;
+	_dataUsed.erase( pData );
+	_usedMemorySize -= pData->reservedSize();
+	_wastedMemorySize -= pData->_wastedSize;
 
-	PoolData* bestMatch()
-	{
-		return _pBestMatch;
-	}
+	pData->_state = PoolData::eDataStateUnused;
+	pData->_unusedIt = _dataUnused.insert( DataSizeIndex::value_type( pData->reservedSize(), pData ) );
+	pData->_lruIt = _dataUnusedLru.insert( _dataUnusedLru.end(), pData );
+	_unusedMemorySize += pData->reservedSize();
+}
 
-	private:
-		static const double _maxBufferRatio;  //< max ratio between used and unused part of the buffer
-		const std::size_t _sizeNeeded;
-		std::size_t _bestMatchDiff;
-		PoolData* _pBestMatch;
-};
+namespace  {
 
-const double DataFitSize::_maxBufferRatio = 2.0;
+const double maxBufferRatio = 2.0; //< max ratio between used and unused part of the buffer
 
 }
 
@@ -177,7 +187,6 @@ IPoolDataPtr MemoryPool::allocate( const std::size_t size )
 	if( pData != NULL )
 	{
 		TUTTLE_LOG_TRACE("[Memory Pool] Reuse a buffer available in the MemoryPool");
-		pData->setSize( size );
 		return pData;
 	}
 
@@ -193,7 +202,6 @@ IPoolDataPtr MemoryPool::allocate( const std::size_t size )
 		if( pData != NULL )
 		{
 			TUTTLE_LOG_TRACE("[Memory Pool] Reuse a buffer available in the MemoryPool");
-			pData->setSize( size );
 			return pData;
 		}
 	}
@@ -204,17 +212,16 @@ IPoolDataPtr MemoryPool::allocate( const std::size_t size )
 	{
 		// Try to release elements from the MemoryCache (make them available to the MemoryPool)
 		TUTTLE_LOG_TRACE("[Memory Pool] Release elements from the MemoryCache");
-		memoryCache.clearUnused();
+		memoryCache.clearUnused( size - availableSize );
 
 		availableSize = getAvailableMemorySize();
 		if( size > availableSize )
 		{
-			// Release elements from the MemoryPool (make them available to the OS)
-			TUTTLE_LOG_TRACE("[Memory Pool] Release elements from the MemoryPool");
-			clear();
+			// Release node outputs kept between renders
+			TUTTLE_LOG_TRACE("[Memory Pool] Release elements from the NodeOutputCache");
+			core().getNodeOutputCache().clear( size - availableSize );
+			availableSize = getAvailableMemorySize();
 		}
-
-		availableSize = getAvailableMemorySize();
 		if( size > availableSize )
 		{
 			std::stringstream s;
@@ -223,9 +230,22 @@ IPoolDataPtr MemoryPool::allocate( const std::size_t size )
 		}
 	}
 
+	const std::size_t allocatedSize = getAllocatedMemorySize();
+	if( allocatedSize + size > _memoryAuthorized )
+	{
+		// Release elements from the MemoryPool (make them available to the OS)
+		TUTTLE_LOG_TRACE("[Memory Pool] Release elements from the MemoryPool");
+		clear( allocatedSize + size - _memoryAuthorized );
+	}
+
 	// Allocate a new buffer in MemoryPool
 	TUTTLE_LOG_TRACE( "[Memory Pool] allocate " << size << " bytes" );
-	return new PoolData( *this, size );
+	const Preferences& preferences = core().getPreferences();
+	{
+		boost::mutex::scoped_lock locker( _mutex ); // for the unique id generator
+		pData = new PoolData( *this, size, preferences.getBufferAlignment(), preferences.getUseHugePages() );
+	}
+	return pData;
 }
 
 std::size_t MemoryPool::updateMemoryAuthorizedWithRAM()
@@ -235,35 +255,22 @@ std::size_t MemoryPool::updateMemoryAuthorizedWithRAM()
 	return _memoryAuthorized;
 }
 
-namespace  {
-
-std::size_t accumulateReservedSize( const std::size_t& sum, const IPoolData* pData )
-{
-	return sum + pData->reservedSize();
-}
-
-std::size_t accumulateWastedSize( const std::size_t& sum, const IPoolData* pData )
-{
-	return sum + ( pData->reservedSize() - pData->size() );
-}
-
-}
-
 std::size_t MemoryPool::getUsedMemorySize() const
 {
 	boost::mutex::scoped_lock locker( _mutex );
-	return std::accumulate( _dataUsed.begin(), _dataUsed.end(), 0, &accumulateReservedSize );
+	return _usedMemorySize;
 }
 
 std::size_t MemoryPool::getAllocatedAndUnusedMemorySize() const
 {
 	boost::mutex::scoped_lock locker( _mutex );
-	return std::accumulate( _dataUnused.begin(), _dataUnused.end(), 0, &accumulateReservedSize );
+	return _unusedMemorySize;
 }
 
 std::size_t MemoryPool::getAllocatedMemorySize() const
 {
-	return getUsedMemorySize() + getAllocatedAndUnusedMemorySize();
+	boost::mutex::scoped_lock locker( _mutex );
+	return _usedMemorySize + _unusedMemorySize;
 }
 
 std::size_t MemoryPool::getMaxMemorySize() const
@@ -273,46 +280,95 @@ std::size_t MemoryPool::getMaxMemorySize() const
 
 std::size_t MemoryPool::getAvailableMemorySize() const
 {
-	return getMaxMemorySize() - getUsedMemorySize();
+	const std::size_t usedMemorySize = getUsedMemorySize();
+	if( usedMemorySize > _memoryAuthorized )
+		return 0;
+	return _memoryAuthorized - usedMemorySize;
 }
 
 std::size_t MemoryPool::getWastedMemorySize() const
 {
 	boost::mutex::scoped_lock locker( _mutex );
-	return std::accumulate( _dataUsed.begin(), _dataUsed.end(), 0, std::ptr_fun( &accumulateWastedSize ) );
+	return _wastedMemorySize;
+}
+
+std::size_t MemoryPool::getPeakUsedMemorySize() const
+{
+	boost::mutex::scoped_lock locker( _mutex );
+	return _peakUsedMemorySize;
+}
+
+void MemoryPool::resetPeakUsedMemorySize()
+{
+	boost::mutex::scoped_lock locker( _mutex );
+	_peakUsedMemorySize = _usedMemorySize;
 }
 
 std::size_t MemoryPool::getDataUsedSize() const
 {
+	boost::mutex::scoped_lock locker( _mutex );
 	return _dataUsed.size();
 }
 
 std::size_t MemoryPool::getDataUnusedSize() const
 {
+	boost::mutex::scoped_lock locker( _mutex );
 	return _dataUnused.size();
 }
 
 PoolData* MemoryPool::getOneAvailableData( const size_t size )
 {
 	boost::mutex::scoped_lock locker( _mutex );
-	return std::for_each( _dataUnused.begin(), _dataUnused.end(), DataFitSize( size ) ).bestMatch();
+	// smallest buffer which is big enough
+	DataSizeIndex::iterator it = _dataUnused.lower_bound( size );
+	if( it == _dataUnused.end() )
+		return NULL;
+	// Do not reuse too big buffers
+	if( it->first > maxBufferRatio * size )
+		return NULL;
+	PoolData* pData = it->second;
+	pData->setSize( size );
+	setUsed( pData );
+	return pData;
+}
+
+void MemoryPool::deleteUnusedData( PoolData* pData )
+{
+	_dataUnused.erase( pData->_unusedIt );
+	_dataUnusedLru.erase( pData->_lruIt );
+	_unusedMemorySize -= pData->reservedSize();
+	_dataMap.erase( pData->data() );
+	_allDatas.erase( pData->_ownerIt ); // delete the data
 }
 
 void MemoryPool::clear( std::size_t size )
 {
-	/// @todo tuttle
+	boost::mutex::scoped_lock locker( _mutex );
+	std::size_t releasedSize = 0;
+	while( releasedSize < size && ! _dataUnusedLru.empty() )
+	{
+		PoolData* pData = _dataUnusedLru.front();
+		releasedSize += pData->reservedSize();
+		deleteUnusedData( pData );
+	}
+	TUTTLE_LOG_TRACE( "[Memory Pool] released " << releasedSize << " bytes (" << size << " bytes requested)" );
 }
 
 void MemoryPool::clear()
 {
 	boost::mutex::scoped_lock locker( _mutex );
-	_dataUnused.clear();
+	while( ! _dataUnusedLru.empty() )
+	{
+		deleteUnusedData( _dataUnusedLru.front() );
+	}
 }
 
 void MemoryPool::clearOne()
 {
 	boost::mutex::scoped_lock locker( _mutex );
-	_dataUnused.erase( _dataUnused.begin() );
+	if( _dataUnusedLru.empty() )
+		return;
+	deleteUnusedData( _dataUnusedLru.front() );
 }
 
 std::ostream& operator<<( std::ostream& os, const MemoryPool& memoryPool )
@@ -326,6 +382,7 @@ std::ostream& operator<<( std::ostream& os, const MemoryPool& memoryPool )
 	os << "[Memory Pool] Max memory:            " << memoryPool.getMaxMemorySize() << " bytes\n";
 	os << "[Memory Pool] Available memory size: " << memoryPool.getAvailableMemorySize() << " bytes\n";
 	os << "[Memory Pool] Wasted memory:         " << memoryPool.getWastedMemorySize() << " bytes\n";
+	os << "[Memory Pool] Peak used memory:      " << memoryPool.getPeakUsedMemorySize() << " bytes\n";
 	return os;
 }
 
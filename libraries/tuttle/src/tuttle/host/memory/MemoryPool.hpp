@@ -10,9 +10,6 @@
 #include <map>
 #include <list>
 #include <sstream>
-#include <numeric>
-#include <functional>
-#include <climits>
 
 namespace tuttle {
 namespace host {
@@ -28,6 +25,13 @@ public:
 };
 
 /**
+ * @brief Pool of memory buffers.
+ *
+ * The unused buffers are indexed by size, so the best fit buffer is found in
+ * logarithmic time. They are also kept in their release order, so the memory
+ * is given back to the system from the least recently used buffers. Memory sizes are updated at each change of state of a
+ * buffer, so the accounting functions are in constant time.
+ *
  * @todo tuttle: virtual destructor or nothing in virtual
  */
 class MemoryPool : public IMemoryPool
@@ -52,24 +56,52 @@ public:
 	std::size_t getMaxMemorySize() const;
 	std::size_t getAvailableMemorySize() const;
 	std::size_t getWastedMemorySize() const;
+	/// @brief Maximum of the used memory since the creation or the last resetPeakUsedMemorySize.
+	std::size_t getPeakUsedMemorySize() const;
+	void resetPeakUsedMemorySize();
 
 	std::size_t getDataUsedSize() const;
 	std::size_t getDataUnusedSize() const;
 	
+	/**
+	 * @brief Get the smallest unused buffer which can contain @p size bytes.
+	 * The buffer is directly declared as used, so another thread can't take it.
+	 * @return NULL if there is no unused buffer of a good size.
+	 */
 	PoolData* getOneAvailableData( const size_t size );
 
+	/**
+	 * @brief Free the least recently used unused buffers until @p size bytes are released.
+	 */
 	void clear( std::size_t size );
 	void clear();
+	/// @brief Free the least recently used unused buffer.
 	void clearOne();
 
 	friend std::ostream& operator<<( std::ostream& os, const This& v );
 
 private:
+	/// the datas keep their position in the pool containers
+	friend class PoolData;
+
 	typedef boost::unordered_set<PoolData*> DataList;
-	boost::ptr_list<PoolData> _allDatas; // the owner
+	typedef std::multimap<std::size_t, PoolData*> DataSizeIndex; ///< unused datas sorted by reserved size
+	typedef std::list<PoolData*> DataLruList; ///< unused datas from the least recently used
+	typedef boost::ptr_list<PoolData> DataOwnerList;
+
+	void setUsed( PoolData* pData );
+	void deleteUnusedData( PoolData* pData );
+
+private:
+	DataOwnerList _allDatas; // the owner
 	std::map<char*, PoolData*> _dataMap;
 	DataList _dataUsed;
-	DataList _dataUnused;
+	DataSizeIndex _dataUnused;
+	DataLruList _dataUnusedLru;
+	std::size_t _usedMemorySize; ///< reserved size of the used datas
+	std::size_t _unusedMemorySize; ///< reserved size of the unused datas
+	std::size_t _wastedMemorySize; ///< memory reserved but not requested in the used datas
+	std::size_t _peakUsedMemorySize; ///< maximum of _usedMemorySize
 	std::size_t _memoryAuthorized;
 	mutable boost::mutex _mutex;
 };
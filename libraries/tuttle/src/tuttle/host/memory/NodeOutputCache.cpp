@@ -0,0 +1,129 @@
+#include "NodeOutputCache.hpp"
+
+#include <tuttle/common/utils/global.hpp>
+
+namespace tuttle {
+namespace host {
+namespace memory {
+
+namespace {
+
+bool operator==( const OfxRectD& a, const OfxRectD& b )
+{
+	return a.x1 == b.x1 && a.y1 == b.y1 && a.x2 == b.x2 && a.y2 == b.y2;
+}
+
+}
+
+NodeOutputCache::NodeOutputCache( const std::size_t maxSize )
+	: _memorySize( 0 )
+	, _maxMemorySize( maxSize )
+{}
+
+NodeOutputCache::~NodeOutputCache()
+{}
+
+void NodeOutputCache::setMaxMemorySize( const std::size_t maxSize )
+{
+	boost::mutex::scoped_lock locker( _mutex );
+	_maxMemorySize = maxSize;
+	while( _memorySize > _maxMemorySize )
+	{
+		removeOldest();
+	}
+}
+
+std::size_t NodeOutputCache::getMaxMemorySize() const
+{
+	boost::mutex::scoped_lock locker( _mutex );
+	return _maxMemorySize;
+}
+
+std::size_t NodeOutputCache::getMemorySize() const
+{
+	boost::mutex::scoped_lock locker( _mutex );
+	return _memorySize;
+}
+
+std::size_t NodeOutputCache::size() const
+{
+	boost::mutex::scoped_lock locker( _mutex );
+	return _elements.size();
+}
+
+void NodeOutputCache::put( const std::size_t hash, const OfxRectD& bounds, const IPoolDataPtr& data )
+{
+	boost::mutex::scoped_lock locker( _mutex );
+	if( ! data || data->reservedSize() > _maxMemorySize )
+		return;
+
+	Map::iterator it = _elements.find( hash );
+	if( it != _elements.end() )
+	{
+		_memorySize -= it->second._data->reservedSize();
+		_lru.erase( it->second._lruIt );
+		_elements.erase( it );
+	}
+	Element& element = _elements[hash];
+	element._data = data;
+	element._bounds = bounds;
+	element._lruIt = _lru.insert( _lru.end(), hash );
+	_memorySize += data->reservedSize();
+
+	while( _memorySize > _maxMemorySize )
+	{
+		removeOldest();
+	}
+}
+
+IPoolDataPtr NodeOutputCache::get( const std::size_t hash, const OfxRectD& bounds )
+{
+	boost::mutex::scoped_lock locker( _mutex );
+	Map::iterator it = _elements.find( hash );
+	if( it == _elements.end() || !( it->second._bounds == bounds ) )
+		return IPoolDataPtr();
+
+	// most recently used
+	_lru.splice( _lru.end(), _lru, it->second._lruIt );
+	return it->second._data;
+}
+
+void NodeOutputCache::removeOldest()
+{
+	Map::iterator it = _elements.find( _lru.front() );
+	_memorySize -= it->second._data->reservedSize();
+	_elements.erase( it );
+	_lru.pop_front();
+}
+
+std::size_t NodeOutputCache::clear( const std::size_t size )
+{
+	boost::mutex::scoped_lock locker( _mutex );
+	const std::size_t memorySize = _memorySize;
+	while( memorySize - _memorySize < size && ! _lru.empty() )
+	{
+		removeOldest();
+	}
+	TUTTLE_LOG_TRACE( "[Node Output Cache] released " << memorySize - _memorySize << " bytes (" << size << " bytes requested)" );
+	return memorySize - _memorySize;
+}
+
+void NodeOutputCache::clear()
+{
+	boost::mutex::scoped_lock locker( _mutex );
+	_elements.clear();
+	_lru.clear();
+	_memorySize = 0;
+}
+
+std::ostream& operator<<( std::ostream& os, const NodeOutputCache& v )
+{
+	os << "[Node Output Cache] nb buffers: " << v.size() << "\n";
+	os << "[Node Output Cache] memory:     " << v.getMemorySize() << " bytes\n";
+	os << "[Node Output Cache] max memory: " << v.getMaxMemorySize() << " bytes\n";
+	return os;
+}
+
+}
+}
+}
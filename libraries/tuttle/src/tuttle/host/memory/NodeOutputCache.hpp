@@ -0,0 +1,102 @@
+#ifndef _TUTTLE_HOST_CORE_NODEOUTPUTCACHE_HPP_
+#define _TUTTLE_HOST_CORE_NODEOUTPUTCACHE_HPP_
+
+#include "IMemoryPool.hpp"
+
+#include <ofxCore.h>
+
+#include <boost/unordered_map.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <list>
+#include <cstddef>
+#include <ostream>
+
+namespace tuttle {
+namespace host {
+namespace memory {
+
+/**
+ * @brief Node output buffers kept between renders.
+ *
+ * The buffers are indexed by the global hash of the node at time (hash of
+ * the node and of all its input nodes). So if a graph is rendered again with
+ * the same parameters on a part of the graph, the outputs of this part are
+ * reused without processing the corresponding nodes.
+ *
+ * The cache is limited by a memory size. The least recently used buffers are
+ * released first. A max memory size of 0 disables the cache.
+ *
+ * @warning The hash of a node doesn't contain external datas (like the
+ *          content of the files read by a reader), so the cache needs to be
+ *          cleared if these datas change.
+ */
+class NodeOutputCache
+{
+public:
+	typedef NodeOutputCache This;
+
+public:
+	NodeOutputCache( const std::size_t maxSize = 0 );
+	~NodeOutputCache();
+
+	/// @brief Set the max memory size used by the cache, 0 disables the cache.
+	void setMaxMemorySize( const std::size_t maxSize );
+	std::size_t getMaxMemorySize() const;
+	bool isEnabled() const { return getMaxMemorySize() != 0; }
+
+	/// @brief Memory size of all the buffers in the cache.
+	std::size_t getMemorySize() const;
+	std::size_t size() const;
+
+	/**
+	 * @brief Keep the output of a node.
+	 * @param hash global hash of the node at time
+	 * @param bounds region of the image contained in the buffer
+	 */
+	void put( const std::size_t hash, const OfxRectD& bounds, const IPoolDataPtr& data );
+
+	/**
+	 * @brief Get the buffer of a node output computed with the same hash and bounds.
+	 * @return an empty pointer if there is no such buffer in the cache
+	 */
+	IPoolDataPtr get( const std::size_t hash, const OfxRectD& bounds );
+
+	/**
+	 * @brief Remove the least recently used buffers until @p size bytes are released.
+	 * @return the memory size released.
+	 */
+	std::size_t clear( const std::size_t size );
+	void clear();
+
+	friend std::ostream& operator<<( std::ostream& os, const This& v );
+
+private:
+	typedef std::list<std::size_t> LruList; ///< hashes from the least recently used
+	struct Element
+	{
+		IPoolDataPtr _data;
+		OfxRectD _bounds;
+		LruList::iterator _lruIt;
+	};
+	typedef boost::unordered_map<std::size_t, Element> Map;
+
+	void removeOldest();
+
+private:
+	Map _elements;
+	LruList _lru;
+	std::size_t _memorySize;
+	std::size_t _maxMemorySize;
+	mutable boost::mutex _mutex;
+};
+
+#ifndef SWIG
+std::ostream& operator<<( std::ostream& os, const NodeOutputCache& v );
+#endif
+
+}
+}
+}
+
+#endif
@@ -0,0 +1,17 @@
+%include <tuttle/host/global.i>
+
+%{
+#include <tuttle/host/memory/NodeOutputCache.hpp>
+%}
+
+%include <tuttle/host/memory/NodeOutputCache.hpp>
+
+%extend tuttle::host::memory::NodeOutputCache
+{
+	std::string __str__() const
+	{
+		std::stringstream s;
+		s << *self;
+		return s.str();
+	}
+}
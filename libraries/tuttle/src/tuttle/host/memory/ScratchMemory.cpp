@@ -0,0 +1,140 @@
+#include "ScratchMemory.hpp"
+#include "BufferAllocator.hpp"
+#include "IMemoryPool.hpp"
+
+#include <tuttle/host/Core.hpp>
+
+#include <boost/thread/tss.hpp>
+
+#include <vector>
+
+namespace tuttle {
+namespace host {
+namespace memory {
+
+namespace {
+
+/// Space before each buffer, keeps the buffers aligned on 64 bytes.
+const std::size_t s_headerSize = 64;
+/// Size classes of the small buffers: 64 << i bytes.
+const std::size_t s_minSmallSize = 64;
+const std::size_t s_nbSizeClasses = 11;
+const std::size_t s_poolThreshold = s_minSmallSize << ( s_nbSizeClasses - 1 );
+/// Memory kept for each size class in each arena.
+const std::size_t s_maxArenaBytesPerClass = 256 * 1024;
+
+struct ScratchHeader
+{
+	IPoolData* _poolData; ///< buffer of the MemoryPool, NULL for small buffers
+	std::size_t _sizeClass;
+};
+
+std::size_t getClassSize( const std::size_t sizeClass )
+{
+	return s_minSmallSize << sizeClass;
+}
+
+/**
+ * @brief Free small buffers of a thread, by size class.
+ */
+class ScratchArena
+{
+public:
+	~ScratchArena()
+	{
+		for( std::size_t i = 0; i < s_nbSizeClasses; ++i )
+		{
+			for( std::size_t j = 0; j < _freeBlocks[i].size(); ++j )
+			{
+				freeBuffer( _freeBlocks[i][j], s_headerSize + getClassSize( i ) );
+			}
+		}
+	}
+
+	char* pop( const std::size_t sizeClass )
+	{
+		std::vector<char*>& blocks = _freeBlocks[sizeClass];
+		if( blocks.empty() )
+			return NULL;
+		char* block = blocks.back();
+		blocks.pop_back();
+		return block;
+	}
+
+	/// @return false if the arena is full, the block has to be released
+	bool push( char* block, const std::size_t sizeClass )
+	{
+		std::vector<char*>& blocks = _freeBlocks[sizeClass];
+		if( ( blocks.size() + 1 ) * getClassSize( sizeClass ) > s_maxArenaBytesPerClass && ! blocks.empty() )
+			return false;
+		blocks.push_back( block );
+		return true;
+	}
+
+private:
+	std::vector<char*> _freeBlocks[s_nbSizeClasses];
+};
+
+boost::thread_specific_ptr<ScratchArena> currentArena;
+
+ScratchArena& getArena()
+{
+	if( currentArena.get() == NULL )
+		currentArena.reset( new ScratchArena() );
+	return *currentArena;
+}
+
+}
+
+std::size_t getScratchPoolThreshold()
+{
+	return s_poolThreshold;
+}
+
+char* allocateScratch( const std::size_t size )
+{
+	char* block = NULL;
+	ScratchHeader header;
+	if( size > s_poolThreshold )
+	{
+		IPoolDataPtr data = core().getMemoryPool().allocate( s_headerSize + size );
+		// the reference is released by freeScratch
+		intrusive_ptr_add_ref( data.get() );
+		block = data->data();
+		header._poolData = data.get();
+		header._sizeClass = 0;
+	}
+	else
+	{
+		std::size_t sizeClass = 0;
+		while( getClassSize( sizeClass ) < size )
+			++sizeClass;
+		block = getArena().pop( sizeClass );
+		if( block == NULL )
+			block = allocateBuffer( s_headerSize + getClassSize( sizeClass ), s_headerSize, false );
+		header._poolData = NULL;
+		header._sizeClass = sizeClass;
+	}
+	*reinterpret_cast<ScratchHeader*>( block ) = header;
+	return block + s_headerSize;
+}
+
+void freeScratch( char* buffer )
+{
+	if( buffer == NULL )
+		return;
+	char* block = buffer - s_headerSize;
+	const ScratchHeader& header = *reinterpret_cast<const ScratchHeader*>( block );
+	if( header._poolData )
+	{
+		intrusive_ptr_release( header._poolData );
+		return;
+	}
+	const std::size_t sizeClass = header._sizeClass;
+	if( ! getArena().push( block, sizeClass ) )
+		freeBuffer( block, s_headerSize + getClassSize( sizeClass ) );
+}
+
+}
+}
+}
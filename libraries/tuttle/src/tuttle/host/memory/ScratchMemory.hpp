@@ -0,0 +1,36 @@
+#ifndef _TUTTLE_HOST_SCRATCHMEMORY_HPP_
+#define _TUTTLE_HOST_SCRATCHMEMORY_HPP_
+
+#include <cstddef>
+
+namespace tuttle {
+namespace host {
+namespace memory {
+
+/**
+ * @brief Allocate a temporary buffer for a plugin (OFX memory suites).
+ *
+ * Big buffers come from the Core MemoryPool, so they are counted in the
+ * memory used by the host and reused between frames.
+ * Small buffers come from an arena owned by the calling thread, to avoid
+ * the MemoryPool lock on each allocation.
+ *
+ * @throw std::bad_alloc, std::length_error if the MemoryPool is full
+ */
+char* allocateScratch( const std::size_t size );
+
+/**
+ * @brief Release a buffer allocated with allocateScratch, from any thread.
+ */
+void freeScratch( char* buffer );
+
+/**
+ * @brief Size from which the buffers come from the MemoryPool.
+ */
+std::size_t getScratchPoolThreshold();
+
+}
+}
+}
+
+#endif
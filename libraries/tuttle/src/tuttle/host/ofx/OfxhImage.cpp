@@ -36,11 +36,18 @@
 // ofx
 #include <ofxCore.h>
 
+#include <boost/thread/mutex.hpp>
+
 namespace tuttle {
 namespace host {
 namespace ofx {
 namespace imageEffect {
 
+namespace {
+/// The images of a node are shared by the nodes which use it, which could be processed concurrently.
+boost::mutex referenceCountMutex;
+}
+
 std::ptrdiff_t OfxhImage::_count = 0;
 
 static property::OfxhPropSpec imageStuffs[] = {
@@ -241,6 +248,7 @@ int OfxhImage::getRowBytes() const
 
 int OfxhImage::getReferenceCount( const EReferenceOwner from ) const
 {
+	boost::mutex::scoped_lock locker( referenceCountMutex );
 	RefMap::const_iterator it = _referenceCount.find(from);
 	if( it == _referenceCount.end() )
 		return 0;
@@ -249,13 +257,21 @@ int OfxhImage::getReferenceCount( const EReferenceOwner from ) const
 
 void OfxhImage::addReference( const EReferenceOwner from, const std::size_t n )
 {
-	const std::ptrdiff_t refC = _referenceCount[from] = getReferenceCount(from) + n;
+	std::ptrdiff_t refC;
+	{
+		boost::mutex::scoped_lock locker( referenceCountMutex );
+		refC = _referenceCount[from] += n;
+	}
 	TUTTLE_LOG_INFO( "[Ofxh Image] add reference with degree " << n << ", clipName:" << getClipName() << ", time:" << getTime() << ", id:" << getId() << ", ref:" << refC );
 }
 
 bool OfxhImage::releaseReference( const EReferenceOwner from )
 {
-	const std::ptrdiff_t refC = _referenceCount[from] = getReferenceCount(from) - 1;
+	std::ptrdiff_t refC;
+	{
+		boost::mutex::scoped_lock locker( referenceCountMutex );
+		refC = --_referenceCount[from];
+	}
 	TUTTLE_LOG_INFO( "[Ofxh Image] release reference, clipName:" << getClipName() << ", time:" << getTime() << ", id:" << getId() << ", ref:" << refC );
 	if( refC < 0 )
 		BOOST_THROW_EXCEPTION( std::logic_error( "Try to release an undeclared reference to an Image." ) );
@@ -143,6 +143,13 @@ bool OfxhImageEffectNodeBase::supportsTiles() const
 	return _properties.getIntProperty( kOfxImageEffectPropSupportsTiles ) != 0;
 }
 
+/// can the effect render with its output sharing the buffer of a source image
+
+bool OfxhImageEffectNodeBase::supportsInPlace() const
+{
+	return _properties.getIntProperty( kTuttleOfxImageEffectPropSupportsInPlace ) != 0;
+}
+
 /// does this effect need random temporal access
 
 bool OfxhImageEffectNodeBase::temporalAccess() const
@@ -89,6 +89,9 @@ public:
 	/// does the effect support tiled rendering
 	bool supportsTiles() const;
 
+	/// can the effect render with its output sharing the buffer of a source image
+	bool supportsInPlace() const;
+
 	/// does this effect need random temporal access
 	bool temporalAccess() const;
 
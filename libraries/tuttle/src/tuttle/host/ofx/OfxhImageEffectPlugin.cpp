@@ -48,7 +48,13 @@
 // ofx
 #include <ofxImageEffect.h>
 
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/stream.hpp>
+
 #include <string>
+#include <sstream>
 #include <map>
 
 // Disable the "this pointer used in base member initialiser list" warning in Windows
@@ -111,7 +117,7 @@ OfxhImageEffectPlugin::~OfxhImageEffectPlugin()
 bool OfxhImageEffectPlugin::operator==( const OfxhImageEffectPlugin& other ) const
 {
 	if( OfxhPlugin::operator!=( other ) ||
-	    *_baseDescriptor != *( other._baseDescriptor ) )
+	    getDescriptor() != other.getDescriptor() )
 		return false;
 	return true;
 }
@@ -134,15 +140,43 @@ const APICache::OfxhPluginAPICacheI& OfxhImageEffectPlugin::getApiHandler() cons
 /// get the image effect descriptor
 OfxhImageEffectNodeDescriptor& OfxhImageEffectPlugin::getDescriptor()
 {
+	loadDescriptor();
 	return *_baseDescriptor;
 }
 
 /// get the image effect descriptor const version
 const OfxhImageEffectNodeDescriptor& OfxhImageEffectPlugin::getDescriptor() const
 {
+	loadDescriptor();
 	return *_baseDescriptor;
 }
 
+void OfxhImageEffectPlugin::loadDescriptor() const
+{
+	boost::mutex::scoped_lock locker( _descriptorMutex );
+	if( _baseDescriptor || _serializedDescriptor.empty() )
+		return;
+
+	boost::iostreams::stream<boost::iostreams::array_source> is( _serializedDescriptor.data(), _serializedDescriptor.size() );
+	boost::archive::binary_iarchive iArchive( is );
+	iArchive >> BOOST_SERIALIZATION_NVP( _baseDescriptor );
+	std::string().swap( _serializedDescriptor );
+}
+
+std::string OfxhImageEffectPlugin::saveDescriptor() const
+{
+	boost::mutex::scoped_lock locker( _descriptorMutex );
+	if( ! _baseDescriptor )
+		return _serializedDescriptor;
+
+	std::ostringstream os;
+	{
+		boost::archive::binary_oarchive oArchive( os );
+		oArchive << BOOST_SERIALIZATION_NVP( _baseDescriptor );
+	}
+	return os.str();
+}
+
 void OfxhImageEffectPlugin::addContext( const std::string& context, OfxhImageEffectNodeDescriptor* ied )
 {
 	std::string key( context ); // for constness
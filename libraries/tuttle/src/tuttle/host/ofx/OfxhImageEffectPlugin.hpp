@@ -47,6 +47,10 @@
 #include <boost/serialization/nvp.hpp>
 #include <boost/serialization/export.hpp>
 #include <boost/serialization/scoped_ptr.hpp>
+#include <boost/serialization/split_member.hpp>
+#include <boost/serialization/version.hpp>
+#include <boost/serialization/string.hpp>
+#include <boost/type_traits/is_same.hpp>
 
 #include <boost/thread/mutex.hpp>
 
@@ -54,6 +58,13 @@
 #include <set>
 #include <memory>
 
+namespace boost {
+namespace archive {
+class binary_iarchive;
+class binary_oarchive;
+}
+}
+
 namespace tuttle {
 namespace host {
 namespace ofx {
@@ -85,7 +96,15 @@ private:
 	// this comes off Descriptor's property set after a describe
 	// context independent
 	/// @todo tuttle: ???
-	boost::scoped_ptr<OfxhImageEffectNodeDescriptor> _baseDescriptor;     ///< NEEDS TO BE MADE WITH A FACTORY FUNCTION ON THE HOST!!!!!!
+	mutable boost::scoped_ptr<OfxhImageEffectNodeDescriptor> _baseDescriptor;     ///< NEEDS TO BE MADE WITH A FACTORY FUNCTION ON THE HOST!!!!!!
+
+	/**
+	 * @brief Binary archive of the base descriptor, read from a binary plugin cache.
+	 * It is only deserialized when the descriptor is used, so the plugins
+	 * which are not used don't cost more than their identifier at startup.
+	 */
+	mutable std::string _serializedDescriptor;
+	mutable boost::mutex _descriptorMutex;
 
 private:
 	OfxhImageEffectPlugin();
@@ -149,16 +168,56 @@ public:
 private:
 	OfxhImageEffectNodeDescriptor& describeInContextAction( const std::string& context );
 
+	/// @brief deserialize the base descriptor if it is still a binary archive
+	void loadDescriptor() const;
+
+	/// @brief the base descriptor as a binary archive
+	std::string saveDescriptor() const;
+
+#ifndef SWIG
 private:
 	friend class boost::serialization::access;
 	template<class Archive>
-	void serialize( Archive& ar, const unsigned int version )
+	void save( Archive& ar, const unsigned int version ) const
 	{
-		ar& BOOST_SERIALIZATION_BASE_OBJECT_NVP( OfxhPlugin );
-		ar& BOOST_SERIALIZATION_NVP( _baseDescriptor );
+		ar << BOOST_SERIALIZATION_BASE_OBJECT_NVP( OfxhPlugin );
+		// in the binary archives, the base descriptor is kept serialized until it is used
+		const bool lazyDescriptor = boost::is_same<Archive, boost::archive::binary_oarchive>::value;
+		ar << BOOST_SERIALIZATION_NVP( lazyDescriptor );
+		if( lazyDescriptor )
+		{
+			const std::string descriptor = saveDescriptor();
+			ar << BOOST_SERIALIZATION_NVP( descriptor );
+		}
+		else
+		{
+			loadDescriptor();
+			ar << BOOST_SERIALIZATION_NVP( _baseDescriptor );
+		}
 		//ar & BOOST_SERIALIZATION_NVP(_pluginLoadGuard); // don't save this
-		ar& BOOST_SERIALIZATION_NVP( _contexts );
+		ar << BOOST_SERIALIZATION_NVP( _contexts );
 	}
+
+	template<class Archive>
+	void load( Archive& ar, const unsigned int version )
+	{
+		ar >> BOOST_SERIALIZATION_BASE_OBJECT_NVP( OfxhPlugin );
+		bool lazyDescriptor = false;
+		if( version > 0 )
+			ar >> BOOST_SERIALIZATION_NVP( lazyDescriptor );
+		if( lazyDescriptor )
+		{
+			_baseDescriptor.reset();
+			ar >> boost::serialization::make_nvp( "descriptor", _serializedDescriptor );
+		}
+		else
+		{
+			ar >> BOOST_SERIALIZATION_NVP( _baseDescriptor );
+		}
+		ar >> BOOST_SERIALIZATION_NVP( _contexts );
+	}
+	BOOST_SERIALIZATION_SPLIT_MEMBER()
+#endif
 };
 
 }
@@ -168,6 +227,7 @@ private:
 
 #ifndef SWIG
 BOOST_CLASS_EXPORT_KEY( tuttle::host::ofx::imageEffect::OfxhImageEffectPlugin )
+BOOST_CLASS_VERSION( tuttle::host::ofx::imageEffect::OfxhImageEffectPlugin, 1 )
 #endif
 
 #endif
@@ -30,10 +30,14 @@
 // ofx host
 #include "OfxhMemory.hpp"
 
+#include <tuttle/host/memory/ScratchMemory.hpp>
+
 // ofx
 #include <ofxCore.h>
 #include <ofxImageEffect.h>
 
+#include <exception>
+
 namespace tuttle {
 namespace host {
 namespace ofx {
@@ -45,7 +49,7 @@ OfxhMemory::OfxhMemory()
 
 OfxhMemory::~OfxhMemory()
 {
-	delete [] _ptr;
+	freeMem();
 }
 
 bool OfxhMemory::alloc( size_t nBytes )
@@ -54,7 +58,15 @@ bool OfxhMemory::alloc( size_t nBytes )
 	{
 		if( _ptr )
 			freeMem();
-		_ptr = new char[nBytes];
+		try
+		{
+			_ptr = memory::allocateScratch( nBytes );
+		}
+		catch( std::exception& )
+		{
+			_ptr = 0;
+			return false;
+		}
 		return true;
 	}
 	else
@@ -68,7 +80,7 @@ OfxImageMemoryHandle OfxhMemory::getHandle()
 
 void OfxhMemory::freeMem()
 {
-	delete [] _ptr;
+	memory::freeScratch( _ptr );
 	_ptr = 0;
 }
 
@@ -38,7 +38,7 @@ namespace host {
 namespace ofx {
 
 /**
- * @todo use MemoryPool
+ * @brief Image memory of the plugins, allocated as scratch memory (see memory::allocateScratch).
  */
 class OfxhMemory
 {
@@ -3,6 +3,9 @@
 
 #include "OfxhCore.hpp"
 
+#include <tuttle/host/memory/ScratchMemory.hpp>
+#include <tuttle/common/utils/global.hpp>
+
 namespace tuttle {
 namespace host {
 namespace ofx {
@@ -11,20 +14,22 @@ namespace {
 
 OfxStatus memoryAlloc( void* handle, size_t bytes, void** data )
 {
-	*data = new char[ bytes ];
-	if( *data )
+	try
 	{
-		return kOfxStatOK;
+		*data = memory::allocateScratch( bytes );
 	}
-	else
+	catch( std::exception& e )
 	{
+		TUTTLE_LOG_ERROR( "[Memory suite] Can't allocate " << bytes << " bytes: " << e.what() );
+		*data = NULL;
 		return kOfxStatErrMemory;
 	}
+	return kOfxStatOK;
 }
 
 OfxStatus memoryFree( void* data )
 {
-	delete[] static_cast<char*>( data );
+	memory::freeScratch( static_cast<char*>( data ) );
 	return kOfxStatOK;
 }
 
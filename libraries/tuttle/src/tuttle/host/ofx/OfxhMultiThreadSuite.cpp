@@ -1,7 +1,9 @@
 #include "OfxhMultiThreadSuite.hpp"
 #include "OfxhCore.hpp"
 
-#include <boost/thread/thread.hpp>
+#include <tuttle/host/Core.hpp>
+#include <tuttle/common/exceptions.hpp>
+
 #include <boost/thread/recursive_mutex.hpp>
 #include <boost/thread/tss.hpp>
 #include <boost/bind.hpp>
@@ -19,21 +21,45 @@ namespace {
 
 struct ThreadSpecificData
 {
-	ThreadSpecificData( unsigned int threadIndex ) : _index( 0 ) {}
+	ThreadSpecificData( unsigned int threadIndex ) : _index( threadIndex ) {}
 	unsigned int _index;
 };
 
 boost::thread_specific_ptr<ThreadSpecificData> ptr;
 
+/**
+ * @brief Set the thread index during the call of a thread function.
+ * Restore the previous one at the end, for nested multiThread calls.
+ */
+class ThreadIndexGuard
+{
+public:
+	ThreadIndexGuard( const unsigned int threadIndex )
+		: _previous( ptr.release() )
+	{
+		ptr.reset( new ThreadSpecificData( threadIndex ) );
+	}
+	~ThreadIndexGuard()
+	{
+		ptr.reset( _previous );
+	}
+private:
+	ThreadSpecificData* _previous;
+};
+
 void launchThread( OfxThreadFunctionV1 func,
-                   unsigned int        threadIndex,
+                   const std::size_t   threadIndex,
                    unsigned int        threadMax,
                    void*               customArg )
 {
-	ptr.reset( new ThreadSpecificData( threadIndex ) );
+	ThreadIndexGuard guard( threadIndex );
 	func( threadIndex, threadMax, customArg );
 }
 
+/**
+ * @brief Execute the thread function with the threads of the Core thread pool.
+ * The threads are created only once, and nested calls share the same threads.
+ */
 OfxStatus multiThread( OfxThreadFunctionV1 func,
                        const unsigned int  nThreads,
                        void*               customArg )
@@ -48,28 +74,31 @@ OfxStatus multiThread( OfxThreadFunctionV1 func,
 	}
 	else
 	{
-		boost::thread_group group;
-		for( unsigned int i = 0; i < nThreads; ++i )
+		try
+		{
+			core().getThreadPool().execute( boost::bind( launchThread, func, _1, nThreads, customArg ), nThreads );
+		}
+		catch(...)
 		{
-			group.create_thread( boost::bind( launchThread, func, i, nThreads, customArg ) );
+			TUTTLE_LOG_ERROR( "[Multi thread] Error in a thread function." << std::endl
+				<< tuttle::exception::format_current_exception() );
+			return kOfxStatFailed;
 		}
-		group.join_all();
 	}
 	return kOfxStatOK;
 }
 
 OfxStatus multiThreadNumCPUs( unsigned int* const nCPUs )
 {
-//	*nCPUs = 1; /// @todo tuttle: needs to have an option to disable multithreading (force only one cpu).
-	*nCPUs = boost::thread::hardware_concurrency();
-	TUTTLE_LOG_INFO( "[Multi thread] CPUs used: " << *nCPUs );
+	*nCPUs = core().getThreadPool().getThreadBudget();
+	TUTTLE_LOG_TRACE( "[Multi thread] CPUs used: " << *nCPUs );
 	return kOfxStatOK;
 }
 
 OfxStatus multiThreadIndex( unsigned int* const threadIndex )
 {
 	//	*threadIndex = boost::this_thread::get_id(); //	we don't want a global thead id, but the thead index inside a node multithread process.
-	if( ptr.get() != NULL )
+	if( ptr.get() == NULL )
 	{
 		*threadIndex = 0;
 		return kOfxStatFailed;
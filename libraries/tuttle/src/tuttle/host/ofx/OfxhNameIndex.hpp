@@ -0,0 +1,140 @@
+#ifndef _TUTTLE_HOST_OFX_NAMEINDEX_HPP_
+#define _TUTTLE_HOST_OFX_NAMEINDEX_HPP_
+
+#include <vector>
+#include <string>
+#include <cstring>
+#include <cstddef>
+
+namespace tuttle {
+namespace host {
+namespace ofx {
+
+/// Hash of a property, parameter or clip name (FNV-1a).
+inline std::size_t hashName( const char* name )
+{
+	std::size_t hash = 2166136261u;
+	for( ; *name != '\0'; ++name )
+	{
+		hash ^= static_cast<unsigned char>( *name );
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+/**
+ * @brief Flat hash index of objects by name, beside the maps of the property, parameter and clip sets.
+ *
+ * The names are hashed once, when the objects are indexed, so a lookup only hashes
+ * the name given by the plugin, without building a std::string, and compares the
+ * names of the entries with the same hash.
+ * The index doesn't own the names: they are the keys of the map of the owner, and
+ * the index is rebuilt when an object is removed.
+ */
+template<class T>
+class OfxhNameIndex
+{
+public:
+	OfxhNameIndex()
+		: _size( 0 )
+	{}
+
+	void clear()
+	{
+		_entries.clear();
+		_size = 0;
+	}
+
+	std::size_t size() const { return _size; }
+
+	/// @param name the name of @p object, which must live as long as the entry
+	void insert( const std::string& name, T* object )
+	{
+		// open addressing with at most half of the entries used
+		if( 2 * ( _size + 1 ) > _entries.size() )
+			grow();
+		if( insertEntry( Entry( hashName( name.c_str() ), &name, object ) ) )
+			++_size;
+	}
+
+	/// @return NULL if there is no object named @p name
+	T* find( const char* name ) const
+	{
+		if( _entries.empty() )
+			return NULL;
+		const std::size_t hash = hashName( name );
+		const std::size_t mask = _entries.size() - 1;
+		for( std::size_t i = hash & mask; _entries[i]._object != NULL; i = ( i + 1 ) & mask )
+		{
+			const Entry& entry = _entries[i];
+			if( entry._hash == hash && std::strcmp( entry._name->c_str(), name ) == 0 )
+				return entry._object;
+		}
+		return NULL;
+	}
+
+	T* find( const std::string& name ) const { return find( name.c_str() ); }
+
+private:
+	struct Entry
+	{
+		Entry()
+			: _hash( 0 )
+			, _name( NULL )
+			, _object( NULL )
+		{}
+
+		Entry( const std::size_t hash, const std::string* name, T* object )
+			: _hash( hash )
+			, _name( name )
+			, _object( object )
+		{}
+
+		std::size_t _hash;
+		const std::string* _name;
+		T* _object; ///< NULL for an empty entry
+	};
+
+	void grow()
+	{
+		std::vector<Entry> entries( _entries.empty() ? 16 : 2 * _entries.size() );
+		entries.swap( _entries );
+		for( typename std::vector<Entry>::const_iterator it = entries.begin(), itEnd = entries.end();
+		     it != itEnd;
+		     ++it )
+		{
+			if( it->_object != NULL )
+				insertEntry( *it );
+		}
+	}
+
+	/// @return false if the entry replaces the entry of the same name
+	bool insertEntry( const Entry& entry )
+	{
+		const std::size_t mask = _entries.size() - 1;
+		std::size_t i = entry._hash & mask;
+		while( _entries[i]._object != NULL )
+		{
+			if( _entries[i]._hash == entry._hash && *_entries[i]._name == *entry._name )
+			{
+				// a new object with the same name replaces the previous one, like in the maps
+				_entries[i]._name = entry._name;
+				_entries[i]._object = entry._object;
+				return false;
+			}
+			i = ( i + 1 ) & mask;
+		}
+		_entries[i] = entry;
+		return true;
+	}
+
+private:
+	std::vector<Entry> _entries; ///< power of 2 size
+	std::size_t _size;
+};
+
+}
+}
+}
+
+#endif
@@ -54,21 +54,20 @@ OfxStatus paramGetHandle( OfxParamSetHandle     paramSet,
 		OfxhParamSet* setInstance = dynamic_cast<OfxhParamSet*>( baseSet );
 		if( setInstance )
 		{
-			const std::map<std::string, OfxhParam*>& params      = setInstance->getParamsByName();
-			std::map<std::string, OfxhParam*>::const_iterator it = params.find( name );
+			OfxhParam* instance = setInstance->getParamPtr( name );
 
 			// if we can't find it return an error...
-			if( it == params.end() )
+			if( instance == NULL )
 			{
 				BOOST_THROW_EXCEPTION( OfxhException( kOfxStatErrUnknown, std::string( "Can't find parameter : " ) + name ) );
 			}
 
 			// get the param
-			*param = ( it->second )->getParamHandle();
+			*param = instance->getParamHandle();
 
 			// get the param property set
 			if( propertySet )
-				*propertySet = ( it->second )->getPropHandle();
+				*propertySet = instance->getPropHandle();
 
 			return kOfxStatOK;
 		}
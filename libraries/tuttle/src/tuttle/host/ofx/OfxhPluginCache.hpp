@@ -140,6 +140,11 @@ public:
 		_cacheVersion = cacheVersion;
 	}
 
+	const std::string& getCacheVersion() const
+	{
+		return _cacheVersion;
+	}
+
 	// populate the cache.  must call scanPluginFiles() after to check for changes.
 	//void readCache( std::istream& is );
 
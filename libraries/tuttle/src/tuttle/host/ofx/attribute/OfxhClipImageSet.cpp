@@ -23,14 +23,22 @@ OfxhClipImageSet::OfxhClipImageSet( const OfxhClipImageSet& other )
 
 void OfxhClipImageSet::initMapFromList()
 {
+	_clipIndex.clear();
 	for( ClipImageVector::iterator it = _clipsByOrder.begin(), itEnd = _clipsByOrder.end();
 	     it != itEnd;
 	     ++it )
 	{
-		_clipImages[it->getName()] = &( *it );
+		indexClip( it->getName(), &( *it ) );
 	}
 }
 
+void OfxhClipImageSet::indexClip( const std::string& name, OfxhClipImage* instance )
+{
+	ClipImageMap::iterator it = _clipImages.insert( ClipImageMap::value_type( name, instance ) ).first;
+	it->second = instance;
+	_clipIndex.insert( it->first, instance );
+}
+
 OfxhClipImageSet::~OfxhClipImageSet()
 {}
 
@@ -81,16 +89,16 @@ void OfxhClipImageSet::populateClips( const imageEffect::OfxhImageEffectNodeDesc
 			    << exception::dev( "Error on ClipImage creation." ) );
 
 		_clipsByOrder.push_back( instance );
-		_clipImages[name] = instance;
+		indexClip( name, instance );
 	}
 }
 
 OfxhClipImage& OfxhClipImageSet::getClip( const std::string& name, const bool acceptPartialName )
 {
-	ClipImageMap::const_iterator it = _clipImages.find( name );
+	OfxhClipImage* clip = _clipIndex.find( name );
 
-	if( it != _clipImages.end() )
-		return *it->second;
+	if( clip != NULL )
+		return *clip;
 
 	std::vector<std::string> matches;
 	OfxhClipImage* res = NULL;
@@ -6,6 +6,7 @@
 #include "OfxhClipImage.hpp"
 
 #include <tuttle/host/ofx/OfxhIObject.hpp>
+#include <tuttle/host/ofx/OfxhNameIndex.hpp>
 
 #include <boost/foreach.hpp>
 
@@ -29,6 +30,7 @@ public:
 protected:
 	ClipImageVector _clipsByOrder; ///< clips list (data owner)
 	ClipImageMap _clipImages; ///< clips by name (link to datas)
+	OfxhNameIndex<OfxhClipImage> _clipIndex; ///< clips by hashed name, for the lookups of the plugins
 	bool _clipPrefsDirty; ///< do we need to re-run the clip prefs action
 
 public:
@@ -88,9 +90,9 @@ public:
 	 */
 	void addClip( const std::string& name, OfxhClipImage* instance ) OFX_EXCEPTION_SPEC
 	{
-		if( _clipImages.find( name ) != _clipImages.end() )
+		if( _clipIndex.find( name ) != NULL )
 			BOOST_THROW_EXCEPTION( OfxhException( kOfxStatErrExists ) );
-		_clipImages[name] = instance;
+		indexClip( name, instance );
 		_clipsByOrder.push_back( instance );
 	}
 
@@ -128,6 +130,7 @@ public:
 
 private:
 	void initMapFromList();
+	void indexClip( const std::string& name, OfxhClipImage* instance );
 };
 
 }
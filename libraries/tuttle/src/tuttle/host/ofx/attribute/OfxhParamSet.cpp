@@ -22,13 +22,21 @@ OfxhParamSet::OfxhParamSet( const OfxhParamSet& other )
 
 void OfxhParamSet::initMapFromList()
 {
+	_paramIndex.clear();
 	BOOST_FOREACH( OfxhParam& p, _paramVector )
 	{
-		_params[p.getName()] = &p;
-		_paramsByScriptName[p.getScriptName()] = &p;
+		indexParam( p );
 	}
 }
 
+void OfxhParamSet::indexParam( OfxhParam& param )
+{
+	ParamMap::iterator it = _params.insert( ParamMap::value_type( param.getName(), &param ) ).first;
+	it->second = &param;
+	_paramIndex.insert( it->first, &param );
+	_paramsByScriptName[param.getScriptName()] = &param;
+}
+
 OfxhParamSet::~OfxhParamSet()
 {}
 
@@ -89,14 +97,14 @@ std::size_t OfxhParamSet::getHashAtTime( const OfxTime time ) const
 
 OfxhParam& OfxhParamSet::getParam( const std::string& name )
 {
-	ParamMap::iterator it = _params.find( name );
-	if( it == _params.end() )
+	OfxhParam* param = _paramIndex.find( name );
+	if( param == NULL )
 	{
 		BOOST_THROW_EXCEPTION( exception::BadIndex()
 				<< exception::user() + "Param name \"" + name + "\" not found."
 			);
 	}
-	return *it->second;
+	return *param;
 }
 
 OfxhParam& OfxhParamSet::getParamByScriptName( const std::string& scriptName, const bool acceptPartialName )
@@ -181,13 +189,12 @@ OfxhParam& OfxhParamSet::getChildParam( const std::size_t index )
 
 void OfxhParamSet::addParam( OfxhParam* instance ) OFX_EXCEPTION_SPEC
 {
-	if( _params.find( instance->getName() ) != _params.end() )
+	if( _paramIndex.find( instance->getName() ) != NULL )
 	{
 		BOOST_THROW_EXCEPTION( OfxhException( kOfxStatErrExists, "Trying to add a new parameter which already exists." ) );
 	}
 	_paramVector.push_back( instance );
-	_params[instance->getName()] = instance;
-	_paramsByScriptName[instance->getScriptName()] = instance;
+	indexParam( *instance );
 	//	referenceParam( name, instance );
 }
 
@@ -5,6 +5,7 @@
 #include "OfxhParam.hpp"
 
 #include <tuttle/host/ofx/OfxhIObject.hpp>
+#include <tuttle/host/ofx/OfxhNameIndex.hpp>
 
 #include <boost/ptr_container/ptr_vector.hpp>
 #include <boost/foreach.hpp>
@@ -32,6 +33,7 @@ public:
 
 protected:
 	ParamMap _params;             ///< params by name
+	OfxhNameIndex<OfxhParam> _paramIndex; ///< params by hashed name, for the lookups of the plugins
 	ParamMap _paramsByScriptName; ///< params by script name
 	ParamVector _paramVector;     ///< params list
 
@@ -84,6 +86,9 @@ public:
 	OfxhParam& getParam( const std::string& name );
 	const OfxhParam& getParam( const std::string& name ) const { return const_cast<This*>( this )->getParam( name ); }
 
+	/// @return NULL if there is no param named @p name
+	OfxhParam* getParamPtr( const char* name ) const { return _paramIndex.find( name ); }
+
 	OfxhParam& getParamByScriptName( const std::string& scriptName, const bool acceptPartialName = false );
 	const OfxhParam& getParamByScriptName( const std::string& name, const bool acceptPartialName = false ) const { return const_cast<This*>( this )->getParamByScriptName( name, acceptPartialName ); }
 	OfxhParam* getParamPtrByScriptName( const std::string& name, const bool acceptPartialName = false );
@@ -122,6 +127,7 @@ protected:
 
 private:
 	void initMapFromList();
+	void indexParam( OfxhParam& param );
 	#endif
 };
 
@@ -98,22 +98,62 @@ void OfxhSet::addNotifyHook( const std::string& s, OfxhNotifyHook* hook )
 	fetchLocalProperty( s ).addNotifyHook( hook );
 }
 
+OfxhProperty* OfxhSet::findLocalProperty( const char* name ) const
+{
+	boost::atomic<OfxhProperty*>& cached = _readCache[( reinterpret_cast<std::size_t>( name ) >> 3 ) % kReadCacheSize];
+	OfxhProperty* prop = cached.load( boost::memory_order_relaxed );
+	if( prop != NULL && std::strcmp( prop->getName().c_str(), name ) == 0 )
+		return prop;
+
+	prop = _index.find( name );
+	if( prop != NULL )
+		cached.store( prop, boost::memory_order_relaxed );
+	return prop;
+}
+
 OfxhProperty& OfxhSet::fetchLocalProperty( const std::string& name )
 {
-	PropertyMap::iterator i = _props.find( name );
+	OfxhProperty* prop = _index.find( name );
 
-	if( i == _props.end() )
+	if( prop == NULL )
 	{
 		BOOST_THROW_EXCEPTION( OfxhException( kOfxStatErrValue, "fetchLocalProperty: " + name + ". Property not found." ) ); //+ " on type:" + getStringProperty(kOfxPropType) + " name:" + getStringProperty(kOfxPropName) );// " NULL, (followChain: " << followChain << ").";
 	}
-	return *( i->second );
+	return *prop;
+}
+
+OfxhProperty& OfxhSet::fetchLocalProperty( const char* name )
+{
+	OfxhProperty* prop = findLocalProperty( name );
+
+	if( prop == NULL )
+	{
+		BOOST_THROW_EXCEPTION( OfxhException( kOfxStatErrValue, "fetchLocalProperty: " + std::string( name ) + ". Property not found." ) );
+	}
+	return *prop;
 }
 
 const OfxhProperty& OfxhSet::fetchProperty( const std::string& name ) const
 {
-	PropertyMap::const_iterator i = _props.find( name );
+	const OfxhProperty* prop = _index.find( name );
+
+	if( prop == NULL )
+	{
+		if( _chainedSet )
+		{
+			return _chainedSet->fetchProperty( name );
+		}
+		BOOST_THROW_EXCEPTION( OfxhException( kOfxStatErrValue )
+			<< exception::dev() + "fetchProperty: " + name + " property not found." );
+	}
+	return *prop;
+}
+
+const OfxhProperty& OfxhSet::fetchProperty( const char* name ) const
+{
+	const OfxhProperty* prop = findLocalProperty( name );
 
-	if( i == _props.end() )
+	if( prop == NULL )
 	{
 		if( _chainedSet )
 		{
@@ -122,7 +162,7 @@ const OfxhProperty& OfxhSet::fetchProperty( const std::string& name ) const
 		BOOST_THROW_EXCEPTION( OfxhException( kOfxStatErrValue )
 			<< exception::dev() + "fetchProperty: " + name + " property not found." );
 	}
-	return *( i->second );
+	return *prop;
 }
 
 /**
@@ -130,30 +170,31 @@ const OfxhProperty& OfxhSet::fetchProperty( const std::string& name ) const
  */
 void OfxhSet::createProperty( const OfxhPropSpec& spec )
 {
-	if( _props.find( spec.name ) != _props.end() )
+	if( _index.find( spec.name ) != NULL )
 	{
 		BOOST_THROW_EXCEPTION( OfxhException( kOfxStatErrExists )
 			<< exception::dev() + "Tried to add a duplicate property to a Property::Set (" + spec.name + ")" );
 	}
-	std::string key( spec.name ); // for constness
+	OfxhProperty* prop = NULL;
 	switch( spec.type )
 	{
 		case ePropTypeInt:
-			_props.insert( key, new Int( spec.name, spec.dimension, spec.readonly, spec.defaultValue ? std::atoi( spec.defaultValue ) : 0 ) );
+			prop = new Int( spec.name, spec.dimension, spec.readonly, spec.defaultValue ? std::atoi( spec.defaultValue ) : 0 );
 			break;
 		case ePropTypeDouble:
-			_props.insert( key, new Double( spec.name, spec.dimension, spec.readonly, spec.defaultValue ? std::atof( spec.defaultValue ) : 0 ) );
+			prop = new Double( spec.name, spec.dimension, spec.readonly, spec.defaultValue ? std::atof( spec.defaultValue ) : 0 );
 			break;
 		case ePropTypeString:
-			_props.insert( key, new String( spec.name, spec.dimension, spec.readonly, spec.defaultValue ? spec.defaultValue : "" ) );
+			prop = new String( spec.name, spec.dimension, spec.readonly, spec.defaultValue ? spec.defaultValue : "" );
 			break;
 		case ePropTypePointer:
-			_props.insert( key, new Pointer( spec.name, spec.dimension, spec.readonly, (void*) spec.defaultValue ) );
+			prop = new Pointer( spec.name, spec.dimension, spec.readonly, (void*) spec.defaultValue );
 			break;
 		case ePropTypeNone:
 			BOOST_THROW_EXCEPTION( OfxhException( kOfxStatErrUnsupported )
 				<< exception::dev() + "Tried to create a property of an unrecognized type (" + spec.name + ", " + mapTypeEnumToString( spec.type ) + ")" );
 	}
+	addProperty( prop );
 }
 
 void OfxhSet::addProperties( const OfxhPropSpec spec[] )
@@ -168,20 +209,20 @@ void OfxhSet::addProperties( const OfxhPropSpec spec[] )
 void OfxhSet::eraseProperty( const std::string& propName )
 {
 	_props.erase( propName );
+	reindex();
 }
 
 bool OfxhSet::hasProperty( const std::string& propName, bool followChain ) const
 {
-	PropertyMap::const_iterator it = _props.find( propName );
-
-	if( it == _props.end() )
+	if( _index.find( propName ) == NULL )
 	{
 		if( followChain && _chainedSet )
 		{
 			return _chainedSet->hasProperty( propName, true );
 		}
+		return false;
 	}
-	return it != _props.end();
+	return true;
 }
 
 bool OfxhSet::hasLocalProperty( const std::string& propName ) const
@@ -196,7 +237,26 @@ void OfxhSet::addProperty( OfxhProperty* prop )
 {
 	std::string key( prop->getName() ); // for constness
 
-	_props.insert( key, prop );
+	PropertyMap::iterator it = _props.insert( key, prop ).first;
+	_index.insert( it->first, it->second );
+}
+
+void OfxhSet::reindex()
+{
+	_index.clear();
+	for( PropertyMap::iterator it = _props.begin(), itEnd = _props.end();
+	     it != itEnd;
+	     ++it )
+	{
+		_index.insert( it->first, it->second );
+	}
+	clearReadCache();
+}
+
+void OfxhSet::clearReadCache() const
+{
+	for( std::size_t i = 0; i < kReadCacheSize; ++i )
+		_readCache[i].store( NULL, boost::memory_order_relaxed );
 }
 
 /**
@@ -205,12 +265,15 @@ void OfxhSet::addProperty( OfxhProperty* prop )
 OfxhSet::OfxhSet()
 	: _magic( kMagic )
 	, _chainedSet( NULL )
-{}
+{
+	clearReadCache();
+}
 
 OfxhSet::OfxhSet( const OfxhPropSpec spec[] )
 	: _magic( kMagic )
 	, _chainedSet( NULL )
 {
+	clearReadCache();
 	addProperties( spec );
 }
 
@@ -228,12 +291,14 @@ OfxhSet::~OfxhSet()
 void OfxhSet::clear()
 {
 	_props.clear();
+	reindex();
 }
 
 OfxhSet& OfxhSet::operator=( const This& other )
 {
 	_props      = other._props.clone();
 	_chainedSet = other._chainedSet;
+	reindex();
 	return *this;
 }
 
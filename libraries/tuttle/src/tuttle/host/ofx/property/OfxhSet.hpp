@@ -31,6 +31,9 @@
 
 #include "OfxhPropertyTemplate.hpp"
 
+#include <tuttle/host/ofx/OfxhNameIndex.hpp>
+#include <tuttle/common/atomic.hpp>
+
 #include <boost/ptr_container/serialize_ptr_map.hpp>
 
 namespace tuttle {
@@ -75,6 +78,21 @@ protected:
 	/// on a local search
 	const OfxhSet* _chainedSet;
 
+private:
+	/// Properties by hashed name, rebuilt by the functions which remove properties.
+	OfxhNameIndex<OfxhProperty> _index;
+
+	static const std::size_t kReadCacheSize = 16;
+	/// Properties read by the plugins, by the address of the name given to the suite.
+	/// Plugins use the same constant names on each render, so the entries are checked
+	/// with a single comparison of the names, without hashing.
+	mutable boost::atomic<OfxhProperty*> _readCache[kReadCacheSize];
+
+	void reindex();
+	void clearReadCache() const;
+	OfxhProperty* findLocalProperty( const char* name ) const;
+
+protected:
 	/// set a particular property
 	template<class T>
 	void setProperty( const std::string& property, int index, const typename T::Type& value );
@@ -178,6 +196,12 @@ public:
 	OfxhProperty&       fetchLocalProperty( const std::string& name );
 	const OfxhProperty& fetchLocalProperty( const std::string& name ) const { return const_cast<OfxhSet*>( this )->fetchLocalProperty( name ); }
 
+	#ifndef SWIG
+	/// Versions for the names given by the plugins, which use the read cache.
+	const OfxhProperty& fetchProperty( const char* name ) const;
+	OfxhProperty&       fetchLocalProperty( const char* name );
+	#endif
+
 	/// get property with the particular name and type.  if the property is
 	/// missing or is of the wrong type, return an error status.  if this is a sloppy
 	/// property set and the property is missing, a new one will be created of the right
@@ -194,6 +218,20 @@ public:
 		return dynamic_cast<T&>( fetchLocalProperty( name ) );
 	}
 
+	#ifndef SWIG
+	template<class T>
+	const T& fetchTypedProperty( const char* name ) const
+	{
+		return dynamic_cast<const T&>( fetchProperty( name ) );
+	}
+
+	template<class T>
+	T& fetchLocalTypedProperty( const char* name )
+	{
+		return dynamic_cast<T&>( fetchLocalProperty( name ) );
+	}
+	#endif
+
 	template<class T>
 	const T& fetchLocalTypedProperty( const std::string& name ) const
 	{
@@ -321,6 +359,8 @@ private:
 	void serialize( Archive& ar, const unsigned int version )
 	{
 		ar& BOOST_SERIALIZATION_NVP( _props );
+		if( Archive::is_loading::value )
+			reindex();
 	}
 
 };
@@ -0,0 +1,111 @@
+#include "WriteBehindQueue.hpp"
+
+#include <tuttle/plugin/global.hpp>
+#include <tuttle/plugin/exceptions.hpp>
+
+#include <boost/bind.hpp>
+
+namespace tuttle {
+namespace plugin {
+
+WriteBehindQueue::WriteBehindQueue( const std::size_t size )
+	: _size( size )
+	, _nbRunning( 0 )
+	, _nextIndex( 0 )
+	, _errorIndex( 0 )
+	, _stop( false )
+{
+	for( std::size_t i = 0; i < _size; ++i )
+		_threads.create_thread( boost::bind( &WriteBehindQueue::run, this ) );
+}
+
+WriteBehindQueue::~WriteBehindQueue()
+{
+	try
+	{
+		flush();
+	}
+	catch(...)
+	{
+		// already logged by the job
+	}
+	{
+		boost::mutex::scoped_lock lock( _mutex );
+		_stop = true;
+	}
+	_jobCond.notify_all();
+	_threads.join_all();
+}
+
+void WriteBehindQueue::push( const Job& job, const OfxTime time )
+{
+	boost::mutex::scoped_lock lock( _mutex );
+	while( _jobs.size() + _nbRunning >= _size )
+		_doneCond.wait( lock );
+	_jobs.push_back( PendingJob( job, _nextIndex++, time ) );
+	_jobCond.notify_one();
+}
+
+void WriteBehindQueue::flush()
+{
+	boost::mutex::scoped_lock lock( _mutex );
+	while( ! _jobs.empty() || _nbRunning != 0 )
+		_doneCond.wait( lock );
+	if( ! _error )
+		return;
+	const boost::exception_ptr error = _error;
+	_error = boost::exception_ptr();
+	lock.unlock();
+	boost::rethrow_exception( error );
+}
+
+void WriteBehindQueue::run()
+{
+	boost::mutex::scoped_lock lock( _mutex );
+	for(;;)
+	{
+		while( ! _stop && _jobs.empty() )
+			_jobCond.wait( lock );
+		if( _jobs.empty() )
+			return;
+
+		PendingJob job = _jobs.front();
+		_jobs.pop_front();
+		++_nbRunning;
+
+		boost::exception_ptr error;
+		lock.unlock();
+		try
+		{
+			job._job();
+		}
+		catch( boost::exception& e )
+		{
+			e << exception::time( job._time );
+			error = boost::current_exception();
+			TUTTLE_LOG_ERROR( "[Writer] Error during the write of the frame " << job._time << "." << std::endl
+				<< tuttle::exception::format_current_exception() );
+		}
+		catch(...)
+		{
+			error = boost::current_exception();
+			TUTTLE_LOG_ERROR( "[Writer] Error during the write of the frame " << job._time << "." << std::endl
+				<< tuttle::exception::format_current_exception() );
+		}
+		// release the images before the end of the job
+		job._job.clear();
+		lock.lock();
+
+		// keep the error of the first frame
+		if( error && ( ! _error || job._index < _errorIndex ) )
+		{
+			_error = error;
+			_errorIndex = job._index;
+		}
+		--_nbRunning;
+		_doneCond.notify_all();
+	}
+}
+
+}
+}
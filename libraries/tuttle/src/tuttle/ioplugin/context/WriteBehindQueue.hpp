@@ -0,0 +1,92 @@
+#ifndef _TUTTLE_IOPLUGIN_CONTEXT_WRITEBEHINDQUEUE_HPP_
+#define _TUTTLE_IOPLUGIN_CONTEXT_WRITEBEHINDQUEUE_HPP_
+
+#include <ofxCore.h>
+
+#include <boost/function.hpp>
+#include <boost/exception_ptr.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <deque>
+#include <cstddef>
+
+namespace tuttle {
+namespace plugin {
+
+/**
+ * @brief Bounded queue of frames to encode and write in background threads.
+ *
+ * Each job keeps the images it writes until it is done, so the render of a
+ * writer returns as soon as the job is queued and the graph can compute the
+ * next frames during the encoding.
+ * When @p size frames are waiting or in progress, push() waits for a free
+ * place, so the memory used by the queue is bounded.
+ * The error of a job is logged with the time of its frame, and the error of
+ * the first frame which failed is rethrown by flush(). The errors are not
+ * rethrown by push(), the render of the next frames succeeds.
+ */
+class WriteBehindQueue : boost::noncopyable
+{
+public:
+	typedef boost::function<void()> Job;
+
+	/**
+	 * @param size maximum number of frames waiting or in progress,
+	 *             also the number of threads
+	 */
+	explicit WriteBehindQueue( const std::size_t size );
+	/// Wait for the jobs in progress, the errors are only logged.
+	~WriteBehindQueue();
+
+	std::size_t size() const { return _size; }
+
+	/**
+	 * @brief Add the job writing the frame at @p time.
+	 * Wait for a free place.
+	 */
+	void push( const Job& job, const OfxTime time );
+
+	/**
+	 * @brief Wait for all the jobs.
+	 * Rethrow the error of the first frame which failed, with its time (exception::time).
+	 */
+	void flush();
+
+private:
+	struct PendingJob
+	{
+		PendingJob( const Job& job, const std::size_t index, const OfxTime time )
+			: _job( job )
+			, _index( index )
+			, _time( time )
+		{}
+		Job _job;
+		std::size_t _index; ///< order of the frame
+		OfxTime _time;
+	};
+
+	void run();
+
+private:
+	const std::size_t _size;
+
+	boost::mutex _mutex;
+	boost::condition_variable _jobCond; ///< a job is added, or stop
+	boost::condition_variable _doneCond; ///< a job is done
+	std::deque<PendingJob> _jobs;
+	std::size_t _nbRunning;
+	std::size_t _nextIndex;
+	boost::exception_ptr _error; ///< error of the first frame which failed
+	std::size_t _errorIndex;
+	bool _stop;
+
+	boost::thread_group _threads;
+};
+
+}
+}
+
+#endif
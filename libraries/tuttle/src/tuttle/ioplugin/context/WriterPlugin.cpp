@@ -6,6 +6,7 @@
 
 #include <boost/filesystem/operations.hpp>
 #include <boost/scoped_ptr.hpp>
+#include <boost/bind.hpp>
 
 #include <cstdio>
 
@@ -32,6 +33,7 @@ WriterPlugin::WriterPlugin( OfxImageEffectHandle handle )
 	_paramPremult = fetchBooleanParam( kParamPremultiplied );
 	_paramExistingFile = fetchChoiceParam( kParamWriterExistingFile );
 	_paramForceNewRender = fetchIntParam( kParamWriterForceNewRender );
+	_paramWriteBehind = paramExists( kParamWriterWriteBehind ) ? fetchIntParam( kParamWriterWriteBehind ) : NULL;
 
 	// update params
 	changedParam( OFX::InstanceChangedArgs(), kTuttlePluginFilename );
@@ -126,6 +128,36 @@ void WriterPlugin::beginSequenceRender( const OFX::BeginSequenceRenderArguments&
 	{
 		bfs::create_directories( dir );
 	}
+
+	_writeBehindQueue.reset();
+	// without a frame pattern all the frames are written into the same file
+	if( _isSequence && _paramWriteBehind && _paramWriteBehind->getValue() > 0 )
+		_writeBehindQueue.reset( new WriteBehindQueue( _paramWriteBehind->getValue() ) );
+}
+
+void WriterPlugin::endSequenceRender( const OFX::EndSequenceRenderArguments& args )
+{
+	if( ! _writeBehindQueue )
+		return;
+	// the queue is destroyed even if a frame can't be written
+	boost::scoped_ptr<WriteBehindQueue> writeBehindQueue;
+	writeBehindQueue.swap( _writeBehindQueue );
+	writeBehindQueue->flush();
+}
+
+void WriterPlugin::writeBehind( const boost::shared_ptr<ImageProcessor>& processor, const OFX::RenderArguments& args )
+{
+	if( ! _writeBehindQueue )
+	{
+		processor->setupAndProcess( args );
+		return;
+	}
+	// fetch the images now, they are only available during the render
+	if( ! processor->setupRender( args ) )
+		return;
+	// the process runs after the end of the render action
+	processor->setNoProgress();
+	_writeBehindQueue->push( boost::bind( &ImageProcessor::process, processor ), args.time );
 }
 
 void WriterPlugin::render( const OFX::RenderArguments& args )
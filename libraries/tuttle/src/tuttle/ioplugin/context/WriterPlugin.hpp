@@ -4,13 +4,18 @@
 #include <boost/gil/channel_algorithm.hpp> // force to use the boostHack version first
 
 #include "WriterDefinition.hpp"
+#include "WriteBehindQueue.hpp"
 
 #include <tuttle/plugin/ImageEffectGilPlugin.hpp>
+#include <tuttle/plugin/ImageProcessor.hpp>
 
 #include <ofxsImageEffect.h>
 
 #include <Sequence.hpp> // sequenceParser
 
+#include <boost/shared_ptr.hpp>
+#include <boost/scoped_ptr.hpp>
+
 
 namespace tuttle {
 namespace plugin {
@@ -29,6 +34,14 @@ public:
 
 	virtual void beginSequenceRender( const OFX::BeginSequenceRenderArguments& args );
 	virtual void render( const OFX::RenderArguments& args );
+	virtual void endSequenceRender( const OFX::EndSequenceRenderArguments& args );
+
+	/**
+	 * @brief Setup @p processor to write the frame, and process it in the
+	 * write behind queue if there is one, or immediately.
+	 * @see WriteBehind
+	 */
+	void writeBehind( const boost::shared_ptr<ImageProcessor>& processor, const OFX::RenderArguments& args );
 
 protected:
 	inline bool varyOnTime() const { return _isSequence; }
@@ -40,6 +53,8 @@ private:
 	bool _oneRender;
 	OfxTime _oneRenderAtTime;
 
+	boost::scoped_ptr<WriteBehindQueue> _writeBehindQueue; ///< only during a sequence render
+
 public:
 	std::string getAbsoluteFilenameAt( const OfxTime time ) const;
 	std::string getAbsoluteFirstFilename() const;
@@ -62,9 +77,49 @@ public:
 	OFX::BooleanParam*    _paramPremult;
 	OFX::ChoiceParam*     _paramExistingFile;
 	OFX::IntParam*        _paramForceNewRender; ///< Hack parameter, to force a new rendering
+	OFX::IntParam*        _paramWriteBehind; ///< NULL if the writer doesn't use WriteBehind
 	/// @}
 };
 
+/**
+ * @brief Process which encodes and writes the frames in the write behind
+ * queue of the writer.
+ *
+ * The setup of @p WriterProcess, which fetches the images and the parameters,
+ * is done during the render. The process of the images is done later in a
+ * background thread, the images are kept until the end of the write.
+ *
+ * @code
+ * doGilRender<WriteBehind<PngWriterProcess>::Process>( *this, args );
+ * @endcode
+ *
+ * @warning Only for the writers which write a file per frame and don't
+ * modify the state of the plugin during the process.
+ */
+template< template<class> class WriterProcess >
+struct WriteBehind
+{
+	template<class View>
+	class Process
+	{
+	public:
+		template<class Plugin>
+		Process( Plugin& plugin )
+			: _writer( plugin )
+			, _processor( new WriterProcess<View>( plugin ) )
+		{}
+
+		void setupAndProcess( const OFX::RenderArguments& args )
+		{
+			_writer.writeBehind( _processor, args );
+		}
+
+	private:
+		WriterPlugin& _writer;
+		boost::shared_ptr<ImageProcessor> _processor;
+	};
+};
+
 }
 }
 
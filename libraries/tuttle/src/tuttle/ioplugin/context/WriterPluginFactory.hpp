@@ -79,6 +79,24 @@ void describeWriterParamsInContext( OFX::ImageEffectDescriptor& desc,
 	forceNewRender->setDefault( 0 );
 }
 
+/**
+ * @brief Parameter of the writers which can encode the frames in background threads.
+ * @see WriteBehind
+ */
+void describeWriteBehindParamInContext( OFX::ImageEffectDescriptor& desc,
+					OFX::EContext               context )
+{
+	OFX::IntParamDescriptor* writeBehind = desc.defineIntParam( kParamWriterWriteBehind );
+	writeBehind->setLabel( "Write behind" );
+	writeBehind->setHint( "Number of frames encoded and written in background threads, while the next frames are computed.\n"
+	                      "0 writes each frame during its render. Only used if the filename contains a frame pattern." );
+	writeBehind->setRange( 0, 32 );
+	writeBehind->setDisplayRange( 0, 8 );
+	writeBehind->setDefault( 2 );
+	writeBehind->setAnimates( false );
+	writeBehind->setEvaluateOnChange( false );
+}
+
 }
 }
 
@@ -0,0 +1,59 @@
+#include "ImageProcessor.hpp"
+
+#include <tuttle/common/system/cacheInfo.hpp>
+#include <tuttle/common/utils/global.hpp>
+
+#include <cstdlib>
+#include <cstring>
+
+namespace tuttle {
+namespace plugin {
+
+namespace {
+
+EProcessSchedule readDefaultProcessSchedule()
+{
+	const char* envSchedule = std::getenv( "TUTTLE_PROCESS_SCHEDULE" );
+	if( envSchedule == NULL || std::strcmp( envSchedule, "bands" ) == 0 )
+		return eProcessScheduleBands;
+	if( std::strcmp( envSchedule, "blocks" ) == 0 )
+		return eProcessScheduleBlocks;
+	if( std::strcmp( envSchedule, "tiles" ) == 0 )
+		return eProcessScheduleTiles;
+	TUTTLE_LOG_WARNING( "Bad value for TUTTLE_PROCESS_SCHEDULE: \"" << envSchedule << "\"." );
+	return eProcessScheduleBands;
+}
+
+}
+
+EProcessSchedule getDefaultProcessSchedule()
+{
+	static const EProcessSchedule schedule = readDefaultProcessSchedule();
+	return schedule;
+}
+
+void ImageProcessor::initBlocks()
+{
+	_nextBlock.store( 0, boost::memory_order_relaxed );
+
+	// the destination block uses half of the L2 cache, the other half is for the sources
+	static const std::size_t blockBytes = getL2CacheSize() / 2;
+	const std::size_t pixelBytes = ( _dst.get() && _dst->getPixelBytes() ) ? _dst->getPixelBytes() : 16;
+	const unsigned int nbThreads = _nbThreads ? _nbThreads : OFX::MultiThread::getNumCPUs();
+	_blocks.init( _renderArgs.renderWindow, _schedule, pixelBytes, blockBytes, nbThreads );
+}
+
+void ImageProcessor::multiThreadProcessBlocks()
+{
+	const int nbBlocks = _blocks.getNbBlocks();
+	for(;;)
+	{
+		const int block = _nextBlock.fetch_add( 1, boost::memory_order_relaxed );
+		if( block >= nbBlocks )
+			return;
+		multiThreadProcessImages( _blocks.getBlock( block ) );
+	}
+}
+
+}
+}
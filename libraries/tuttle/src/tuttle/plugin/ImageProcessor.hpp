@@ -3,10 +3,12 @@
 
 #include "exceptions.hpp"
 #include "OfxProgress.hpp"
+#include "ProcessBlocks.hpp"
 
 #include <tuttle/plugin/image.hpp>
 #include <tuttle/plugin/exceptions.hpp>
 #include <tuttle/common/math/rectOp.hpp>
+#include <tuttle/common/atomic.hpp>
 
 #include <ofxsImageEffect.h>
 #include <ofxsMultiThread.h>
@@ -23,6 +25,13 @@
 namespace tuttle {
 namespace plugin {
 
+/**
+ * @brief Default schedule of all processors.
+ * Bands of rows, unless the environment variable TUTTLE_PROCESS_SCHEDULE
+ * is set to "bands", "blocks" or "tiles".
+ */
+EProcessSchedule getDefaultProcessSchedule();
+
 /**
  * @brief Base class that can be used to process images of any type.
  */
@@ -41,6 +50,13 @@ protected:
 
 private:
 	unsigned int _nbThreads;
+	EProcessSchedule _schedule;
+
+	/// @group Dynamic schedule: the threads take the next block of the render window
+	/// @{
+	ProcessBlocks _blocks;
+	boost::atomic<int> _nextBlock;
+	/// @}
 
 public:
 	/** @brief ctor */
@@ -49,6 +65,8 @@ public:
 		, _effect( effect )
 		, _imageOrientation( imageOrientation )
 		, _nbThreads( 0 ) // auto, maximum allowable number of CPUs will be used
+		, _schedule( getDefaultProcessSchedule() )
+		, _nextBlock( 0 )
 	{
 		_dstPixelRod.x1 = _dstPixelRod.y1 = _dstPixelRod.x2 = _dstPixelRod.y2 = 0;
 		_dstPixelRodSize.x = _dstPixelRodSize.y = 0;
@@ -68,6 +86,16 @@ public:
 	void setNbThreads( const unsigned int nbThreads ) { _nbThreads = nbThreads; }
 	void setNbThreadsAuto()                           { _nbThreads = 0; }
 
+	/**
+	 * @brief Choose how the render window is split between the threads.
+	 * With the dynamic schedules (blocks and tiles), the size of the blocks
+	 * is chosen to fit in the L2 cache, and the threads take the next block
+	 * as soon as they are free. So the threads stay busy if the process cost
+	 * is not the same on all rows.
+	 */
+	void setProcessSchedule( const EProcessSchedule schedule ) { _schedule = schedule; }
+	EProcessSchedule getProcessSchedule() const { return _schedule; }
+
 	/** @brief called before any MP is done */
 	virtual void preProcess() { progressBegin( _renderWindowSize.y * _renderWindowSize.x ); }
 
@@ -102,8 +130,11 @@ public:
 		_dstPixelRodSize.y = ( this->_dstPixelRod.y2 - this->_dstPixelRod.y1 );
 	}
 
-	/** @brief fetch output and inputs clips */
-	virtual void setupAndProcess( const OFX::RenderArguments& args )
+	/**
+	 * @brief fetch output and inputs clips
+	 * @return false if the host aborted the rendering
+	 */
+	bool setupRender( const OFX::RenderArguments& args )
 	{
 		_renderArgs = args;
 		_renderWindowSize.x = ( _renderArgs.renderWindow.x2 - _renderArgs.renderWindow.x1 );
@@ -119,7 +150,7 @@ public:
 			// if the host is trying to abort the rendering return without error
 			if( _effect.abort() )
 			{
-				return;
+				return false;
 			}
 			throw;
 		}
@@ -130,10 +161,18 @@ public:
 			// if the host is trying to abort the rendering return without error
 			if( _effect.abort() )
 			{
-				return;
+				return false;
 			}
 			throw;
 		}
+		return true;
+	}
+
+	/** @brief fetch output and inputs clips, then process */
+	virtual void setupAndProcess( const OFX::RenderArguments& args )
+	{
+		if( ! setupRender( args ) )
+			return;
 
 		// Call the base class process member
 		this->process();
@@ -142,18 +181,21 @@ public:
 	/** @brief overridden from OFX::MultiThread::Processor. This function is called once on each SMP thread by the base class */
 	void multiThreadFunction( const unsigned int threadId, const unsigned int nThreads )
 	{
-		// slice the y range into the number of threads it has
-		const int dy   = std::abs( _renderArgs.renderWindow.y2 - _renderArgs.renderWindow.y1 );
-		const int y1   = _renderArgs.renderWindow.y1 + threadId * dy / nThreads;
-		const int step = ( threadId + 1 ) * dy / nThreads;
-		const int y2   = _renderArgs.renderWindow.y1 + ( step < dy ? step : dy );
-
-		OfxRectI winRoW = _renderArgs.renderWindow;
-		winRoW.y1 = y1;
-		winRoW.y2 = y2;
-
-		// and render that thread on each
-		multiThreadProcessImages( winRoW );
+		if( _schedule != eProcessScheduleBands && nThreads > 1 )
+		{
+			multiThreadProcessBlocks();
+			return;
+		}
+
+		// render the band of rows of this thread
+		multiThreadProcessImages( ProcessBlocks::getBand( _renderArgs.renderWindow, threadId, nThreads ) );
+	}
+
+	/** @brief overridden from OFX::MultiThread::Processor, to prepare the blocks of the dynamic schedules */
+	void multiThread( const unsigned int nCPUs = 0 )
+	{
+		initBlocks();
+		OFX::MultiThread::Processor::multiThread( nCPUs );
 	}
 
 	/** @brief this is called by multiThreadFunction to actually process images, override in derived classes */
@@ -183,6 +225,12 @@ public:
 		// call the post MP pass
 		postProcess();
 	}
+
+private:
+	/// @brief Split the render window into blocks for the dynamic schedules.
+	void initBlocks();
+	/// @brief Process the next free blocks until the end of the render window.
+	void multiThreadProcessBlocks();
 };
 
 
@@ -15,6 +15,8 @@ void OfxProgress::progressBegin( const int numSteps, const std::string& msg )
 {
 	_counter = 0.0;
 	_stepSize = 1.0 / static_cast<double>( numSteps );
+	if( ! _progressEnabled )
+		return;
 	_effect.progressStart( msg );
 }
 
@@ -29,6 +31,8 @@ void OfxProgress::progressBegin( const int numSteps, const std::string& msg )
  */
 bool OfxProgress::progressForward( const int nSteps )
 {
+	if( ! _progressEnabled )
+		return false;
 	_mutex.lock();
 	_counter += _stepSize * static_cast<double>( nSteps );
 	/// @todo why not unlock the mutex here?
@@ -45,6 +49,8 @@ bool OfxProgress::progressForward( const int nSteps )
 
 bool OfxProgress::progressUpdate( const double p )
 {
+	if( ! _progressEnabled )
+		return false;
 	if( _effect.abort() )
 	{
 		return true;
@@ -59,6 +65,8 @@ bool OfxProgress::progressUpdate( const double p )
  */
 void OfxProgress::progressEnd()
 {
+	if( ! _progressEnabled )
+		return;
 	// Wait for the end
 	_mutex.lock();
 	_mutex.unlock();
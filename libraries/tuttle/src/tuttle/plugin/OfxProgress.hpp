@@ -24,6 +24,7 @@ class OfxProgress : public IProgress
 private:
 	OFX::ImageEffect& _effect; ///< Used to access Ofx progress bar
 	OFX::MultiThread::Mutex _mutex;
+	bool _progressEnabled;
 	OfxProgress& operator=( const OfxProgress& p );
 
 protected:
@@ -34,6 +35,7 @@ public:
 	OfxProgress( OFX::ImageEffect& effect )
 	: _effect( effect )
 	, _mutex( 0 )
+	, _progressEnabled( true )
 	, _stepSize( 0 )
 	, _counter( 0 )
 	{}
@@ -45,6 +47,12 @@ public:
 	bool progressForward( const int nSteps );
 	
 	bool progressUpdate( const double p );
+
+	/**
+	 * @brief Don't report the progress to the host,
+	 * for a process which runs after the end of the render action.
+	 */
+	void setNoProgress() { _progressEnabled = false; }
 	
 	OfxProgress& getOfxProgress() { return *this; }
 };
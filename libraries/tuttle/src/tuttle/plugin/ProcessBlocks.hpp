@@ -0,0 +1,110 @@
+#ifndef _TUTTLE_PLUGIN_PROCESSBLOCKS_HPP_
+#define _TUTTLE_PLUGIN_PROCESSBLOCKS_HPP_
+
+#include <ofxCore.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+
+namespace tuttle {
+namespace plugin {
+
+/**
+ * @brief How the render window is split between the threads.
+ */
+enum EProcessSchedule
+{
+	eProcessScheduleBands,  ///< one band of rows per thread
+	eProcessScheduleBlocks, ///< small blocks of rows, taken by each thread as soon as it is free
+	eProcessScheduleTiles   ///< small 2D tiles, taken by each thread as soon as it is free
+};
+
+/**
+ * @brief Split of a render window into the blocks of a dynamic schedule.
+ */
+class ProcessBlocks
+{
+public:
+	ProcessBlocks()
+	{
+		_window.x1 = _window.y1 = _window.x2 = _window.y2 = 0;
+		_blockSize.x = _blockSize.y = 0;
+		_nbBlocks.x = _nbBlocks.y = 0;
+	}
+
+	/**
+	 * @brief Split @p window into blocks of about @p blockBytes, with at least 4 blocks per thread.
+	 * There is no block with the bands schedule.
+	 */
+	void init( const OfxRectI& window, const EProcessSchedule schedule, const std::size_t pixelBytes, const std::size_t blockBytes, const unsigned int nbThreads )
+	{
+		_window = window;
+		_blockSize.x = _blockSize.y = 0;
+		_nbBlocks.x = _nbBlocks.y = 0;
+
+		const int width  = window.x2 - window.x1;
+		const int height = window.y2 - window.y1;
+		if( schedule == eProcessScheduleBands || width <= 0 || height <= 0 )
+			return;
+
+		const std::size_t blockPixels = std::max( std::size_t(1), blockBytes / std::max( std::size_t(1), pixelBytes ) );
+		if( schedule == eProcessScheduleTiles )
+		{
+			// square tiles, with a width multiple of 16 pixels
+			int side = static_cast<int>( std::sqrt( static_cast<double>( blockPixels ) ) );
+			side = std::max( 16, side - side % 16 );
+			_blockSize.x = std::min( width, side );
+		}
+		else
+		{
+			_blockSize.x = width;
+		}
+		_blockSize.y = std::max( 1, static_cast<int>( blockPixels / _blockSize.x ) );
+		_nbBlocks.x = ( width + _blockSize.x - 1 ) / _blockSize.x;
+
+		// enough blocks to balance the work between the threads
+		const int minNbRows = ( 4 * static_cast<int>( std::max( 1u, nbThreads ) ) + _nbBlocks.x - 1 ) / _nbBlocks.x;
+		_blockSize.y = std::max( 1, std::min( _blockSize.y, height / minNbRows ) );
+		_nbBlocks.y = ( height + _blockSize.y - 1 ) / _blockSize.y;
+	}
+
+	int getNbBlocks() const { return _nbBlocks.x * _nbBlocks.y; }
+
+	/// @param block index in [0, getNbBlocks())
+	OfxRectI getBlock( const int block ) const
+	{
+		OfxRectI blockRoW;
+		blockRoW.x1 = _window.x1 + ( block % _nbBlocks.x ) * _blockSize.x;
+		blockRoW.y1 = _window.y1 + ( block / _nbBlocks.x ) * _blockSize.y;
+		blockRoW.x2 = std::min( _window.x2, blockRoW.x1 + _blockSize.x );
+		blockRoW.y2 = std::min( _window.y2, blockRoW.y1 + _blockSize.y );
+		return blockRoW;
+	}
+
+	/// @brief Band of rows of @p window processed by the thread @p threadId with the bands schedule.
+	static OfxRectI getBand( const OfxRectI& window, const unsigned int threadId, const unsigned int nbThreads )
+	{
+		// slice the y range into the number of threads
+		const int dy   = std::abs( window.y2 - window.y1 );
+		const int y1   = window.y1 + threadId * dy / nbThreads;
+		const int step = ( threadId + 1 ) * dy / nbThreads;
+		const int y2   = window.y1 + ( step < dy ? step : dy );
+
+		OfxRectI band = window;
+		band.y1 = y1;
+		band.y2 = y2;
+		return band;
+	}
+
+private:
+	OfxRectI _window;
+	OfxPointI _blockSize;
+	OfxPointI _nbBlocks;
+};
+
+}
+}
+
+#endif
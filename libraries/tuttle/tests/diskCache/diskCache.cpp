@@ -0,0 +1,55 @@
+#define BOOST_TEST_MODULE tuttle_diskCache
+#include <tuttle/test/main.hpp>
+
+#include <tuttle/host/Core.hpp>
+#include <tuttle/host/diskCache/RenderDiskCache.hpp>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <cstring>
+
+using namespace boost::unit_test;
+using namespace tuttle::host;
+
+BOOST_AUTO_TEST_SUITE( diskCache_tests_suite01 )
+
+BOOST_AUTO_TEST_CASE( renderDiskCache )
+{
+	RenderDiskCache cache;
+	cache.setRootDir( boost::filesystem::temp_directory_path() / boost::filesystem::unique_path( "tuttleRenderCache-%%%%-%%%%" ) );
+	const OfxRectD bounds = { 0, 0, 10, 10 };
+	const OfxRectD otherBounds = { 0, 0, 20, 10 };
+
+	memory::IPoolDataPtr data = core().getMemoryPool().allocate( 10000 );
+	for( std::size_t i = 0; i < data->size(); ++i )
+		data->data()[i] = static_cast<char>( i % 7 );
+
+	BOOST_CHECK( ! cache.get( 1, bounds, 10000 ) );
+
+	cache.put( 1, bounds, *data );
+	cache.setCompression();
+	cache.put( 2, bounds, *data );
+
+	BOOST_CHECK( cache.contains( 1, bounds ) );
+	BOOST_CHECK( ! cache.contains( 1, otherBounds ) );
+	BOOST_CHECK( ! cache.get( 3, bounds, 10000 ) );
+
+	// an entry with another size, like another row alignment, is not reused
+	BOOST_CHECK( ! cache.get( 1, bounds, 10240 ) );
+	BOOST_CHECK( ! cache.get( 2, bounds, 10240 ) );
+
+	const memory::IPoolDataPtr raw = cache.get( 1, bounds, 10000 );
+	BOOST_REQUIRE( raw );
+	BOOST_CHECK_EQUAL( data->size(), raw->size() );
+	BOOST_CHECK( std::memcmp( data->data(), raw->data(), data->size() ) == 0 );
+
+	const memory::IPoolDataPtr compressed = cache.get( 2, bounds, 10000 );
+	BOOST_REQUIRE( compressed );
+	BOOST_CHECK_EQUAL( data->size(), compressed->size() );
+	BOOST_CHECK( std::memcmp( data->data(), compressed->data(), data->size() ) == 0 );
+
+	cache.clear();
+	BOOST_CHECK( ! cache.contains( 1, bounds ) );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -3,6 +3,18 @@
 
 #include <tuttle/host/Graph.hpp>
 #include <tuttle/host/Node.hpp>
+#include <tuttle/host/Core.hpp>
+#include <tuttle/host/RenderProfile.hpp>
+#include <tuttle/host/memory/MemoryCache.hpp>
+#include <tuttle/host/attribute/Image.hpp>
+
+#include <boost/foreach.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
+
+#include <cstring>
+#include <sstream>
+#include <map>
 
 #include <iostream>
 
@@ -229,5 +241,143 @@ BOOST_AUTO_TEST_CASE( graph_compute )
 	TUTTLE_LOG_INFO( "----------------- DONE -----------------" );
 }
 
+BOOST_AUTO_TEST_CASE( graph_tiled_render )
+{
+	TUTTLE_LOG_INFO( "--> TILED RENDER" );
+	const std::vector<NodeInit> nodes = list_of
+		( NodeInit("tuttle.checkerboard")
+			.setParam("size", 301, 203) )
+		( NodeInit("tuttle.invert") );
+
+	memory::MemoryCache outputCache;
+	BOOST_REQUIRE( compute( outputCache, nodes ) );
+
+	memory::MemoryCache tiledOutputCache;
+	ComputeOptions options;
+	options.setTileSize( 64, 64 );
+	BOOST_REQUIRE( compute( tiledOutputCache, nodes, options ) );
+
+	BOOST_REQUIRE_EQUAL( outputCache.size(), 1U );
+	BOOST_REQUIRE_EQUAL( tiledOutputCache.size(), 1U );
+	memory::CACHE_ELEMENT image = outputCache.get( 0 );
+	memory::CACHE_ELEMENT tiledImage = tiledOutputCache.get( 0 );
+	BOOST_REQUIRE_EQUAL( image->getMemorySize(), tiledImage->getMemorySize() );
+	BOOST_CHECK( std::memcmp( image->getPixelData(), tiledImage->getPixelData(), image->getMemorySize() ) == 0 );
+	TUTTLE_LOG_INFO( "----------------- DONE -----------------" );
+}
+
+BOOST_AUTO_TEST_CASE( graph_tiled_render_with_node_output_cache )
+{
+	TUTTLE_LOG_INFO( "--> TILED RENDER WITH NODE OUTPUT CACHE" );
+	const std::vector<NodeInit> nodes = list_of
+		( NodeInit("tuttle.checkerboard")
+			.setParam("size", 301, 203) )
+		( NodeInit("tuttle.invert") );
+
+	memory::NodeOutputCache& nodeOutputCache = core().getNodeOutputCache();
+	nodeOutputCache.setMaxMemorySize( 64 * 1024 * 1024 );
+
+	// the full images of the nodes are in the cache after this render
+	memory::MemoryCache outputCache;
+	BOOST_REQUIRE( compute( outputCache, nodes ) );
+	const std::size_t nbCachedOutputs = nodeOutputCache.size();
+
+	// the tiles don't reuse these images, and are not put into the cache
+	memory::MemoryCache tiledOutputCache;
+	ComputeOptions options;
+	options.setTileSize( 64, 64 );
+	BOOST_REQUIRE( compute( tiledOutputCache, nodes, options ) );
+	BOOST_CHECK_EQUAL( nodeOutputCache.size(), nbCachedOutputs );
+
+	nodeOutputCache.setMaxMemorySize( 0 );
+
+	BOOST_REQUIRE_EQUAL( outputCache.size(), 1U );
+	BOOST_REQUIRE_EQUAL( tiledOutputCache.size(), 1U );
+	memory::CACHE_ELEMENT image = outputCache.get( 0 );
+	memory::CACHE_ELEMENT tiledImage = tiledOutputCache.get( 0 );
+	BOOST_REQUIRE_EQUAL( image->getMemorySize(), tiledImage->getMemorySize() );
+	BOOST_CHECK( std::memcmp( image->getPixelData(), tiledImage->getPixelData(), image->getMemorySize() ) == 0 );
+	TUTTLE_LOG_INFO( "----------------- DONE -----------------" );
+}
+
+BOOST_AUTO_TEST_CASE( graph_parallel_nodes )
+{
+	TUTTLE_LOG_INFO( "--> PARALLEL NODES" );
+	Graph g;
+	Graph::Node& checker1 = g.addNode( NodeInit("tuttle.checkerboard").setParam("size", 301, 203) );
+	Graph::Node& checker2 = g.addNode( NodeInit("tuttle.checkerboard").setParam("size", 301, 203).setParam("boxes", 7, 5) );
+	Graph::Node& invert1 = g.createNode( "tuttle.invert" );
+	Graph::Node& invert2 = g.createNode( "tuttle.invert" );
+	Graph::Node& invert3 = g.createNode( "tuttle.invert" );
+	Graph::Node& merge1 = g.createNode( "tuttle.merge" );
+
+	// two independent branches
+	g.connect( checker1, invert1 );
+	g.connect( invert1, invert2 );
+	g.connect( checker2, invert3 );
+	g.connect( invert2, merge1.getAttribute( "A" ) );
+	g.connect( invert3, merge1.getAttribute( "B" ) );
+
+	memory::MemoryCache outputCache;
+	BOOST_REQUIRE( g.compute( outputCache, merge1 ) );
+
+	memory::MemoryCache parallelOutputCache;
+	ComputeOptions options;
+	options.setNbParallelNodes( 4 );
+	BOOST_REQUIRE( g.compute( parallelOutputCache, merge1, options ) );
+
+	BOOST_REQUIRE_EQUAL( outputCache.size(), 1U );
+	BOOST_REQUIRE_EQUAL( parallelOutputCache.size(), 1U );
+	memory::CACHE_ELEMENT image = outputCache.get( 0 );
+	memory::CACHE_ELEMENT parallelImage = parallelOutputCache.get( 0 );
+	BOOST_REQUIRE_EQUAL( image->getMemorySize(), parallelImage->getMemorySize() );
+	BOOST_CHECK( std::memcmp( image->getPixelData(), parallelImage->getPixelData(), image->getMemorySize() ) == 0 );
+	TUTTLE_LOG_INFO( "----------------- DONE -----------------" );
+}
+
+BOOST_AUTO_TEST_CASE( graph_render_profile )
+{
+	TUTTLE_LOG_INFO( "--> RENDER PROFILE" );
+	Graph g;
+	Graph::Node& checker = g.addNode( NodeInit("tuttle.checkerboard").setParam("size", 301, 203) );
+	Graph::Node& invert = g.createNode( "tuttle.invert" );
+	g.connect( checker, invert );
+
+	memory::MemoryCache outputCache;
+	ComputeOptions options;
+	options.setTimeRange( 0, 2 );
+	options.setProfiling();
+	BOOST_REQUIRE( g.compute( outputCache, invert, options ) );
+
+	// one event of each phase by frame, one process event by node and by frame
+	const boost::shared_ptr<RenderProfile> profile = options.getRenderProfile();
+	BOOST_REQUIRE( profile );
+	std::map<std::string, std::size_t> nbEvents;
+	BOOST_FOREACH( const RenderProfile::Event& event, profile->getEvents() )
+	{
+		++nbEvents[event._phase];
+		BOOST_CHECK_GE( event._duration, 0 );
+	}
+	BOOST_CHECK_EQUAL( nbEvents.size(), 4U );
+	BOOST_CHECK_EQUAL( nbEvents["frame"], 3U );
+	BOOST_CHECK_EQUAL( nbEvents["setup"], 3U );
+	BOOST_CHECK_EQUAL( nbEvents["regionsOfInterest"], 3U );
+	BOOST_CHECK_EQUAL( nbEvents["process"], 6U );
+
+	std::stringstream json;
+	profile->exportJson( json );
+	boost::property_tree::ptree jsonTree;
+	BOOST_REQUIRE_NO_THROW( boost::property_tree::read_json( json, jsonTree ) );
+	BOOST_CHECK_EQUAL( jsonTree.get_child( "events" ).size(), profile->getNbEvents() );
+	BOOST_CHECK_EQUAL( jsonTree.get_child( "nodes" ).size(), 2U );
+
+	std::stringstream chromeTrace;
+	profile->exportChromeTrace( chromeTrace );
+	boost::property_tree::ptree chromeTraceTree;
+	BOOST_REQUIRE_NO_THROW( boost::property_tree::read_json( chromeTrace, chromeTraceTree ) );
+	BOOST_CHECK_EQUAL( chromeTraceTree.get_child( "traceEvents" ).size(), profile->getNbEvents() );
+	TUTTLE_LOG_INFO( "----------------- DONE -----------------" );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -4,8 +4,13 @@
 // custom host
 #include <tuttle/host/memory/MemoryPool.hpp>
 #include <tuttle/host/memory/MemoryCache.hpp>
+#include <tuttle/host/memory/NodeOutputCache.hpp>
+#include <tuttle/host/memory/BufferAllocator.hpp>
+#include <tuttle/host/memory/ScratchMemory.hpp>
+#include <tuttle/host/Core.hpp>
 
 #include <iostream>
+#include <vector>
 
 using namespace boost::unit_test;
 using namespace std;
@@ -107,6 +112,139 @@ BOOST_AUTO_TEST_CASE( memoryPool )
 	}
 }
 
+BOOST_AUTO_TEST_CASE( memoryPoolBestFit )
+{
+	memory::MemoryPool pool( 1000 );
+	{
+		// fill the pool with buffers of different sizes
+		std::vector<memory::IPoolDataPtr> datas;
+		for( std::size_t size = 10; size <= 100; size += 10 )
+			datas.push_back( pool.allocate( size ) );
+		BOOST_CHECK_EQUAL( 550U, pool.getUsedMemorySize() );
+		BOOST_CHECK_EQUAL( 10U, pool.getDataUsedSize() );
+	}
+	BOOST_CHECK_EQUAL( 0U, pool.getUsedMemorySize() );
+	BOOST_CHECK_EQUAL( 550U, pool.getAllocatedAndUnusedMemorySize() );
+	BOOST_CHECK_EQUAL( 10U, pool.getDataUnusedSize() );
+	{
+		// the smallest buffer big enough is reused
+		const memory::IPoolDataPtr pData1 = pool.allocate( 45 );
+		BOOST_CHECK_EQUAL( 50U, pData1->reservedSize() );
+		const memory::IPoolDataPtr pData2 = pool.allocate( 45 );
+		BOOST_CHECK_EQUAL( 60U, pData2->reservedSize() );
+		BOOST_CHECK_EQUAL( 110U, pool.getUsedMemorySize() );
+		BOOST_CHECK_EQUAL( 20U, pool.getWastedMemorySize() );
+		BOOST_CHECK_EQUAL( 550U, pool.getAllocatedMemorySize() );
+	}
+	BOOST_CHECK_EQUAL( 0U, pool.getWastedMemorySize() );
+}
+
+BOOST_AUTO_TEST_CASE( bufferAllocator )
+{
+	// small buffers are aligned on the requested alignment
+	char* small = memory::allocateBuffer( 100, 64, false );
+	BOOST_CHECK_EQUAL( 0U, reinterpret_cast<std::size_t>( small ) % 64 );
+	memory::freeBuffer( small, 100 );
+
+	// big buffers are mapped, so zero on the first use
+	const std::size_t bigSize = memory::getBufferMappingThreshold() + 10;
+	char* big = memory::allocateBuffer( bigSize, 64, true );
+	BOOST_CHECK_EQUAL( 0U, reinterpret_cast<std::size_t>( big ) % 64 );
+	BOOST_CHECK_EQUAL( 0, big[0] );
+	BOOST_CHECK_EQUAL( 0, big[bigSize-1] );
+	memory::freeBuffer( big, bigSize );
+}
+
+BOOST_AUTO_TEST_CASE( scratchMemory )
+{
+	memory::IMemoryPool& pool = core().getMemoryPool();
+	const std::size_t usedSize = pool.getUsedMemorySize();
+
+	// small buffers are reused from the arena of the thread
+	char* small = memory::allocateScratch( 100 );
+	memory::freeScratch( small );
+	BOOST_CHECK_EQUAL( static_cast<void*>( small ), static_cast<void*>( memory::allocateScratch( 120 ) ) );
+	memory::freeScratch( small );
+	BOOST_CHECK_EQUAL( usedSize, pool.getUsedMemorySize() );
+
+	// big buffers are counted in the MemoryPool
+	const std::size_t bigSize = memory::getScratchPoolThreshold() * 2;
+	char* big = memory::allocateScratch( bigSize );
+	BOOST_CHECK_EQUAL( 0U, reinterpret_cast<std::size_t>( big ) % 64 );
+	BOOST_CHECK( pool.getUsedMemorySize() >= usedSize + bigSize );
+	memory::freeScratch( big );
+	BOOST_CHECK_EQUAL( usedSize, pool.getUsedMemorySize() );
+}
+
+BOOST_AUTO_TEST_CASE( memoryPoolLeastRecentlyUsed )
+{
+	memory::MemoryPool pool( 100 );
+	{
+		const memory::IPoolDataPtr pData10 = pool.allocate( 10 );
+		const memory::IPoolDataPtr pData20 = pool.allocate( 20 );
+		const memory::IPoolDataPtr pData30 = pool.allocate( 30 );
+	}
+	// released in the order: 30, 20, 10
+	BOOST_CHECK_EQUAL( 60U, pool.getAllocatedAndUnusedMemorySize() );
+
+	// free the least recently used buffer
+	pool.clearOne();
+	BOOST_CHECK_EQUAL( 30U, pool.getAllocatedMemorySize() );
+
+	// free only what is needed
+	pool.clear( 15 );
+	BOOST_CHECK_EQUAL( 10U, pool.getAllocatedMemorySize() );
+	BOOST_CHECK_EQUAL( 1U, pool.getDataUnusedSize() );
+
+	{
+		const memory::IPoolDataPtr pData = pool.allocate( 80 );
+		BOOST_CHECK_EQUAL( 90U, pool.getAllocatedMemorySize() );
+	}
+	{
+		// not enough memory to keep all the unused buffers,
+		// the least recently used is freed
+		const memory::IPoolDataPtr pData = pool.allocate( 15 );
+		BOOST_CHECK_EQUAL( 15U, pData->reservedSize() );
+		BOOST_CHECK_EQUAL( 95U, pool.getAllocatedMemorySize() );
+		BOOST_CHECK_EQUAL( 80U, pool.getAllocatedAndUnusedMemorySize() );
+	}
+}
+
+BOOST_AUTO_TEST_CASE( nodeOutputCache )
+{
+	memory::MemoryPool pool( 100 );
+	memory::NodeOutputCache cache( 50 );
+	const OfxRectD bounds = { 0, 0, 10, 10 };
+	const OfxRectD otherBounds = { 0, 0, 20, 10 };
+
+	cache.put( 1, bounds, pool.allocate( 20 ) );
+	cache.put( 2, bounds, pool.allocate( 20 ) );
+	BOOST_CHECK_EQUAL( 40U, cache.getMemorySize() );
+	// the cache keeps the buffers used
+	BOOST_CHECK_EQUAL( 40U, pool.getUsedMemorySize() );
+
+	BOOST_CHECK( cache.get( 1, bounds ) );
+	BOOST_CHECK( ! cache.get( 1, otherBounds ) );
+	BOOST_CHECK( ! cache.get( 3, bounds ) );
+
+	// over the max size, the least recently used buffer (2) is removed
+	cache.put( 3, bounds, pool.allocate( 20 ) );
+	BOOST_CHECK_EQUAL( 2U, cache.size() );
+	BOOST_CHECK( cache.get( 1, bounds ) );
+	BOOST_CHECK( ! cache.get( 2, bounds ) );
+	BOOST_CHECK_EQUAL( 40U, pool.getUsedMemorySize() );
+
+	// too big to be cached
+	cache.put( 4, bounds, pool.allocate( 60 ) );
+	BOOST_CHECK( ! cache.get( 4, bounds ) );
+
+	BOOST_CHECK_EQUAL( 20U, cache.clear( 10 ) );
+	BOOST_CHECK_EQUAL( 1U, cache.size() );
+	cache.setMaxMemorySize( 0 );
+	BOOST_CHECK_EQUAL( 0U, cache.size() );
+	BOOST_CHECK_EQUAL( 0U, pool.getUsedMemorySize() );
+}
+
 BOOST_AUTO_TEST_CASE( memoryCache )
 {
 	memory::MemoryCache cache;
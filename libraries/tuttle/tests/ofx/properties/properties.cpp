@@ -5,6 +5,7 @@
 #include <tuttle/host/Core.hpp>
 
 #include <iostream>
+#include <cstring>
 
 using namespace boost::unit_test;
 
@@ -94,5 +95,51 @@ BOOST_AUTO_TEST_CASE( properties_get_and_set )
 	//	bool sequential = descriptor.getProperties().getIntProperty( kOfxImageEffectInstancePropSequentialRender ) != 0;
 }
 
+BOOST_AUTO_TEST_CASE( properties_fetch_by_plugin_name )
+{
+	using namespace std;
+	using namespace tuttle::host;
+
+	static const ofx::property::OfxhPropSpec chainedStuff[] = {
+		{ "testChained", ofx::property::ePropTypeInt, 1, false, "3" },
+		{ 0 }
+	};
+	static const ofx::property::OfxhPropSpec testStuff[] = {
+		{ "testDouble", ofx::property::ePropTypeDouble, 1, false, "1.5" },
+		{ "testInt", ofx::property::ePropTypeInt, 1, false, "2" },
+		{ 0 }
+	};
+	ofx::property::OfxhSet chainedSet( chainedStuff );
+	ofx::property::OfxhSet testSet( testStuff );
+	testSet.setChainedSet( &chainedSet );
+
+	// names given by a plugin, read through the cache
+	BOOST_CHECK_EQUAL( testSet.fetchTypedProperty<ofx::property::Double>( "testDouble" ).getValue( 0 ), 1.5 );
+	BOOST_CHECK_EQUAL( testSet.fetchTypedProperty<ofx::property::Int>( "testInt" ).getValue( 0 ), 2 );
+	BOOST_CHECK_EQUAL( testSet.fetchTypedProperty<ofx::property::Int>( "testChained" ).getValue( 0 ), 3 );
+	BOOST_CHECK_THROW( testSet.fetchLocalProperty( "testChained" ), ofx::OfxhException );
+
+	// the same buffer with another name
+	char name[16];
+	std::strcpy( name, "testDouble" );
+	BOOST_CHECK_EQUAL( testSet.fetchProperty( static_cast<const char*>( name ) ).getName(), "testDouble" );
+	std::strcpy( name, "testInt" );
+	BOOST_CHECK_EQUAL( testSet.fetchProperty( static_cast<const char*>( name ) ).getName(), "testInt" );
+
+	// the index follows the changes of the set
+	testSet.eraseProperty( "testInt" );
+	BOOST_CHECK( ! testSet.hasProperty( "testInt" ) );
+	BOOST_CHECK_THROW( testSet.fetchProperty( static_cast<const char*>( name ) ), ofx::OfxhException );
+	BOOST_CHECK_EQUAL( testSet.getDoubleProperty( "testDouble" ), 1.5 );
+
+	ofx::property::OfxhSet copySet( testSet );
+	copySet.setDoubleProperty( "testDouble", 2.5 );
+	BOOST_CHECK_EQUAL( copySet.fetchTypedProperty<ofx::property::Double>( "testDouble" ).getValue( 0 ), 2.5 );
+	BOOST_CHECK_EQUAL( testSet.fetchTypedProperty<ofx::property::Double>( "testDouble" ).getValue( 0 ), 1.5 );
+
+	testSet.clear();
+	BOOST_CHECK_THROW( testSet.fetchLocalProperty( "testDouble" ), ofx::OfxhException );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
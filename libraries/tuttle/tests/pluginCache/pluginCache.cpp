@@ -0,0 +1,140 @@
+#define BOOST_TEST_MODULE plugin_cache_tests
+#include <tuttle/test/main.hpp>
+
+#include <tuttle/common/utils/global.hpp>
+#include <tuttle/host/Core.hpp>
+#include <tuttle/host/PluginCacheFile.hpp>
+#include <tuttle/host/ofx/OfxhImageEffectPlugin.hpp>
+
+#include <boost/archive/xml_oarchive.hpp>
+#include <boost/archive/xml_iarchive.hpp>
+#include <boost/serialization/serialization.hpp>
+#include <boost/serialization/nvp.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/timer/timer.hpp>
+#include <boost/foreach.hpp>
+
+#include <fstream>
+#include <string>
+#include <set>
+
+using namespace boost::unit_test;
+using namespace tuttle::host;
+
+namespace {
+
+/// An empty plugin cache, like the cache of the core before the preload.
+void initPluginCache( ofx::OfxhPluginCache& pluginCache )
+{
+	pluginCache.setCacheVersion( core().getPluginCache().getCacheVersion() );
+	pluginCache.registerAPICache( core().getImageEffectPluginCache() );
+}
+
+ofx::imageEffect::OfxhImageEffectPlugin* findPlugin( const ofx::OfxhPluginCache& pluginCache, const std::string& id )
+{
+	BOOST_FOREACH( ofx::OfxhPlugin* plugin, pluginCache.getPlugins() )
+	{
+		if( plugin->getIdentifier() == id )
+			return dynamic_cast<ofx::imageEffect::OfxhImageEffectPlugin*>( plugin );
+	}
+	return NULL;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE( plugin_cache_tests_suite01 )
+
+BOOST_AUTO_TEST_CASE( plugin_cache_binary_file )
+{
+	const std::string cacheFile = ( core().getPreferences().buildTuttleTestPath() / "test_pluginCache.bin" ).string();
+	writePluginCacheFile( cacheFile, core().getPluginCache() );
+
+	ofx::OfxhPluginCache pluginCache;
+	initPluginCache( pluginCache );
+	BOOST_REQUIRE( readPluginCacheFile( cacheFile, pluginCache ) );
+
+	std::set<std::string> ids;
+	BOOST_FOREACH( ofx::OfxhPlugin* plugin, pluginCache.getPlugins() )
+	{
+		ids.insert( plugin->getIdentifier() );
+	}
+	BOOST_FOREACH( ofx::OfxhPlugin* plugin, core().getPluginCache().getPlugins() )
+	{
+		BOOST_CHECK( ids.find( plugin->getIdentifier() ) != ids.end() );
+	}
+
+	// the descriptor is deserialized when it is used
+	ofx::imageEffect::OfxhImageEffectPlugin* invert = findPlugin( pluginCache, "tuttle.invert" );
+	BOOST_REQUIRE( invert != NULL );
+	BOOST_CHECK( *invert == *core().getImageEffectPluginById( "tuttle.invert" ) );
+
+	// a cache file with another version is not read
+	ofx::OfxhPluginCache otherVersionCache;
+	initPluginCache( otherVersionCache );
+	otherVersionCache.setCacheVersion( "otherVersion" );
+	BOOST_CHECK( ! readPluginCacheFile( cacheFile, otherVersionCache ) );
+	BOOST_CHECK( otherVersionCache.getPlugins().empty() );
+
+	boost::filesystem::remove( cacheFile );
+}
+
+/**
+ * Time to read the plugins cache at startup, with the former xml archive
+ * and with the binary cache file (before and after the load of all the descriptors).
+ */
+BOOST_AUTO_TEST_CASE( plugin_cache_startup_benchmark )
+{
+	const std::string xmlCacheFile = ( core().getPreferences().buildTuttleTestPath() / "test_pluginCache.xml" ).string();
+	const std::string binaryCacheFile = ( core().getPreferences().buildTuttleTestPath() / "test_pluginCache.bin" ).string();
+	{
+		std::ofstream ofsb( xmlCacheFile.c_str() );
+		boost::archive::xml_oarchive oArchive( ofsb );
+		oArchive << boost::serialization::make_nvp( "_pluginCache", core().getPluginCache() );
+	}
+	writePluginCacheFile( binaryCacheFile, core().getPluginCache() );
+
+	const std::size_t nbPlugins = core().getPluginCache().getPlugins().size();
+	const int nbIterations = 5;
+	boost::timer::nanosecond_type xmlTime = 0;
+	boost::timer::nanosecond_type binaryTime = 0;
+	boost::timer::nanosecond_type descriptorsTime = 0;
+
+	for( int i = 0; i < nbIterations; ++i )
+	{
+		{
+			ofx::OfxhPluginCache pluginCache;
+			initPluginCache( pluginCache );
+			boost::timer::cpu_timer timer;
+			std::ifstream ifsb( xmlCacheFile.c_str() );
+			boost::archive::xml_iarchive iArchive( ifsb );
+			iArchive >> boost::serialization::make_nvp( "_pluginCache", pluginCache );
+			xmlTime += timer.elapsed().wall;
+			BOOST_CHECK_GE( pluginCache.getPlugins().size(), nbPlugins );
+		}
+		{
+			ofx::OfxhPluginCache pluginCache;
+			initPluginCache( pluginCache );
+			boost::timer::cpu_timer timer;
+			BOOST_REQUIRE( readPluginCacheFile( binaryCacheFile, pluginCache ) );
+			binaryTime += timer.elapsed().wall;
+			BOOST_CHECK_GE( pluginCache.getPlugins().size(), nbPlugins );
+
+			timer.start();
+			BOOST_FOREACH( ofx::OfxhPlugin* plugin, pluginCache.getPlugins() )
+			{
+				dynamic_cast<ofx::imageEffect::OfxhImageEffectPlugin&>( *plugin ).getDescriptor();
+			}
+			descriptorsTime += timer.elapsed().wall;
+		}
+	}
+
+	TUTTLE_LOG_INFO( "[Plugin cache] " << nbPlugins << " plugins, xml file: " << boost::filesystem::file_size( xmlCacheFile ) << " bytes, binary file: " << boost::filesystem::file_size( binaryCacheFile ) << " bytes" );
+	TUTTLE_LOG_INFO( "[Plugin cache] xml read: " << xmlTime / nbIterations / 1000 << " us" );
+	TUTTLE_LOG_INFO( "[Plugin cache] binary read: " << binaryTime / nbIterations / 1000 << " us" );
+	TUTTLE_LOG_INFO( "[Plugin cache] binary read of all the descriptors: " << descriptorsTime / nbIterations / 1000 << " us" );
+
+	boost::filesystem::remove( xmlCacheFile );
+	boost::filesystem::remove( binaryCacheFile );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,140 @@
+#define BOOST_TEST_MODULE tuttle_processSchedule
+#include <tuttle/test/main.hpp>
+
+#include <tuttle/plugin/ProcessBlocks.hpp>
+
+#include <boost/foreach.hpp>
+
+#include <vector>
+
+using namespace boost::unit_test;
+using namespace tuttle::plugin;
+
+namespace {
+
+/// Number of times each pixel of a window is rendered.
+class Coverage
+{
+public:
+	Coverage( const OfxRectI& window )
+		: _window( window )
+		, _width( window.x2 - window.x1 )
+		, _counts( ( window.x2 - window.x1 ) * ( window.y2 - window.y1 ), 0 )
+	{}
+
+	void add( const OfxRectI& roW )
+	{
+		BOOST_REQUIRE( roW.x1 >= _window.x1 && roW.x2 <= _window.x2 );
+		BOOST_REQUIRE( roW.y1 >= _window.y1 && roW.y2 <= _window.y2 );
+		for( int y = roW.y1; y < roW.y2; ++y )
+		{
+			for( int x = roW.x1; x < roW.x2; ++x )
+			{
+				++_counts[( y - _window.y1 ) * _width + ( x - _window.x1 )];
+			}
+		}
+	}
+
+	/// @return the number of pixels not rendered exactly once
+	std::size_t nbErrors() const
+	{
+		std::size_t nbErrors = 0;
+		BOOST_FOREACH( const int count, _counts )
+		{
+			if( count != 1 )
+				++nbErrors;
+		}
+		return nbErrors;
+	}
+
+private:
+	OfxRectI _window;
+	int _width;
+	std::vector<int> _counts;
+};
+
+OfxRectI makeRect( const int x1, const int y1, const int x2, const int y2 )
+{
+	OfxRectI rect = { x1, y1, x2, y2 };
+	return rect;
+}
+
+std::vector<OfxRectI> windows()
+{
+	std::vector<OfxRectI> windows;
+	windows.push_back( makeRect( 0, 0, 1, 1 ) );
+	windows.push_back( makeRect( 0, 0, 1920, 1080 ) );
+	windows.push_back( makeRect( -13, -7, 301, 203 ) );
+	windows.push_back( makeRect( 5, 3, 6, 997 ) );
+	windows.push_back( makeRect( 0, 0, 4099, 2 ) );
+	return windows;
+}
+
+void checkSchedule( const EProcessSchedule schedule )
+{
+	const std::size_t pixelBytes[] = { 1, 4, 16 };
+	const std::size_t blockBytes[] = { 1, 4096, 128 * 1024 };
+	const unsigned int nbThreads[] = { 1, 3, 8 };
+
+	BOOST_FOREACH( const OfxRectI& window, windows() )
+	{
+		for( std::size_t p = 0; p < 3; ++p )
+		{
+			for( std::size_t b = 0; b < 3; ++b )
+			{
+				for( std::size_t t = 0; t < 3; ++t )
+				{
+					ProcessBlocks blocks;
+					blocks.init( window, schedule, pixelBytes[p], blockBytes[b], nbThreads[t] );
+					BOOST_REQUIRE_GT( blocks.getNbBlocks(), 0 );
+
+					Coverage coverage( window );
+					for( int i = 0; i < blocks.getNbBlocks(); ++i )
+					{
+						coverage.add( blocks.getBlock( i ) );
+					}
+					BOOST_CHECK_EQUAL( coverage.nbErrors(), 0U );
+				}
+			}
+		}
+	}
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE( tuttle_processSchedule )
+
+BOOST_AUTO_TEST_CASE( processSchedule_bands )
+{
+	BOOST_FOREACH( const OfxRectI& window, windows() )
+	{
+		for( unsigned int nbThreads = 1; nbThreads <= 17; ++nbThreads )
+		{
+			Coverage coverage( window );
+			for( unsigned int threadId = 0; threadId < nbThreads; ++threadId )
+			{
+				coverage.add( ProcessBlocks::getBand( window, threadId, nbThreads ) );
+			}
+			BOOST_CHECK_EQUAL( coverage.nbErrors(), 0U );
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE( processSchedule_blocks )
+{
+	checkSchedule( eProcessScheduleBlocks );
+}
+
+BOOST_AUTO_TEST_CASE( processSchedule_tiles )
+{
+	checkSchedule( eProcessScheduleTiles );
+}
+
+BOOST_AUTO_TEST_CASE( processSchedule_bands_without_blocks )
+{
+	ProcessBlocks blocks;
+	blocks.init( makeRect( 0, 0, 100, 100 ), eProcessScheduleBands, 4, 4096, 4 );
+	BOOST_CHECK_EQUAL( blocks.getNbBlocks(), 0 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
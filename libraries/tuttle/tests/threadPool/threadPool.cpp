@@ -0,0 +1,139 @@
+#define BOOST_TEST_MODULE tuttle_threadPool
+#include <tuttle/test/main.hpp>
+
+#include <tuttle/host/ThreadPool.hpp>
+
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/bind.hpp>
+
+#include <vector>
+#include <set>
+#include <stdexcept>
+
+using namespace boost::unit_test;
+using namespace tuttle::host;
+
+namespace {
+
+void fillIndex( std::vector<std::size_t>& values, const std::size_t index )
+{
+	values[index] += index + 1;
+}
+
+void nestedFill( ThreadPool& pool, std::vector<std::vector<std::size_t> >& values, const std::size_t index )
+{
+	pool.execute( boost::bind( fillIndex, boost::ref( values[index] ), _1 ), values[index].size() );
+}
+
+void recordThread( boost::mutex& mutex, std::set<boost::thread::id>& threads, const std::size_t )
+{
+	boost::mutex::scoped_lock locker( mutex );
+	threads.insert( boost::this_thread::get_id() );
+	boost::this_thread::sleep( boost::posix_time::milliseconds( 10 ) );
+}
+
+/// Tasks which need to end in the index order, like the frames of a sequential node.
+struct OrderedTasks
+{
+	OrderedTasks( ThreadPool& pool ) : _pool( pool ), _nbDone( 0 ) {}
+
+	void run( const std::size_t index )
+	{
+		{
+			boost::mutex::scoped_lock locker( _mutex );
+			while( _nbDone != index )
+				_done.wait( locker );
+		}
+		// nested tasks, the waiting thread must not execute a next ordered task
+		std::vector<std::size_t> values( 64, 0 );
+		_pool.execute( boost::bind( fillIndex, boost::ref( values ), _1 ), values.size() );
+
+		boost::mutex::scoped_lock locker( _mutex );
+		++_nbDone;
+		_done.notify_all();
+	}
+
+	ThreadPool& _pool;
+	boost::mutex _mutex;
+	boost::condition_variable _done;
+	std::size_t _nbDone;
+};
+
+void throwOnOddIndex( const std::size_t index )
+{
+	if( index % 2 )
+		throw std::runtime_error( "odd index" );
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE( threadPool_tests_suite01 )
+
+BOOST_AUTO_TEST_CASE( threadPool_sequential )
+{
+	ThreadPool pool( 1 );
+	BOOST_CHECK_EQUAL( 1U, pool.getNbThreads() );
+
+	std::vector<std::size_t> values( 10, 0 );
+	pool.execute( boost::bind( fillIndex, boost::ref( values ), _1 ), values.size() );
+	for( std::size_t i = 0; i < values.size(); ++i )
+		BOOST_CHECK_EQUAL( i + 1, values[i] );
+}
+
+BOOST_AUTO_TEST_CASE( threadPool_execute )
+{
+	ThreadPool pool( 4 );
+	BOOST_CHECK_EQUAL( 4U, pool.getNbThreads() );
+
+	std::vector<std::size_t> values( 1000, 0 );
+	for( int i = 0; i < 10; ++i )
+		pool.execute( boost::bind( fillIndex, boost::ref( values ), _1 ), values.size() );
+	for( std::size_t i = 0; i < values.size(); ++i )
+		BOOST_CHECK_EQUAL( 10 * ( i + 1 ), values[i] );
+
+	// the threads are reused between calls and never exceed the pool size
+	boost::mutex mutex;
+	std::set<boost::thread::id> threads;
+	pool.execute( boost::bind( recordThread, boost::ref( mutex ), boost::ref( threads ), _1 ), 16 );
+	BOOST_CHECK_LE( threads.size(), pool.getNbThreads() );
+}
+
+BOOST_AUTO_TEST_CASE( threadPool_nested )
+{
+	ThreadPool pool( 3 );
+	std::vector<std::vector<std::size_t> > values( 8, std::vector<std::size_t>( 100, 0 ) );
+	pool.execute( boost::bind( nestedFill, boost::ref( pool ), boost::ref( values ), _1 ), values.size() );
+	for( std::size_t i = 0; i < values.size(); ++i )
+		for( std::size_t j = 0; j < values[i].size(); ++j )
+			BOOST_CHECK_EQUAL( j + 1, values[i][j] );
+}
+
+BOOST_AUTO_TEST_CASE( threadPool_ordered_tasks )
+{
+	ThreadPool pool( 4 );
+	for( int i = 0; i < 20; ++i )
+	{
+		OrderedTasks tasks( pool );
+		pool.execute( boost::bind( &OrderedTasks::run, &tasks, _1 ), pool.getNbThreads() );
+		BOOST_CHECK_EQUAL( pool.getNbThreads(), tasks._nbDone );
+	}
+}
+
+BOOST_AUTO_TEST_CASE( threadPool_exception )
+{
+	ThreadPool pool( 4 );
+	BOOST_CHECK_THROW( pool.execute( throwOnOddIndex, 10 ), std::runtime_error );
+
+	// the pool is still usable
+	std::vector<std::size_t> values( 10, 0 );
+	pool.execute( boost::bind( fillIndex, boost::ref( values ), _1 ), values.size() );
+	BOOST_CHECK_EQUAL( 10U, values.back() );
+
+	pool.setNbThreads( 2 );
+	BOOST_CHECK_EQUAL( 2U, pool.getNbThreads() );
+	pool.execute( boost::bind( fillIndex, boost::ref( values ), _1 ), values.size() );
+	BOOST_CHECK_EQUAL( 20U, values.back() );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
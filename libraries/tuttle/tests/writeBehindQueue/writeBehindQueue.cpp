@@ -0,0 +1,165 @@
+#define BOOST_TEST_MODULE tuttle_writeBehindQueue
+#include <tuttle/test/main.hpp>
+
+// the queue is in the io plugin library, which is not linked with the host tests
+#include <tuttle/ioplugin/context/WriteBehindQueue.cpp>
+
+#include <tuttle/common/exceptions.hpp>
+
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/bind.hpp>
+
+#include <algorithm>
+#include <vector>
+
+using namespace boost::unit_test;
+using tuttle::plugin::WriteBehindQueue;
+
+namespace {
+
+void recordFrame( boost::mutex& mutex, std::vector<int>& frames, const int frame )
+{
+	boost::this_thread::sleep( boost::posix_time::milliseconds( frame % 3 ) );
+	boost::mutex::scoped_lock lock( mutex );
+	frames.push_back( frame );
+}
+
+void failFrame( const int delay )
+{
+	boost::this_thread::sleep( boost::posix_time::milliseconds( delay ) );
+	BOOST_THROW_EXCEPTION( tuttle::exception::File()
+		<< tuttle::exception::user( "Unable to write the frame." ) );
+}
+
+/// @brief Job which waits until the gate is opened.
+struct Gate
+{
+	Gate() : _open( false ), _nbWaiting( 0 ) {}
+
+	void wait()
+	{
+		boost::mutex::scoped_lock lock( _mutex );
+		++_nbWaiting;
+		_cond.notify_all();
+		while( ! _open )
+			_cond.wait( lock );
+	}
+
+	void waitJobs( const std::size_t nbJobs )
+	{
+		boost::mutex::scoped_lock lock( _mutex );
+		while( _nbWaiting < nbJobs )
+			_cond.wait( lock );
+	}
+
+	void open()
+	{
+		boost::mutex::scoped_lock lock( _mutex );
+		_open = true;
+		_cond.notify_all();
+	}
+
+	boost::mutex _mutex;
+	boost::condition_variable _cond;
+	bool _open;
+	std::size_t _nbWaiting;
+};
+
+void pushJob( WriteBehindQueue& queue, const WriteBehindQueue::Job& job, const OfxTime time, bool& pushed )
+{
+	queue.push( job, time );
+	pushed = true;
+}
+
+OfxTime flushErrorTime( WriteBehindQueue& queue )
+{
+	try
+	{
+		queue.flush();
+	}
+	catch( boost::exception& e )
+	{
+		const OfxTime* time = boost::get_error_info<tuttle::exception::time>( e );
+		BOOST_REQUIRE( time != NULL );
+		return *time;
+	}
+	BOOST_FAIL( "No error from the queue." );
+	return 0;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE( tuttle_writeBehindQueue_suite )
+
+BOOST_AUTO_TEST_CASE( writeBehindQueue_order )
+{
+	// with one thread the frames are written in the order of the render
+	{
+		boost::mutex mutex;
+		std::vector<int> frames;
+		WriteBehindQueue queue( 1 );
+		for( int frame = 0; frame < 10; ++frame )
+			queue.push( boost::bind( recordFrame, boost::ref( mutex ), boost::ref( frames ), frame ), frame );
+		queue.flush();
+		BOOST_REQUIRE_EQUAL( frames.size(), 10U );
+		for( int frame = 0; frame < 10; ++frame )
+			BOOST_CHECK_EQUAL( frames[frame], frame );
+	}
+	// with more threads each frame is written once
+	{
+		boost::mutex mutex;
+		std::vector<int> frames;
+		WriteBehindQueue queue( 3 );
+		for( int frame = 0; frame < 30; ++frame )
+			queue.push( boost::bind( recordFrame, boost::ref( mutex ), boost::ref( frames ), frame ), frame );
+		queue.flush();
+		BOOST_REQUIRE_EQUAL( frames.size(), 30U );
+		std::sort( frames.begin(), frames.end() );
+		for( int frame = 0; frame < 30; ++frame )
+			BOOST_CHECK_EQUAL( frames[frame], frame );
+	}
+}
+
+BOOST_AUTO_TEST_CASE( writeBehindQueue_first_error )
+{
+	boost::mutex mutex;
+	std::vector<int> frames;
+	WriteBehindQueue queue( 3 );
+	queue.push( boost::bind( recordFrame, boost::ref( mutex ), boost::ref( frames ), 0 ), 0 );
+	// the frame 1 fails after the frame 2
+	queue.push( boost::bind( failFrame, 50 ), 1 );
+	queue.push( boost::bind( failFrame, 0 ), 2 );
+	// the errors are not rethrown by the render of the next frames
+	for( int frame = 3; frame < 8; ++frame )
+		BOOST_CHECK_NO_THROW( queue.push( boost::bind( recordFrame, boost::ref( mutex ), boost::ref( frames ), frame ), frame ) );
+
+	// the error of the first frame, with its time
+	BOOST_CHECK_EQUAL( flushErrorTime( queue ), 1 );
+	BOOST_CHECK_EQUAL( frames.size(), 6U );
+	// the error is only reported once
+	BOOST_CHECK_NO_THROW( queue.flush() );
+}
+
+BOOST_AUTO_TEST_CASE( writeBehindQueue_back_pressure )
+{
+	Gate gate;
+	WriteBehindQueue queue( 2 );
+	queue.push( boost::bind( &Gate::wait, boost::ref( gate ) ), 0 );
+	queue.push( boost::bind( &Gate::wait, boost::ref( gate ) ), 1 );
+	gate.waitJobs( 2 );
+
+	// the queue is full, the next render waits for a free place
+	bool pushed = false;
+	boost::thread render( boost::bind( pushJob, boost::ref( queue ), WriteBehindQueue::Job( boost::bind( &Gate::wait, boost::ref( gate ) ) ), 2, boost::ref( pushed ) ) );
+	boost::this_thread::sleep( boost::posix_time::milliseconds( 50 ) );
+	BOOST_CHECK( ! pushed );
+
+	gate.open();
+	render.join();
+	BOOST_CHECK( pushed );
+	queue.flush();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
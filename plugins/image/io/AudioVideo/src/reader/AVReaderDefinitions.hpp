@@ -39,6 +39,7 @@ static const std::string kParamMetaDataAttachementLabel = "Attachement";
 static const std::string kParamMetaDataUnknown = common::kPrefixMetaData + "unknown";
 static const std::string kParamMetaDataUnknownLabel = "Unknown";
 
+static const std::string kParamPrefetchFrames = "prefetchFrames";
 static const std::string kParamVerbose = "verbose";
 
 }
@@ -29,10 +29,9 @@ AVReaderPlugin::AVReaderPlugin( OfxImageEffectHandle handle )
 	, _paramVideoDetailCustom( common::kPrefixVideo, AV_OPT_FLAG_DECODING_PARAM | AV_OPT_FLAG_VIDEO_PARAM, true )
 	, _inputFile( NULL )
 	, _inputDecoder( NULL )
-	, _sourceImage( NULL )
-	, _imageToDecode( NULL )
 	, _inputStream( NULL )
 	, _colorTransform()
+	, _prefetcher( NULL )
 	, _libavFeatures()
 	, _lastInputFilePath( "" )
 	, _lastVideoStreamIndex( 0 )
@@ -68,6 +67,7 @@ AVReaderPlugin::AVReaderPlugin( OfxImageEffectHandle handle )
 	_paramMetaDataUnknown = fetchStringParam( kParamMetaDataUnknown );
 	_paramMetaDataUnknown->setIsSecret( true );
 
+	_paramPrefetchFrames = fetchIntParam( kParamPrefetchFrames );
 	_paramVerbose = fetchBooleanParam( kParamVerbose );
 
 	common::disableOFXParamsForFormatOrCodec( *this, _libavFeatures._optionsPerOutputFormat, "", common::kPrefixFormat );
@@ -95,6 +95,9 @@ void AVReaderPlugin::ensureVideoIsOpen()
 		    << exception::filename( filepath ) );
 	}
 	
+	// stop the decoding of the previous file
+	cleanInputFile();
+
 	try
 	{
 		// set and analyse inputFile
@@ -131,13 +134,16 @@ void AVReaderPlugin::ensureVideoIsOpen()
 
 void AVReaderPlugin::cleanInputFile()
 {
+	// the prefetcher uses the file and the decoder
+	_prefetcher.reset();
 	_inputFile.reset();
 	_inputDecoder.reset();
-	_sourceImage.reset();
-	_imageToDecode.reset();
+	_inputStream = NULL;
 	_lastInputFilePath = "";
 	_lastVideoStreamIndex = 0;
+	_lastFrame = -1;
 	_initVideo = false;
+	_isSetUp = false;
 }
 
 void AVReaderPlugin::updateVisibleTools()
@@ -335,6 +341,11 @@ void AVReaderPlugin::changedParam( const OFX::InstanceChangedArgs& args, const s
 			common::disableOFXParamsForFormatOrCodec( *this, _libavFeatures._optionsPerVideoCodec, "", common::kPrefixVideo );
 		}
 	}
+	else if( paramName == kParamPrefetchFrames )
+	{
+		if( _prefetcher )
+			_prefetcher->setNbFramesAhead( _paramPrefetchFrames->getValue() );
+	}
 	else if( paramName == kParamVerbose )
 	{
 		if( _paramVerbose->getValue() )
@@ -532,11 +543,14 @@ void AVReaderPlugin::beginSequenceRender( const OFX::BeginSequenceRenderArgument
 
 	// get source image
 	const avtranscoder::VideoFrameDesc sourceImageDesc( _inputStream->getVideoCodec().getVideoFrameDesc() );
-	_sourceImage.reset( new avtranscoder::VideoFrame( sourceImageDesc ) );
 
 	// get image to decode
 	const avtranscoder::VideoFrameDesc imageToDecodeDesc( sourceImageDesc._width, sourceImageDesc._height, "rgb24" );
-	_imageToDecode.reset( new avtranscoder::VideoFrame( imageToDecodeDesc ) );
+
+	// decode and convert the frames in a background thread
+	_prefetcher.reset( new FramePrefetcher( *_inputFile, *_inputDecoder, _colorTransform,
+	                                        sourceImageDesc, imageToDecodeDesc,
+	                                        _paramPrefetchFrames->getValue() ) );
 
 	_isSetUp = true;
 }
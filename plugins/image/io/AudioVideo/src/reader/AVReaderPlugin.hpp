@@ -1,6 +1,8 @@
 #ifndef _TUTTLE_PLUGIN_AV_READER_PLUGIN_HPP_
 #define _TUTTLE_PLUGIN_AV_READER_PLUGIN_HPP_
 
+#include "FramePrefetcher.hpp"
+
 #include <common/LibAVParams.hpp>
 #include <common/LibAVFeaturesAvailable.hpp>
 
@@ -95,15 +97,17 @@ public:
 	OFX::StringParam* _paramMetaDataAttachement;
 	OFX::StringParam* _paramMetaDataUnknown;
 
+	OFX::IntParam* _paramPrefetchFrames; ///< Number of frames decoded ahead
 	OFX::BooleanParam* _paramVerbose;
 	
 	boost::scoped_ptr<avtranscoder::InputFile> _inputFile;
 	boost::scoped_ptr<avtranscoder::VideoDecoder> _inputDecoder;
-	boost::scoped_ptr<avtranscoder::VideoFrame> _sourceImage;
-	boost::scoped_ptr<avtranscoder::VideoFrame> _imageToDecode;
 	avtranscoder::InputStream* _inputStream;  ///< Has link (InputFile has ownership)
 	
 	avtranscoder::VideoTransform _colorTransform;
+
+	/// Decode the frames in a background thread, uses the file, the decoder and the transform (destroyed first)
+	boost::scoped_ptr<FramePrefetcher> _prefetcher;
 	
 	// to access available libav features
 	common::LibAVFeaturesAvailable _libavFeatures;
@@ -111,7 +115,7 @@ public:
 	std::string _lastInputFilePath;
 	size_t _lastVideoStreamIndex;
 	
-	int _lastFrame;
+	int _lastFrame; ///< Last rendered frame
 	
 	bool _initVideo;  ///< Is the video init
 	bool _isSetUp;  ///< Is the unwrapping and decoding setup
@@ -211,6 +211,15 @@ void AVReaderPluginFactory::describeInContext( OFX::ImageEffectDescriptor& desc,
 	metaDataUnknown->setStringType( OFX::eStringTypeMultiLine );
 	metaDataUnknown->setParent( metaGroup );
 
+	/// PREFETCH
+	OFX::IntParamDescriptor* prefetchFrames = desc.defineIntParam( kParamPrefetchFrames );
+	prefetchFrames->setLabel( "Frames decoded ahead" );
+	prefetchFrames->setDefault( 4 );
+	prefetchFrames->setRange( 0, 64 );
+	prefetchFrames->setDisplayRange( 0, 16 );
+	prefetchFrames->setHint( "Number of frames decoded in a background thread, ahead of the rendered frame, when the frames are rendered one after the other.\n"
+	                         "0 decodes only the rendered frame." );
+
 	/// VERBOSE
 	OFX::BooleanParamDescriptor* useVerbose = desc.defineBooleanParam( kParamVerbose );
 	useVerbose->setLabel( "Set to verbose" );
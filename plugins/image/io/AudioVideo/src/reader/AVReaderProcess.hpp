@@ -22,6 +22,7 @@ class AVReaderProcess : public ImageGilProcessor<View>
 {
 protected:
 	AVReaderPlugin& _plugin;
+	avtranscoder::VideoFrame* _image; ///< Converted image of the rendered frame, owned by the prefetcher
 
 public:
 	AVReaderProcess( AVReaderPlugin& instance );
@@ -11,6 +11,7 @@ template<class View>
 AVReaderProcess<View>::AVReaderProcess( AVReaderPlugin& instance )
 	: ImageGilProcessor<View>( instance, eImageOrientationFromTopToBottom )
 	, _plugin( instance )
+	, _image( NULL )
 {
 	this->setNoMultiThreading();
 }
@@ -22,24 +23,16 @@ void AVReaderProcess<View>::setup( const OFX::RenderArguments& args )
 
 	// if need to support interlace, use args.fieldToRender
 	
-	// optimization for seek
-	if( ( _plugin._lastFrame + 1 ) != args.time )
-	{
-		_plugin._inputFile->seekAtFrame( args.time );
-		_plugin._inputDecoder->flushDecoder();
-	}
-	
-	_plugin._lastFrame = args.time;
-	
-	// Fetch output image
-	if( ! _plugin._inputDecoder->decodeNextFrame( *_plugin._sourceImage ) )
+	// Fetch output image, the prefetcher seeks if the frames are not rendered one after the other
+	_image = _plugin._prefetcher->getFrame( static_cast<int>( args.time ) );
+	if( ! _image )
 	{
 		BOOST_THROW_EXCEPTION( exception::Failed()
 		    << exception::user() + "Can't open the frame at time " + args.time
 		    << exception::filename( _plugin._paramFilepath->getValue() ) );
 	}
 	
-	_plugin._colorTransform.convert( *_plugin._sourceImage, *_plugin._imageToDecode );
+	_plugin._lastFrame = args.time;
 }
 
 /**
@@ -62,13 +55,13 @@ void AVReaderProcess<View>::multiThreadProcessImages( const OfxRectI& procWindow
 			switch( components )
 			{
 				case 3:
-					readImage<rgb8c_view_t>( this->_dstView, *_plugin._imageToDecode );
+					readImage<rgb8c_view_t>( this->_dstView, *_image );
 					break;
 				case 4:
-					readImage<rgba8c_view_t>( this->_dstView, *_plugin._imageToDecode );
+					readImage<rgba8c_view_t>( this->_dstView, *_image );
 					break;
 				default:
-					readImage<gray8c_view_t>( this->_dstView, *_plugin._imageToDecode );
+					readImage<gray8c_view_t>( this->_dstView, *_image );
 					break;
 			}
 			break;
@@ -76,13 +69,13 @@ void AVReaderProcess<View>::multiThreadProcessImages( const OfxRectI& procWindow
 			switch( components )
 			{
 				case 3:
-					readImage<rgb16c_view_t>( this->_dstView, *_plugin._imageToDecode );
+					readImage<rgb16c_view_t>( this->_dstView, *_image );
 					break;
 				case 4:
-					readImage<rgba16c_view_t>( this->_dstView, *_plugin._imageToDecode );
+					readImage<rgba16c_view_t>( this->_dstView, *_image );
 					break;
 				default:
-					readImage<gray16c_view_t>( this->_dstView, *_plugin._imageToDecode );
+					readImage<gray16c_view_t>( this->_dstView, *_image );
 					break;
 			}
 			break;
@@ -90,18 +83,18 @@ void AVReaderProcess<View>::multiThreadProcessImages( const OfxRectI& procWindow
 			switch( components )
 			{
 				case 3:
-					readImage<rgb32c_view_t>( this->_dstView, *_plugin._imageToDecode );
+					readImage<rgb32c_view_t>( this->_dstView, *_image );
 					break;
 				case 4:
-					readImage<rgba32c_view_t>( this->_dstView, *_plugin._imageToDecode );
+					readImage<rgba32c_view_t>( this->_dstView, *_image );
 					break;
 				default:
-					readImage<gray32c_view_t>( this->_dstView, *_plugin._imageToDecode );
+					readImage<gray32c_view_t>( this->_dstView, *_image );
 					break;
 			}
 			break;
 		default:
-			readImage<gray16c_view_t>( this->_dstView, *_plugin._imageToDecode );
+			readImage<gray16c_view_t>( this->_dstView, *_image );
 			break;
 			
 	}
@@ -0,0 +1,200 @@
+#include "FramePrefetcher.hpp"
+
+#include <tuttle/plugin/global.hpp>
+
+#include <exception>
+
+namespace tuttle {
+namespace plugin {
+namespace av {
+namespace reader {
+
+FramePrefetcher::FramePrefetcher( avtranscoder::InputFile& inputFile,
+                                  avtranscoder::VideoDecoder& decoder,
+                                  avtranscoder::VideoTransform& transform,
+                                  const avtranscoder::VideoFrameDesc& sourceDesc,
+                                  const avtranscoder::VideoFrameDesc& imageDesc,
+                                  const std::size_t nbFramesAhead )
+	: _inputFile( inputFile )
+	, _decoder( decoder )
+	, _transform( transform )
+	, _imageDesc( imageDesc )
+	, _sourceImage( new avtranscoder::VideoFrame( sourceDesc ) )
+	, _nbFramesAhead( nbFramesAhead )
+	, _lastRequest( -1 )
+	, _nextFrame( 0 ) // the file was just opened
+	, _decodeLimit( 0 )
+	, _seekFrame( -1 )
+	, _generation( 0 )
+	, _endOfStream( false )
+	, _stop( false )
+{
+	_thread = boost::thread( &FramePrefetcher::run, this );
+}
+
+FramePrefetcher::~FramePrefetcher()
+{
+	{
+		boost::mutex::scoped_lock lock( _mutex );
+		_stop = true;
+	}
+	_requestCond.notify_all();
+	_thread.join();
+}
+
+void FramePrefetcher::setNbFramesAhead( const std::size_t nbFramesAhead )
+{
+	boost::mutex::scoped_lock lock( _mutex );
+	_nbFramesAhead = nbFramesAhead;
+	_requestCond.notify_all();
+}
+
+avtranscoder::VideoFrame* FramePrefetcher::getFrame( const int frame )
+{
+	boost::mutex::scoped_lock lock( _mutex );
+	if( _current )
+	{
+		_freeImages.push_back( _current );
+		_current.reset();
+	}
+	const bool sequential = ( frame == _lastRequest + 1 );
+	_lastRequest = frame;
+	dropFramesBefore( frame );
+
+	// first frame delivered by the thread without a new seek
+	int expected = _nextFrame;
+	if( ! _decoded.empty() )
+		expected = _decoded.front()._frame;
+	else if( _seekFrame >= 0 )
+		expected = _seekFrame;
+
+	// decoding a few frames is faster than seeking
+	if( frame < expected || frame > expected + static_cast<int>( _nbFramesAhead ) || ! _error.empty() )
+	{
+		TUTTLE_LOG_DEBUG( "[AVReader] seek at frame " << frame );
+		while( ! _decoded.empty() )
+		{
+			_freeImages.push_back( _decoded.front()._image );
+			_decoded.pop_front();
+		}
+		_seekFrame = frame;
+		++_generation;
+		_endOfStream = false;
+		_error.clear();
+	}
+	// decode ahead only on a sequential access
+	_decodeLimit = frame + 1 + ( sequential ? static_cast<int>( _nbFramesAhead ) : 0 );
+	_requestCond.notify_all();
+
+	for(;;)
+	{
+		dropFramesBefore( frame );
+		if( ! _decoded.empty() && _decoded.front()._frame == frame )
+			break;
+		if( ! _error.empty() )
+		{
+			TUTTLE_LOG_ERROR( "[AVReader] Can't decode the frame " << frame << ": " << _error );
+			return NULL;
+		}
+		if( _endOfStream && _seekFrame < 0 )
+			return NULL;
+		_decodedCond.wait( lock );
+	}
+	_current = _decoded.front()._image;
+	_decoded.pop_front();
+	// a place is free in the ring
+	_requestCond.notify_all();
+	return _current.get();
+}
+
+FramePrefetcher::ImagePtr FramePrefetcher::takeFreeImage()
+{
+	if( _freeImages.empty() )
+		return ImagePtr( new avtranscoder::VideoFrame( _imageDesc ) );
+	ImagePtr image = _freeImages.back();
+	_freeImages.pop_back();
+	return image;
+}
+
+void FramePrefetcher::dropFramesBefore( const int frame )
+{
+	while( ! _decoded.empty() && _decoded.front()._frame < frame )
+	{
+		_freeImages.push_back( _decoded.front()._image );
+		_decoded.pop_front();
+		_requestCond.notify_all();
+	}
+}
+
+void FramePrefetcher::run()
+{
+	boost::mutex::scoped_lock lock( _mutex );
+	for(;;)
+	{
+		while( ! _stop && _seekFrame < 0 &&
+		       ( _endOfStream || ! _error.empty() ||
+		         _nextFrame >= _decodeLimit ||
+		         _decoded.size() > _nbFramesAhead ) )
+		{
+			_requestCond.wait( lock );
+		}
+		if( _stop )
+			return;
+
+		const std::size_t generation = _generation;
+		const int seekFrame = _seekFrame;
+		_seekFrame = -1;
+		if( seekFrame >= 0 )
+			_nextFrame = seekFrame;
+		const int frame = _nextFrame;
+		ImagePtr image = takeFreeImage();
+
+		bool decoded = false;
+		std::string error;
+		lock.unlock();
+		try
+		{
+			if( seekFrame >= 0 )
+			{
+				_inputFile.seekAtFrame( seekFrame );
+				_decoder.flushDecoder();
+			}
+			decoded = _decoder.decodeNextFrame( *_sourceImage );
+			if( decoded )
+				_transform.convert( *_sourceImage, *image );
+		}
+		catch( std::exception& e )
+		{
+			error = e.what();
+		}
+		lock.lock();
+
+		if( generation != _generation )
+		{
+			// a seek was requested during the decoding
+			_freeImages.push_back( image );
+			continue;
+		}
+		if( ! error.empty() )
+		{
+			_error = error;
+			_freeImages.push_back( image );
+		}
+		else if( ! decoded )
+		{
+			_endOfStream = true;
+			_freeImages.push_back( image );
+		}
+		else
+		{
+			_decoded.push_back( DecodedFrame( frame, image ) );
+			_nextFrame = frame + 1;
+		}
+		_decodedCond.notify_all();
+	}
+}
+
+}
+}
+}
+}
@@ -0,0 +1,109 @@
+#ifndef _TUTTLE_PLUGIN_AV_READER_FRAMEPREFETCHER_HPP_
+#define _TUTTLE_PLUGIN_AV_READER_FRAMEPREFETCHER_HPP_
+
+#include <AvTranscoder/file/InputFile.hpp>
+#include <AvTranscoder/decoder/VideoDecoder.hpp>
+#include <AvTranscoder/data/decoded/VideoFrame.hpp>
+#include <AvTranscoder/transform/VideoTransform.hpp>
+
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <deque>
+#include <vector>
+#include <string>
+#include <cstddef>
+
+namespace tuttle {
+namespace plugin {
+namespace av {
+namespace reader {
+
+/**
+ * @brief Decode the frames of a video stream in a background thread.
+ *
+ * The thread decodes the frames and converts them to the output pixel format,
+ * ahead of the last requested frame, in a ring of a bounded size.
+ * When the frames are requested one after the other, the decoding of the
+ * next frames overlaps with the processing of the graph. When a frame is
+ * not one of the next frames, the thread seeks to it and decodes only this
+ * frame, until the access is sequential again.
+ *
+ * @warning While the prefetcher exists, the input file, the decoder and the
+ * transform are only used by its thread.
+ */
+class FramePrefetcher : boost::noncopyable
+{
+public:
+	typedef boost::shared_ptr<avtranscoder::VideoFrame> ImagePtr;
+
+	FramePrefetcher( avtranscoder::InputFile& inputFile,
+	                 avtranscoder::VideoDecoder& decoder,
+	                 avtranscoder::VideoTransform& transform,
+	                 const avtranscoder::VideoFrameDesc& sourceDesc,
+	                 const avtranscoder::VideoFrameDesc& imageDesc,
+	                 const std::size_t nbFramesAhead );
+	~FramePrefetcher();
+
+	void setNbFramesAhead( const std::size_t nbFramesAhead );
+
+	/**
+	 * @brief Converted image of @p frame, valid until the next call.
+	 * Wait for the decoding of the frame.
+	 * @return NULL if the frame can't be decoded
+	 */
+	avtranscoder::VideoFrame* getFrame( const int frame );
+
+private:
+	struct DecodedFrame
+	{
+		DecodedFrame( const int frame, const ImagePtr& image )
+			: _frame( frame )
+			, _image( image )
+		{}
+		int _frame;
+		ImagePtr _image;
+	};
+
+	void run();
+	/// @pre _mutex is locked
+	ImagePtr takeFreeImage();
+	/// @pre _mutex is locked
+	void dropFramesBefore( const int frame );
+
+private:
+	avtranscoder::InputFile& _inputFile;
+	avtranscoder::VideoDecoder& _decoder;
+	avtranscoder::VideoTransform& _transform;
+	avtranscoder::VideoFrameDesc _imageDesc;
+	boost::scoped_ptr<avtranscoder::VideoFrame> _sourceImage; ///< only used by the thread
+
+	boost::mutex _mutex;
+	boost::condition_variable _decodedCond; ///< a frame is decoded, or the decoding failed
+	boost::condition_variable _requestCond; ///< new frames are requested, or stop
+	std::deque<DecodedFrame> _decoded; ///< decoded frames, in increasing order
+	std::vector<ImagePtr> _freeImages;
+	ImagePtr _current; ///< image returned by the last getFrame
+	std::size_t _nbFramesAhead;
+	int _lastRequest; ///< last requested frame
+	int _nextFrame; ///< next frame decoded by the thread
+	int _decodeLimit; ///< the thread decodes the frames before this one
+	int _seekFrame; ///< frame to seek to, or -1
+	std::size_t _generation; ///< incremented at each seek, to drop the frames decoded before
+	bool _endOfStream;
+	std::string _error;
+	bool _stop;
+
+	boost::thread _thread;
+};
+
+}
+}
+}
+}
+
+#endif
@@ -0,0 +1,180 @@
+#include "DPXImageLayout.hpp"
+
+#include <boost/filesystem/fstream.hpp>
+
+#include <algorithm>
+
+namespace tuttle {
+namespace plugin {
+namespace dpx {
+namespace reader {
+
+namespace {
+
+/// Offsets of the header fields (SMPTE 268M)
+enum
+{
+	kOffsetMagic            = 0,
+	kOffsetImageOffset      = 4,
+	kOffsetFileInfoEnd      = 8,
+	kOffsetImageInfo        = 768,
+	kOffsetNbElements       = 770,
+	kOffsetPixelsPerLine    = 772,
+	kOffsetLinesPerElement  = 776,
+	kOffsetDescriptor       = 800,
+	kOffsetBitDepth         = 803,
+	kOffsetPacking          = 804,
+	kOffsetEncoding         = 806,
+	kOffsetDataOffset       = 808,
+	kOffsetEndOfLinePadding = 812
+};
+
+static const unsigned int kMagicBigEndian    = 0x53445058; // "SDPX"
+static const unsigned int kMagicLittleEndian = 0x58504453; // "XPDS"
+
+unsigned int readU32( const unsigned char* data, const bool bigEndian )
+{
+	if( bigEndian )
+		return ( static_cast<unsigned int>( data[0] ) << 24 ) | ( data[1] << 16 ) | ( data[2] << 8 ) | data[3];
+	return ( static_cast<unsigned int>( data[3] ) << 24 ) | ( data[2] << 16 ) | ( data[1] << 8 ) | data[0];
+}
+
+unsigned int readU16( const unsigned char* data, const bool bigEndian )
+{
+	if( bigEndian )
+		return ( data[0] << 8 ) | data[1];
+	return ( data[1] << 8 ) | data[0];
+}
+
+std::size_t componentsCount( const ::dpx::Descriptor descriptor )
+{
+	switch( descriptor )
+	{
+		case ::dpx::kUserDefinedDescriptor:
+		case ::dpx::kRed:
+		case ::dpx::kGreen:
+		case ::dpx::kBlue:
+		case ::dpx::kAlpha:
+		case ::dpx::kLuma:
+		case ::dpx::kDepth:
+			return 1;
+		case ::dpx::kRGB:
+			return 3;
+		case ::dpx::kRGBA:
+		case ::dpx::kABGR:
+			return 4;
+		default:
+			return 0;
+	}
+}
+
+}
+
+DPXImageLayout::DPXImageLayout()
+	: _width( 0 )
+	, _height( 0 )
+	, _nbComponents( 0 )
+	, _descriptor( ::dpx::kUndefinedDescriptor )
+	, _bitDepth( 0 )
+	, _packing( ::dpx::kPacked )
+	, _encoding( ::dpx::kNone )
+	, _dataOffset( 0 )
+	, _rowBytes( 0 )
+	, _bigEndian( true )
+{}
+
+bool DPXImageLayout::isDirect() const
+{
+	if( _encoding != ::dpx::kNone )
+		return false;
+	switch( _bitDepth )
+	{
+		case 8:
+		case 16:
+			return true;
+		case 10:
+		case 12:
+			return _packing == ::dpx::kFilledMethodA || _packing == ::dpx::kFilledMethodB;
+	}
+	return false;
+}
+
+bool DPXImageLayout::sameHeader( const unsigned char* data, const std::size_t size ) const
+{
+	// the file name, the time and the file size can change
+	return ! _header.empty() && size >= kDpxLayoutHeaderSize &&
+	       std::equal( _header.begin(), _header.begin() + kOffsetFileInfoEnd, data ) &&
+	       std::equal( _header.begin() + kOffsetImageInfo, _header.end(), data + kOffsetImageInfo );
+}
+
+bool readImageLayout( const unsigned char* data, const std::size_t size, DPXImageLayout& layout )
+{
+	if( size < kDpxLayoutHeaderSize )
+		return false;
+
+	const unsigned int magic = readU32( data + kOffsetMagic, true );
+	if( magic != kMagicBigEndian && magic != kMagicLittleEndian )
+		return false;
+	const bool bigEndian = ( magic == kMagicBigEndian );
+
+	if( readU16( data + kOffsetNbElements, bigEndian ) < 1 )
+		return false;
+	layout._bigEndian    = bigEndian;
+	layout._width        = readU32( data + kOffsetPixelsPerLine, bigEndian );
+	layout._height       = readU32( data + kOffsetLinesPerElement, bigEndian );
+	layout._descriptor   = static_cast< ::dpx::Descriptor >( data[kOffsetDescriptor] );
+	layout._nbComponents = componentsCount( layout._descriptor );
+	layout._bitDepth     = data[kOffsetBitDepth];
+	layout._packing      = static_cast< ::dpx::Packing >( readU16( data + kOffsetPacking, bigEndian ) );
+	layout._encoding     = static_cast< ::dpx::Encoding >( readU16( data + kOffsetEncoding, bigEndian ) );
+	if( layout._nbComponents == 0 || layout._width == 0 || layout._height == 0 )
+		return false;
+
+	// the offset of the element is optional
+	layout._dataOffset = readU32( data + kOffsetDataOffset, bigEndian );
+	if( layout._dataOffset == 0 || layout._dataOffset == 0xFFFFFFFF )
+		layout._dataOffset = readU32( data + kOffsetImageOffset, bigEndian );
+
+	std::size_t padding = readU32( data + kOffsetEndOfLinePadding, bigEndian );
+	if( padding == 0xFFFFFFFF )
+		padding = 0;
+	const std::size_t nbDatums = layout._width * layout._nbComponents;
+	switch( layout._bitDepth )
+	{
+		case 8:
+			layout._rowBytes = nbDatums;
+			break;
+		case 10:
+			// 3 datums per 32 bits word, each line starts on a new word
+			layout._rowBytes = ( nbDatums + 2 ) / 3 * 4;
+			break;
+		case 12:
+		case 16:
+			layout._rowBytes = nbDatums * 2;
+			break;
+		default:
+			layout._rowBytes = 0;
+			break;
+	}
+	layout._rowBytes += padding;
+
+	layout._header.assign( data, data + kDpxLayoutHeaderSize );
+	return true;
+}
+
+bool readImageLayout( const std::string& filepath, DPXImageLayout& layout )
+{
+	boost::filesystem::ifstream file( filepath, std::ios::in | std::ios::binary );
+	if( ! file )
+		return false;
+	unsigned char header[kDpxLayoutHeaderSize];
+	file.read( reinterpret_cast<char*>( header ), kDpxLayoutHeaderSize );
+	if( file.gcount() != static_cast<std::streamsize>( kDpxLayoutHeaderSize ) )
+		return false;
+	return readImageLayout( header, kDpxLayoutHeaderSize, layout );
+}
+
+}
+}
+}
+}
@@ -0,0 +1,65 @@
+#ifndef _DPXREADER_IMAGELAYOUT_HPP_
+#define _DPXREADER_IMAGELAYOUT_HPP_
+
+#include <libdpx/DPXHeader.h>
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+namespace tuttle {
+namespace plugin {
+namespace dpx {
+namespace reader {
+
+/// Size of the beginning of the header, up to the description of the first image element.
+static const std::size_t kDpxLayoutHeaderSize = 816;
+
+/**
+ * @brief Layout of the pixels of the first image element of a DPX file.
+ */
+struct DPXImageLayout
+{
+	DPXImageLayout();
+
+	std::size_t         _width;
+	std::size_t         _height;
+	std::size_t         _nbComponents;
+	::dpx::Descriptor   _descriptor;
+	int                 _bitDepth;
+	::dpx::Packing      _packing;
+	::dpx::Encoding     _encoding;
+	std::size_t         _dataOffset;   ///< offset of the first line in the file
+	std::size_t         _rowBytes;     ///< size of a line in the file, with the end of line padding
+	bool                _bigEndian;    ///< endianness of the file
+
+	std::vector<unsigned char> _header; ///< beginning of the header, to recognize the files with the same layout
+
+	/**
+	 * @brief The lines can be unpacked directly from the file.
+	 * Else the image is read by libdpx.
+	 */
+	bool isDirect() const;
+
+	/// The header at the beginning of @p data describes the same layout.
+	bool sameHeader( const unsigned char* data, const std::size_t size ) const;
+};
+
+/**
+ * @brief Read the layout from the header at the beginning of a DPX file.
+ * @return false if @p data doesn't start with a supported DPX header.
+ */
+bool readImageLayout( const unsigned char* data, const std::size_t size, DPXImageLayout& layout );
+
+/**
+ * @brief Read the layout from the header of the file @p filepath.
+ * @return false if the file doesn't start with a supported DPX header.
+ */
+bool readImageLayout( const std::string& filepath, DPXImageLayout& layout );
+
+}
+}
+}
+}
+
+#endif
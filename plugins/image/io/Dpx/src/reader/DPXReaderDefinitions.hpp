@@ -0,0 +1,17 @@
+#ifndef _DPXREADER_DEFINITIONS_HPP_
+#define _DPXREADER_DEFINITIONS_HPP_
+
+#include <tuttle/plugin/global.hpp>
+#include <tuttle/ioplugin/context/ReaderDefinition.hpp>
+
+namespace tuttle {
+namespace plugin {
+namespace dpx {
+namespace reader {
+
+}
+}
+}
+}
+
+#endif
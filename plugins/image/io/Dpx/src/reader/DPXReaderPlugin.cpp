@@ -0,0 +1,153 @@
+#include "DPXReaderPlugin.hpp"
+#include "DPXReaderProcess.hpp"
+#include "DPXReaderDefinitions.hpp"
+
+#include <tuttle/ioplugin/context/ReaderPlugin.hpp>
+
+#include <boost/gil/gil_all.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/exception/all.hpp>
+
+namespace tuttle {
+namespace plugin {
+namespace dpx {
+namespace reader {
+
+namespace bfs = boost::filesystem;
+
+DPXReaderPlugin::DPXReaderPlugin( OfxImageEffectHandle handle )
+	: ReaderPlugin( handle )
+{}
+
+DPXReaderProcessParams DPXReaderPlugin::getProcessParams( const OfxTime time )
+{
+	DPXReaderProcessParams params;
+
+	params._filepath = getAbsoluteFilenameAt( time );
+	params._layout   = _layout;
+	return params;
+}
+
+void DPXReaderPlugin::changedParam( const OFX::InstanceChangedArgs& args, const std::string& paramName )
+{
+	ReaderPlugin::changedParam( args, paramName );
+	if( paramName == kTuttlePluginFilename )
+	{
+		updateLayout();
+	}
+}
+
+void DPXReaderPlugin::updateLayout()
+{
+	const std::string filename( getAbsoluteFirstFilename() );
+	DPXImageLayout layout;
+	if( ! readImageLayout( filename, layout ) )
+	{
+		_layout = DPXImageLayout();
+		return;
+	}
+	_layout = layout;
+}
+
+bool DPXReaderPlugin::getRegionOfDefinition( const OFX::RegionOfDefinitionArguments& args, OfxRectD& rod )
+{
+	const std::string filename( getAbsoluteFilenameAt( args.time ) );
+	if( ! bfs::exists( filename ) )
+	{
+		BOOST_THROW_EXCEPTION( exception::FileInSequenceNotExist()
+			<< exception::user( "DPX: Unable to open file" )
+			<< exception::filename( filename ) );
+	}
+
+	// the files of the sequence are expected to have the same layout,
+	// so the header of each frame is only read by the render
+	if( _layout._header.empty() )
+		updateLayout();
+	DPXImageLayout layout( _layout );
+	if( layout._header.empty() && ! readImageLayout( filename, layout ) )
+	{
+		BOOST_THROW_EXCEPTION( exception::ImageFormat()
+			<< exception::user( "DPX: Unable to read the header" )
+			<< exception::filename( filename ) );
+	}
+
+	rod.x1 = 0;
+	rod.x2 = layout._width * this->_clipDst->getPixelAspectRatio();
+	rod.y1 = 0;
+	rod.y2 = layout._height;
+	return true;
+}
+
+void DPXReaderPlugin::getClipPreferences( OFX::ClipPreferencesSetter& clipPreferences )
+{
+	ReaderPlugin::getClipPreferences( clipPreferences );
+	const std::string filename( getAbsoluteFirstFilename() );
+
+	if( ! bfs::exists( filename ) )
+	{
+		BOOST_THROW_EXCEPTION( exception::FileNotExist()
+			<< exception::user( "DPX: Unable to open file" )
+			<< exception::filename( filename ) );
+	}
+	updateLayout();
+	if( _layout._header.empty() )
+	{
+		BOOST_THROW_EXCEPTION( exception::ImageFormat()
+			<< exception::user( "DPX: Unable to read the header" )
+			<< exception::filename( filename ) );
+	}
+
+	if( getExplicitBitDepthConversion() == eParamReaderBitDepthAuto )
+	{
+		switch( _layout._bitDepth )
+		{
+			case 8:
+				clipPreferences.setClipBitDepth( *this->_clipDst, OFX::eBitDepthUByte );
+				break;
+			case 10:
+			case 12:
+			case 16:
+				clipPreferences.setClipBitDepth( *this->_clipDst, OFX::eBitDepthUShort );
+				break;
+			default:
+				clipPreferences.setClipBitDepth( *this->_clipDst, OFX::eBitDepthFloat );
+				break;
+		}
+	}
+
+	if( getExplicitChannelConversion() == eParamReaderChannelAuto )
+	{
+		switch( _layout._nbComponents )
+		{
+			case 1:
+				clipPreferences.setClipComponents( *this->_clipDst, OFX::ePixelComponentAlpha );
+				break;
+			case 3:
+				if( OFX::getImageEffectHostDescription()->supportsPixelComponent( OFX::ePixelComponentRGB ) )
+					clipPreferences.setClipComponents( *this->_clipDst, OFX::ePixelComponentRGB );
+				else
+					clipPreferences.setClipComponents( *this->_clipDst, OFX::ePixelComponentRGBA );
+				break;
+			default:
+				clipPreferences.setClipComponents( *this->_clipDst, OFX::ePixelComponentRGBA );
+				break;
+		}
+	}
+
+	clipPreferences.setPixelAspectRatio( *this->_clipDst, 1.0 );
+}
+
+/**
+ * @brief The overridden render function
+ * @param[in]   args     Rendering parameters
+ */
+void DPXReaderPlugin::render( const OFX::RenderArguments& args )
+{
+	ReaderPlugin::render( args );
+	doGilRender<DPXReaderProcess>( *this, args );
+}
+
+}
+}
+}
+}
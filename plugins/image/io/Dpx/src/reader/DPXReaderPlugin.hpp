@@ -0,0 +1,50 @@
+#ifndef _TUTTLE_PLUGIN_DPXREADER_PLUGIN_HPP_
+#define _TUTTLE_PLUGIN_DPXREADER_PLUGIN_HPP_
+
+#include "DPXImageLayout.hpp"
+
+#include <tuttle/ioplugin/context/ReaderPlugin.hpp>
+
+namespace tuttle {
+namespace plugin {
+namespace dpx {
+namespace reader {
+
+struct DPXReaderProcessParams
+{
+	std::string       _filepath;       ///< filepath
+	DPXImageLayout    _layout;         ///< layout of the first file of the sequence
+};
+
+/**
+ * @brief Dpx reader
+ *
+ */
+class DPXReaderPlugin : public ReaderPlugin
+{
+public:
+	DPXReaderPlugin( OfxImageEffectHandle handle );
+
+public:
+	DPXReaderProcessParams getProcessParams( const OfxTime time );
+
+	void changedParam( const OFX::InstanceChangedArgs& args, const std::string& paramName );
+	bool getRegionOfDefinition( const OFX::RegionOfDefinitionArguments& args, OfxRectD& rod );
+	void getClipPreferences( OFX::ClipPreferencesSetter& clipPreferences );
+
+	void render( const OFX::RenderArguments& args );
+
+private:
+	/// Read the header of the first file of the sequence.
+	void updateLayout();
+
+private:
+	DPXImageLayout _layout; ///< layout shared by the files of the sequence
+};
+
+}
+}
+}
+}
+
+#endif
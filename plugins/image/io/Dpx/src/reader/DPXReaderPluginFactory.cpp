@@ -0,0 +1,79 @@
+#include "DPXReaderPluginFactory.hpp"
+#include "DPXReaderPlugin.hpp"
+#include "DPXReaderDefinitions.hpp"
+
+#include <tuttle/ioplugin/context/ReaderPluginFactory.hpp>
+
+namespace tuttle {
+namespace plugin {
+namespace dpx {
+namespace reader {
+
+/**
+ * @brief Function called to describe the plugin main features.
+ * @param[in, out]   desc     Effect descriptor
+ */
+void DPXReaderPluginFactory::describe( OFX::ImageEffectDescriptor& desc )
+{
+	desc.setLabels( "TuttleDpxReader", "DpxReader",
+			    "Dpx file reader" );
+	desc.setPluginGrouping( "tuttle/image/io" );
+
+	desc.setDescription( "Digital Picture Exchange (DPX), ANSI/SMPTE standard (268M-2003)\n"
+			     "The 8, 10 (filled), 12 (filled) and 16 bits images are read from the mapped file.\n"
+			     "The other layouts are read by libdpx." );
+
+	// add the supported contexts
+	desc.addSupportedContext( OFX::eContextReader );
+	desc.addSupportedContext( OFX::eContextGeneral );
+
+	// add supported pixel depths
+	desc.addSupportedBitDepth( OFX::eBitDepthUByte );
+	desc.addSupportedBitDepth( OFX::eBitDepthUShort );
+	desc.addSupportedBitDepth( OFX::eBitDepthFloat );
+
+	// add supported extensions
+	desc.addSupportedExtension( "dpx" );
+	desc.setPluginEvaluation( 90 );
+
+	// plugin flags
+	desc.setRenderThreadSafety( OFX::eRenderFullySafe );
+	desc.setHostFrameThreading( false );
+	desc.setSupportsMultiResolution( false );
+	desc.setSupportsMultipleClipDepths( true );
+	desc.setSupportsTiles( kSupportTiles );
+}
+
+/**
+ * @brief Function called to describe the plugin controls and features.
+ * @param[in, out]   desc       Effect descriptor
+ * @param[in]        context    Application context
+ */
+void DPXReaderPluginFactory::describeInContext( OFX::ImageEffectDescriptor& desc,
+						OFX::EContext               context )
+{
+	OFX::ClipDescriptor* dstClip = desc.defineClip( kOfxImageEffectOutputClipName );
+	dstClip->addSupportedComponent( OFX::ePixelComponentRGBA );
+	dstClip->addSupportedComponent( OFX::ePixelComponentRGB );
+	dstClip->addSupportedComponent( OFX::ePixelComponentAlpha );
+	dstClip->setSupportsTiles( kSupportTiles );
+
+	describeReaderParamsInContext( desc, context );
+}
+
+/**
+ * @brief Function called to create a plugin effect instance
+ * @param[in] handle  effect handle
+ * @param[in] context    Application context
+ * @return  plugin instance
+ */
+OFX::ImageEffect* DPXReaderPluginFactory::createInstance( OfxImageEffectHandle handle,
+							  OFX::EContext        context )
+{
+	return new DPXReaderPlugin( handle );
+}
+
+}
+}
+}
+}
@@ -0,0 +1,20 @@
+#ifndef _DPX_READER_PLUGIN_FACTORY_HPP_
+#define _DPX_READER_PLUGIN_FACTORY_HPP_
+#include <ofxsImageEffect.h>
+
+namespace tuttle {
+namespace plugin {
+namespace dpx {
+namespace reader {
+
+static const bool kSupportTiles = false;
+
+mDeclarePluginFactory( DPXReaderPluginFactory, {}, {}
+                       );
+
+}
+}
+}
+}
+
+#endif
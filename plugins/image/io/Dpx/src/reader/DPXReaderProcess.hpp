@@ -0,0 +1,62 @@
+#ifndef _TUTTLE_PLUGIN_DPXREADER_PROCESS_HPP_
+#define _TUTTLE_PLUGIN_DPXREADER_PROCESS_HPP_
+
+#include "DPXImageLayout.hpp"
+
+#include <tuttle/plugin/ImageGilProcessor.hpp>
+
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <boost/cstdint.hpp>
+
+#include <vector>
+
+namespace tuttle {
+namespace plugin {
+namespace dpx {
+namespace reader {
+
+/**
+ * @brief Read the lines of a DPX file from the mapped file into the output view.
+ * The lines are unpacked by each thread, only the layouts that can't be
+ * unpacked directly are read by libdpx.
+ */
+template<class View>
+class DPXReaderProcess : public ImageGilProcessor<View>
+{
+protected:
+	DPXReaderPlugin&    _plugin;        ///< Rendering plugin
+
+	DPXReaderProcessParams _params;
+	boost::iostreams::mapped_file_source _file;
+	const unsigned char* _data;         ///< first line in the mapped file
+	bool _swap;                         ///< the endianness of the file is not the endianness of the machine
+
+	std::vector<boost::uint16_t> _image;      ///< image read by libdpx, for integer layouts
+	std::vector<float>           _imageFloat; ///< image read by libdpx, for float layouts
+
+public:
+	DPXReaderProcess( DPXReaderPlugin& instance );
+
+	void setup( const OFX::RenderArguments& args );
+	void multiThreadProcessImages( const OfxRectI& procWindowRoW );
+
+private:
+	/// Read the whole image with libdpx.
+	void readImage();
+
+	/// Unpack the line @p y of the file into @p buffer.
+	const boost::uint16_t* unpackLine( const std::size_t y, std::vector<boost::uint16_t>& buffer ) const;
+
+	/// Copy a line of the file in @p Channel to the line @p y of the output view.
+	template<typename Channel>
+	void copyLine( const Channel* line, const std::ptrdiff_t x1, const std::ptrdiff_t x2, const std::ptrdiff_t y );
+};
+
+}
+}
+}
+}
+
+#include "DPXReaderProcess.tcc"
+
+#endif
@@ -0,0 +1,243 @@
+#include "DPXReaderDefinitions.hpp"
+#include "DPXReaderPlugin.hpp"
+#include "DPXUnpack.hpp"
+
+#include <libdpx/DPX.h>
+
+#include <terry/globals.hpp>
+#include <tuttle/plugin/exceptions.hpp>
+
+#include <boost/gil/gil_all.hpp>
+#include <boost/assert.hpp>
+
+#include <cstring>
+
+namespace tuttle {
+namespace plugin {
+namespace dpx {
+namespace reader {
+
+namespace detail {
+
+/// Copy the pixels [x1, x1 + dst.width()) of a line of @p width pixels of type @p Pixel.
+template<class Pixel, class DstView>
+void copyPixels( const void* line, const std::ptrdiff_t width, const std::ptrdiff_t x1, const DstView& dst )
+{
+	using namespace boost::gil;
+	const Pixel* pixels = reinterpret_cast<const Pixel*>( line );
+	copy_and_convert_pixels( subimage_view( interleaved_view( width, 1, pixels, width * sizeof( Pixel ) ), x1, 0, dst.width(), 1 ), dst );
+}
+
+}
+
+template<class View>
+DPXReaderProcess<View>::DPXReaderProcess( DPXReaderPlugin& instance )
+	: ImageGilProcessor<View>( instance, eImageOrientationFromTopToBottom )
+	, _plugin( instance )
+	, _data( NULL )
+	, _swap( false )
+{
+	// each thread unpacks whole lines
+	this->setProcessSchedule( eProcessScheduleBlocks );
+}
+
+template<class View>
+void DPXReaderProcess<View>::setup( const OFX::RenderArguments& args )
+{
+	ImageGilProcessor<View>::setup( args );
+
+	_params = _plugin.getProcessParams( args.time );
+
+	try
+	{
+		_file.open( _params._filepath );
+	}
+	catch( std::exception& e )
+	{
+		BOOST_THROW_EXCEPTION( exception::File()
+			<< exception::user( "DPX: Unable to open file" )
+			<< exception::dev( e.what() )
+			<< exception::filename( _params._filepath ) );
+	}
+	const unsigned char* data = reinterpret_cast<const unsigned char*>( _file.data() );
+
+	// the header is only parsed again if it is not the header of the first file
+	DPXImageLayout& layout = _params._layout;
+	if( ! layout.sameHeader( data, _file.size() ) && ! readImageLayout( data, _file.size(), layout ) )
+	{
+		BOOST_THROW_EXCEPTION( exception::ImageFormat()
+			<< exception::user( "DPX: Unable to read the header" )
+			<< exception::filename( _params._filepath ) );
+	}
+	if( static_cast<std::size_t>( this->_dstView.width() ) != layout._width ||
+	    static_cast<std::size_t>( this->_dstView.height() ) != layout._height )
+	{
+		BOOST_THROW_EXCEPTION( exception::ImageFormat()
+			<< exception::user() + "DPX: The image size " + layout._width + "x" + layout._height + " is not the size of the first image of the sequence."
+			<< exception::filename( _params._filepath ) );
+	}
+
+	_swap = ( layout._bigEndian != isBigEndianMachine() );
+	if( layout.isDirect() && layout._dataOffset + layout._rowBytes * layout._height <= _file.size() )
+	{
+		_data = data + layout._dataOffset;
+		return;
+	}
+	// packed, encoded or float layouts
+	_file.close();
+	readImage();
+}
+
+/**
+ * @brief Function called by rendering thread each time a process must be done.
+ * @param[in] procWindowRoW  Processing window in RoW
+ */
+template<class View>
+void DPXReaderProcess<View>::multiThreadProcessImages( const OfxRectI& procWindowRoW )
+{
+	using namespace boost::gil;
+	const DPXImageLayout& layout = _params._layout;
+	const OfxRectI procWindowOutput = this->translateRoWToOutputClipCoordinates( procWindowRoW );
+	const std::ptrdiff_t width = layout._width;
+	const std::ptrdiff_t height = this->_dstView.height();
+	const std::size_t nbDatums = layout._width * layout._nbComponents;
+
+	std::vector<boost::uint16_t> buffer;
+	// the output view is from top to bottom, like the lines of the file
+	for( std::ptrdiff_t y = height - procWindowOutput.y2; y < height - procWindowOutput.y1; ++y )
+	{
+		if( ! _imageFloat.empty() )
+		{
+			copyLine( reinterpret_cast<const bits32f*>( &_imageFloat[y * nbDatums] ), procWindowOutput.x1, procWindowOutput.x2, y );
+		}
+		else if( ! _image.empty() )
+		{
+			copyLine( &_image[y * nbDatums], procWindowOutput.x1, procWindowOutput.x2, y );
+		}
+		else if( layout._bitDepth == 8 )
+		{
+			copyLine( reinterpret_cast<const bits8*>( _data + y * layout._rowBytes ), procWindowOutput.x1, procWindowOutput.x2, y );
+		}
+		else if( layout._bitDepth == 10 && layout._nbComponents == 3 )
+		{
+			// a pixel per word, unpacked to planes
+			buffer.resize( nbDatums );
+			bits16* red = &buffer[0];
+			bits16* green = red + width;
+			bits16* blue = green + width;
+			unpack10BitsRGB( _data + y * layout._rowBytes, width, _swap, layout._packing == ::dpx::kFilledMethodA ? 2 : 0, red, green, blue );
+			const View dst = subimage_view( this->_dstView, procWindowOutput.x1, y, procWindowOutput.x2 - procWindowOutput.x1, 1 );
+			copy_and_convert_pixels( subimage_view( planar_rgb_view( width, 1, red, green, blue, width * sizeof( bits16 ) ), procWindowOutput.x1, 0, dst.width(), 1 ), dst );
+		}
+		else
+		{
+			copyLine( unpackLine( y, buffer ), procWindowOutput.x1, procWindowOutput.x2, y );
+		}
+		if( this->progressForward( procWindowOutput.x2 - procWindowOutput.x1 ) )
+			return;
+	}
+}
+
+template<class View>
+const boost::uint16_t* DPXReaderProcess<View>::unpackLine( const std::size_t y, std::vector<boost::uint16_t>& buffer ) const
+{
+	const DPXImageLayout& layout = _params._layout;
+	const unsigned char* line = _data + y * layout._rowBytes;
+	const std::size_t nbDatums = layout._width * layout._nbComponents;
+
+	switch( layout._bitDepth )
+	{
+		case 10:
+			buffer.resize( nbDatums );
+			// libdpx reverses the datums of the words of single channel images
+			unpack10Bits( line, nbDatums, _swap, layout._packing == ::dpx::kFilledMethodA ? 2 : 0, layout._nbComponents == 1, &buffer[0] );
+			return &buffer[0];
+		case 12:
+			buffer.resize( nbDatums );
+			unpack12Bits( line, nbDatums, _swap, layout._packing == ::dpx::kFilledMethodA, &buffer[0] );
+			return &buffer[0];
+		case 16:
+			if( ! _swap && reinterpret_cast<std::size_t>( line ) % sizeof( boost::uint16_t ) == 0 )
+				return reinterpret_cast<const boost::uint16_t*>( line );
+			buffer.resize( nbDatums );
+			if( _swap )
+				swap16Bits( line, nbDatums, &buffer[0] );
+			else
+				std::memcpy( &buffer[0], line, nbDatums * sizeof( boost::uint16_t ) );
+			return &buffer[0];
+	}
+	BOOST_ASSERT( false );
+	return NULL;
+}
+
+template<class View>
+template<typename Channel>
+void DPXReaderProcess<View>::copyLine( const Channel* line, const std::ptrdiff_t x1, const std::ptrdiff_t x2, const std::ptrdiff_t y )
+{
+	using namespace boost::gil;
+	const std::ptrdiff_t width = _params._layout._width;
+	const View dst = subimage_view( this->_dstView, x1, y, x2 - x1, 1 );
+
+	switch( _params._layout._descriptor )
+	{
+		case ::dpx::kRGB:
+			detail::copyPixels<pixel<Channel, rgb_layout_t> >( line, width, x1, dst );
+			break;
+		case ::dpx::kRGBA:
+			detail::copyPixels<pixel<Channel, rgba_layout_t> >( line, width, x1, dst );
+			break;
+		case ::dpx::kABGR:
+			detail::copyPixels<pixel<Channel, abgr_layout_t> >( line, width, x1, dst );
+			break;
+		default:
+			detail::copyPixels<pixel<Channel, gray_layout_t> >( line, width, x1, dst );
+			break;
+	}
+}
+
+template<class View>
+void DPXReaderProcess<View>::readImage()
+{
+	const DPXImageLayout& layout = _params._layout;
+	InStream stream;
+	if( ! stream.Open( _params._filepath.c_str() ) )
+	{
+		BOOST_THROW_EXCEPTION( exception::File()
+			<< exception::user( "DPX: Unable to open file" )
+			<< exception::filename( _params._filepath ) );
+	}
+
+	::dpx::Reader dpxReader;
+	dpxReader.SetInStream( &stream );
+	if( ! dpxReader.ReadHeader() )
+	{
+		BOOST_THROW_EXCEPTION( exception::ImageFormat()
+			<< exception::user( "DPX: Unable to read the header" )
+			<< exception::filename( _params._filepath ) );
+	}
+
+	const std::size_t size = layout._width * layout._height * layout._nbComponents;
+	bool read;
+	if( layout._bitDepth > 16 )
+	{
+		_imageFloat.resize( size );
+		read = dpxReader.ReadImage( &_imageFloat[0], ::dpx::kFloat, layout._descriptor );
+	}
+	else
+	{
+		_image.resize( size );
+		read = dpxReader.ReadImage( &_image[0], ::dpx::kWord, layout._descriptor );
+	}
+	stream.Close();
+	if( ! read )
+	{
+		BOOST_THROW_EXCEPTION( exception::ImageFormat()
+			<< exception::user( "DPX: Unable to read the image" )
+			<< exception::filename( _params._filepath ) );
+	}
+}
+
+}
+}
+}
+}
@@ -0,0 +1,175 @@
+#include "DPXUnpack.hpp"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include <cstring>
+
+namespace tuttle {
+namespace plugin {
+namespace dpx {
+namespace reader {
+
+namespace {
+
+inline boost::uint32_t load32( const unsigned char* src, const bool swap )
+{
+	boost::uint32_t word;
+	std::memcpy( &word, src, sizeof( word ) );
+	if( swap )
+		word = ( word << 24 ) | ( ( word << 8 ) & 0x00FF0000 ) | ( ( word >> 8 ) & 0x0000FF00 ) | ( word >> 24 );
+	return word;
+}
+
+inline boost::uint16_t load16( const unsigned char* src, const bool swap )
+{
+	boost::uint16_t word;
+	std::memcpy( &word, src, sizeof( word ) );
+	if( swap )
+		word = static_cast<boost::uint16_t>( ( word << 8 ) | ( word >> 8 ) );
+	return word;
+}
+
+/// 10 bits to 16 bits, like libdpx
+inline boost::uint16_t from10Bits( const boost::uint32_t v )
+{
+	return static_cast<boost::uint16_t>( ( v << 6 ) | ( v >> 4 ) );
+}
+
+/// 12 bits to 16 bits, like libdpx for the method B
+inline boost::uint16_t from12Bits( const boost::uint32_t v )
+{
+	return static_cast<boost::uint16_t>( ( v << 4 ) | ( v >> 8 ) );
+}
+
+#ifdef __SSE2__
+inline __m128i swapBytes16( const __m128i v )
+{
+	return _mm_or_si128( _mm_slli_epi16( v, 8 ), _mm_srli_epi16( v, 8 ) );
+}
+
+inline __m128i swapBytes32( const __m128i v )
+{
+	const __m128i halfSwapped = swapBytes16( v );
+	return _mm_shufflehi_epi16( _mm_shufflelo_epi16( halfSwapped, _MM_SHUFFLE( 2, 3, 0, 1 ) ), _MM_SHUFFLE( 2, 3, 0, 1 ) );
+}
+
+/// Extract a 10 bits datum of 8 words, and store it as 8 values of 16 bits.
+inline void store10Bits( boost::uint16_t* dst, const __m128i words0, const __m128i words1, const __m128i shift )
+{
+	const __m128i mask = _mm_set1_epi32( 0x3FF );
+	const __m128i v0 = _mm_and_si128( _mm_srl_epi32( words0, shift ), mask );
+	const __m128i v1 = _mm_and_si128( _mm_srl_epi32( words1, shift ), mask );
+	// the values fit in signed 16 bits
+	const __m128i v = _mm_packs_epi32( v0, v1 );
+	_mm_storeu_si128( reinterpret_cast<__m128i*>( dst ), _mm_or_si128( _mm_slli_epi16( v, 6 ), _mm_srli_epi16( v, 4 ) ) );
+}
+#endif
+
+}
+
+void unpack10BitsRGB( const unsigned char* src, const std::size_t width, const bool swap, const int padding,
+                      boost::uint16_t* red, boost::uint16_t* green, boost::uint16_t* blue )
+{
+	std::size_t x = 0;
+#ifdef __SSE2__
+	const __m128i redShift = _mm_cvtsi32_si128( 20 + padding );
+	const __m128i greenShift = _mm_cvtsi32_si128( 10 + padding );
+	const __m128i blueShift = _mm_cvtsi32_si128( padding );
+	for( ; x + 8 <= width; x += 8 )
+	{
+		__m128i words0 = _mm_loadu_si128( reinterpret_cast<const __m128i*>( src + x * 4 ) );
+		__m128i words1 = _mm_loadu_si128( reinterpret_cast<const __m128i*>( src + x * 4 + 16 ) );
+		if( swap )
+		{
+			words0 = swapBytes32( words0 );
+			words1 = swapBytes32( words1 );
+		}
+		store10Bits( red + x, words0, words1, redShift );
+		store10Bits( green + x, words0, words1, greenShift );
+		store10Bits( blue + x, words0, words1, blueShift );
+	}
+#endif
+	for( ; x < width; ++x )
+	{
+		const boost::uint32_t word = load32( src + x * 4, swap );
+		red[x]   = from10Bits( ( word >> ( 20 + padding ) ) & 0x3FF );
+		green[x] = from10Bits( ( word >> ( 10 + padding ) ) & 0x3FF );
+		blue[x]  = from10Bits( ( word >> padding ) & 0x3FF );
+	}
+}
+
+void unpack10Bits( const unsigned char* src, const std::size_t nbDatums, const bool swap, const int padding,
+                   const bool reversed, boost::uint16_t* dst )
+{
+	const int firstShift = reversed ? padding : 20 + padding;
+	const int lastShift = reversed ? 20 + padding : padding;
+	std::size_t i = 0;
+	for( ; i + 3 <= nbDatums; i += 3, src += 4 )
+	{
+		const boost::uint32_t word = load32( src, swap );
+		dst[i]     = from10Bits( ( word >> firstShift ) & 0x3FF );
+		dst[i + 1] = from10Bits( ( word >> ( 10 + padding ) ) & 0x3FF );
+		dst[i + 2] = from10Bits( ( word >> lastShift ) & 0x3FF );
+	}
+	if( i < nbDatums )
+	{
+		// last word of the line
+		const boost::uint32_t word = load32( src, swap );
+		const int shifts[3] = { firstShift, 10 + padding, lastShift };
+		for( int k = 0; i < nbDatums; ++i, ++k )
+			dst[i] = from10Bits( ( word >> shifts[k] ) & 0x3FF );
+	}
+}
+
+void unpack12Bits( const unsigned char* src, const std::size_t nbDatums, const bool swap, const bool methodA,
+                   boost::uint16_t* dst )
+{
+	std::size_t i = 0;
+#ifdef __SSE2__
+	const __m128i mask = _mm_set1_epi16( 0x0FFF );
+	for( ; i + 8 <= nbDatums; i += 8 )
+	{
+		__m128i v = _mm_loadu_si128( reinterpret_cast<const __m128i*>( src + i * 2 ) );
+		if( swap )
+			v = swapBytes16( v );
+		if( ! methodA )
+		{
+			v = _mm_and_si128( v, mask );
+			v = _mm_or_si128( _mm_slli_epi16( v, 4 ), _mm_srli_epi16( v, 8 ) );
+		}
+		_mm_storeu_si128( reinterpret_cast<__m128i*>( dst + i ), v );
+	}
+#endif
+	for( ; i < nbDatums; ++i )
+	{
+		const boost::uint16_t word = load16( src + i * 2, swap );
+		dst[i] = methodA ? word : from12Bits( word & 0x0FFF );
+	}
+}
+
+void swap16Bits( const unsigned char* src, const std::size_t nbDatums, boost::uint16_t* dst )
+{
+	std::size_t i = 0;
+#ifdef __SSE2__
+	for( ; i + 8 <= nbDatums; i += 8 )
+	{
+		const __m128i v = _mm_loadu_si128( reinterpret_cast<const __m128i*>( src + i * 2 ) );
+		_mm_storeu_si128( reinterpret_cast<__m128i*>( dst + i ), swapBytes16( v ) );
+	}
+#endif
+	for( ; i < nbDatums; ++i )
+		dst[i] = load16( src + i * 2, true );
+}
+
+bool isBigEndianMachine()
+{
+	const boost::uint16_t one = 1;
+	return *reinterpret_cast<const unsigned char*>( &one ) == 0;
+}
+
+}
+}
+}
+}
@@ -0,0 +1,52 @@
+#ifndef _DPXREADER_UNPACK_HPP_
+#define _DPXREADER_UNPACK_HPP_
+
+#include <boost/cstdint.hpp>
+
+#include <cstddef>
+
+namespace tuttle {
+namespace plugin {
+namespace dpx {
+namespace reader {
+
+/**
+ * @brief Unpack a line of 10 bits RGB filled to 32 bits words, a pixel per word,
+ * into 3 planes of 16 bits values.
+ * @param src the words of the line, in the file endianness
+ * @param swap the file endianness is not the endianness of the machine
+ * @param padding 2 for the method A, 0 for the method B
+ */
+void unpack10BitsRGB( const unsigned char* src, const std::size_t width, const bool swap, const int padding,
+                      boost::uint16_t* red, boost::uint16_t* green, boost::uint16_t* blue );
+
+/**
+ * @brief Unpack @p nbDatums datums of 10 bits filled to 32 bits words,
+ * 3 datums per word, into 16 bits values.
+ * @param reversed the first datum is in the least significant bits of each word
+ */
+void unpack10Bits( const unsigned char* src, const std::size_t nbDatums, const bool swap, const int padding,
+                   const bool reversed, boost::uint16_t* dst );
+
+/**
+ * @brief Unpack @p nbDatums datums of 12 bits filled to 16 bits words into 16 bits values.
+ * @param methodA the datums are in the most significant bits of the words,
+ *                the words are kept as they are, like libdpx does
+ */
+void unpack12Bits( const unsigned char* src, const std::size_t nbDatums, const bool swap, const bool methodA,
+                   boost::uint16_t* dst );
+
+/**
+ * @brief Byte swap @p nbDatums datums of 16 bits.
+ */
+void swap16Bits( const unsigned char* src, const std::size_t nbDatums, boost::uint16_t* dst );
+
+/// The machine is big endian.
+bool isBigEndianMachine();
+
+}
+}
+}
+}
+
+#endif
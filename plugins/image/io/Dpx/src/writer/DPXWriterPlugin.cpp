@@ -149,9 +149,9 @@ void DPXWriterPlugin::render( const OFX::RenderArguments& args )
 				case OFX::eBitDepthFloat:
 					switch( components )
 					{
-						case OFX::ePixelComponentAlpha: doGilRender<DPXWriterProcess, false, boost::gil::gray_layout_t>( *this, args, eOfxBitDepth ); break;
-						case OFX::ePixelComponentRGB  : doGilRender<DPXWriterProcess, false, boost::gil::rgb_layout_t> ( *this, args, eOfxBitDepth ); break;
-						case OFX::ePixelComponentRGBA : doGilRender<DPXWriterProcess, false, boost::gil::rgba_layout_t>( *this, args, eOfxBitDepth ); break;
+						case OFX::ePixelComponentAlpha: doGilRender<WriteBehind<DPXWriterProcess>::Process, false, boost::gil::gray_layout_t>( *this, args, eOfxBitDepth ); break;
+						case OFX::ePixelComponentRGB  : doGilRender<WriteBehind<DPXWriterProcess>::Process, false, boost::gil::rgb_layout_t> ( *this, args, eOfxBitDepth ); break;
+						case OFX::ePixelComponentRGBA : doGilRender<WriteBehind<DPXWriterProcess>::Process, false, boost::gil::rgba_layout_t>( *this, args, eOfxBitDepth ); break;
 						default: BOOST_THROW_EXCEPTION( exception::InputMismatch()
 														<< exception::user( "Dpx: Unknown component." ) ); break;
 					}
@@ -175,9 +175,9 @@ void DPXWriterPlugin::render( const OFX::RenderArguments& args )
 				{
 					switch( components )
 					{
-						case OFX::ePixelComponentAlpha: doGilRender<DPXWriterProcess, false, boost::gil::gray_layout_t>( *this, args, eOfxBitDepth ); break;
-						case OFX::ePixelComponentRGB  : doGilRender<DPXWriterProcess, false, boost::gil::rgb_layout_t> ( *this, args, eOfxBitDepth ); break;
-						case OFX::ePixelComponentRGBA : doGilRender<DPXWriterProcess, false, boost::gil::rgba_layout_t>( *this, args, eOfxBitDepth ); break;
+						case OFX::ePixelComponentAlpha: doGilRender<WriteBehind<DPXWriterProcess>::Process, false, boost::gil::gray_layout_t>( *this, args, eOfxBitDepth ); break;
+						case OFX::ePixelComponentRGB  : doGilRender<WriteBehind<DPXWriterProcess>::Process, false, boost::gil::rgb_layout_t> ( *this, args, eOfxBitDepth ); break;
+						case OFX::ePixelComponentRGBA : doGilRender<WriteBehind<DPXWriterProcess>::Process, false, boost::gil::rgba_layout_t>( *this, args, eOfxBitDepth ); break;
 						default: BOOST_THROW_EXCEPTION( exception::InputMismatch()
 														<< exception::user( "Dpx: Unknown component." ) ); break;
 					}
@@ -200,9 +200,9 @@ void DPXWriterPlugin::render( const OFX::RenderArguments& args )
 				{
 					switch( components )
 					{
-						case OFX::ePixelComponentAlpha: doGilRender<DPXWriterProcess, false, boost::gil::gray_layout_t>( *this, args, eOfxBitDepth ); break;
-						case OFX::ePixelComponentRGB  : doGilRender<DPXWriterProcess, false, boost::gil::rgb_layout_t> ( *this, args, eOfxBitDepth ); break;
-						case OFX::ePixelComponentRGBA : doGilRender<DPXWriterProcess, false, boost::gil::rgba_layout_t>( *this, args, eOfxBitDepth ); break;
+						case OFX::ePixelComponentAlpha: doGilRender<WriteBehind<DPXWriterProcess>::Process, false, boost::gil::gray_layout_t>( *this, args, eOfxBitDepth ); break;
+						case OFX::ePixelComponentRGB  : doGilRender<WriteBehind<DPXWriterProcess>::Process, false, boost::gil::rgb_layout_t> ( *this, args, eOfxBitDepth ); break;
+						case OFX::ePixelComponentRGBA : doGilRender<WriteBehind<DPXWriterProcess>::Process, false, boost::gil::rgba_layout_t>( *this, args, eOfxBitDepth ); break;
 						default: BOOST_THROW_EXCEPTION( exception::InputMismatch()
 														<< exception::user( "Dpx: Unknown component." ) ); break;
 					}
@@ -226,9 +226,9 @@ void DPXWriterPlugin::render( const OFX::RenderArguments& args )
 				{
 					switch( components )
 					{
-						case OFX::ePixelComponentAlpha: doGilRender<DPXWriterProcess, false, boost::gil::gray_layout_t>( *this, args, eOfxBitDepth ); break;
-						case OFX::ePixelComponentRGB  : doGilRender<DPXWriterProcess, false, boost::gil::rgb_layout_t> ( *this, args, eOfxBitDepth ); break;
-						case OFX::ePixelComponentRGBA : doGilRender<DPXWriterProcess, false, boost::gil::rgba_layout_t>( *this, args, eOfxBitDepth ); break;
+						case OFX::ePixelComponentAlpha: doGilRender<WriteBehind<DPXWriterProcess>::Process, false, boost::gil::gray_layout_t>( *this, args, eOfxBitDepth ); break;
+						case OFX::ePixelComponentRGB  : doGilRender<WriteBehind<DPXWriterProcess>::Process, false, boost::gil::rgb_layout_t> ( *this, args, eOfxBitDepth ); break;
+						case OFX::ePixelComponentRGBA : doGilRender<WriteBehind<DPXWriterProcess>::Process, false, boost::gil::rgba_layout_t>( *this, args, eOfxBitDepth ); break;
 						default: BOOST_THROW_EXCEPTION( exception::InputMismatch()
 														<< exception::user( "Dpx: Unknown component." ) ); break;
 					}
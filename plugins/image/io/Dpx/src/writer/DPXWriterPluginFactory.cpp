@@ -65,6 +65,7 @@ void DPXWriterPluginFactory::describeInContext( OFX::ImageEffectDescriptor& desc
 	// Controls
 	
 	describeWriterParamsInContext( desc, context );
+	describeWriteBehindParamInContext( desc, context );
 
 	OFX::ChoiceParamDescriptor* bitDepth = static_cast<OFX::ChoiceParamDescriptor*>( desc.getParamDescriptor( kTuttlePluginBitDepth ) );
 	bitDepth->resetOptions();
@@ -5,16 +5,336 @@
 
 #include <tuttle/host/Graph.hpp>
 
+// the unpacking and libdpx are in the plugin, which is not linked with the host tests
+#include "../src/reader/DPXUnpack.cpp"
+#include "../src/dpx-google-code/libdpx/Codec.cpp"
+#include "../src/dpx-google-code/libdpx/DPX.cpp"
+#include "../src/dpx-google-code/libdpx/DPXHeader.cpp"
+#include "../src/dpx-google-code/libdpx/ElementReadStream.cpp"
+#include "../src/dpx-google-code/libdpx/InStream.cpp"
+#include "../src/dpx-google-code/libdpx/OutStream.cpp"
+#include "../src/dpx-google-code/libdpx/Reader.cpp"
+#include "../src/dpx-google-code/libdpx/RunLengthEncoding.cpp"
+#include "../src/dpx-google-code/libdpx/Writer.cpp"
+
 #include <boost/preprocessor/stringize.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <boost/cstdint.hpp>
 
 #include <boost/timer.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 
+#include <iterator>
+#include <limits>
+#include <cstring>
+#include <vector>
+
 using namespace boost::unit_test;
 using namespace tuttle::host;
 
+BOOST_AUTO_TEST_SUITE( plugin_Dpx_reader )
+std::string pluginName = "tuttle.dpxreader";
+std::string filename = "dpx/flowers-1920x1080-RGB-10.dpx";
+#include <tuttle/test/io/reader.hpp>
+BOOST_AUTO_TEST_SUITE_END()
+
+
 BOOST_AUTO_TEST_SUITE( plugin_Dpx_writer )
 std::string pluginName = "tuttle.dpxwriter";
 std::string filename = "test-png.png";
 #include <tuttle/test/io/writer.hpp>
 BOOST_AUTO_TEST_SUITE_END()
+
+
+namespace {
+
+namespace dpxReader = tuttle::plugin::dpx::reader;
+
+/// @brief Values of a synthetic image, with all the bits used.
+std::vector<boost::uint16_t> syntheticImage( const std::size_t width, const std::size_t height, const std::size_t nbComponents )
+{
+	std::vector<boost::uint16_t> image( width * height * nbComponents );
+	boost::uint32_t v = 12345;
+	for( std::size_t i = 0; i < image.size(); ++i )
+	{
+		v = v * 1103515245 + 12345;
+		image[i] = static_cast<boost::uint16_t>( v >> 16 );
+	}
+	return image;
+}
+
+/**
+ * @brief A synthetic DPX file, written by the libdpx writer.
+ * The file is removed at the end of the test.
+ */
+struct DpxFile
+{
+	DpxFile( const std::size_t width, const std::size_t height,
+	         const ::dpx::Descriptor descriptor, const std::size_t nbComponents,
+	         const int bitDepth, const ::dpx::Packing packing,
+	         const bool bigEndian, const int eolnPadding = 0 )
+		: _filepath( boost::filesystem::temp_directory_path() / boost::filesystem::unique_path( "plugin_io_dpx-%%%%-%%%%.dpx" ) )
+		, _width( width )
+		, _height( height )
+		, _descriptor( descriptor )
+		, _nbComponents( nbComponents )
+		, _bitDepth( bitDepth )
+		, _packing( packing )
+		, _bigEndian( bigEndian )
+		, _eolnPadding( eolnPadding )
+		, _dataOffset( 0 )
+	{
+		// libdpx also reads the end of line padding from the source lines
+		_source = syntheticImage( width + eolnPadding / 2 / nbComponents, height, nbComponents );
+
+		OutStream stream;
+		BOOST_REQUIRE( stream.Open( _filepath.string().c_str() ) );
+		::dpx::Writer writer;
+		writer.SetOutStream( &stream );
+		writer.Start();
+		// the header and the data are swapped if the file is not in the endianness of the machine
+		writer.SetFileInfo( _filepath.string().c_str(), 0, "plugin_io_dpx", 0, 0, ~0, bigEndian != dpxReader::isBigEndianMachine() );
+		writer.SetImageInfo( width, height );
+		writer.SetElement( 0, descriptor, bitDepth, ::dpx::kLinear, ::dpx::kLinear, packing, ::dpx::kNone,
+		                   0, ~0, std::numeric_limits<float>::quiet_NaN(), ~0, std::numeric_limits<float>::quiet_NaN(),
+		                   eolnPadding );
+		BOOST_REQUIRE( writer.WriteHeader() );
+		BOOST_REQUIRE( writer.WriteElement( 0, &_source[0], ::dpx::kWord ) );
+		BOOST_REQUIRE( writer.Finish() );
+		stream.Close();
+
+		readImage();
+	}
+
+	~DpxFile()
+	{
+		boost::system::error_code error;
+		boost::filesystem::remove( _filepath, error );
+	}
+
+	/// @brief The image read by libdpx, like the DPX reader does for the other layouts.
+	void readImage()
+	{
+		InStream stream;
+		BOOST_REQUIRE( stream.Open( _filepath.string().c_str() ) );
+		::dpx::Reader reader;
+		reader.SetInStream( &stream );
+		BOOST_REQUIRE( reader.ReadHeader() );
+		_dataOffset = reader.header.DataOffset( 0 );
+		const unsigned int eolnPadding = reader.header.EndOfLinePadding( 0 );
+		BOOST_REQUIRE_EQUAL( eolnPadding == 0xFFFFFFFF ? 0 : eolnPadding, static_cast<unsigned int>( _eolnPadding ) );
+		_image.resize( _width * _height * _nbComponents );
+		BOOST_REQUIRE( reader.ReadImage( &_image[0], ::dpx::kWord, _descriptor ) );
+		stream.Close();
+	}
+
+	/**
+	 * @brief The values expected in the image, for each datum of the file.
+	 * libdpx reads the 10 bits filled lines at wrong offsets if the datums of a line
+	 * don't fill the last word, the values are then expected from the source image.
+	 */
+	std::vector<boost::uint16_t> expectedImage() const
+	{
+		const std::size_t nbDatums = _width * _nbComponents;
+		if( _bitDepth != 10 || _packing == ::dpx::kPacked || nbDatums % 3 == 0 )
+			return _image;
+
+		const std::size_t sourceRowDatums = nbDatums + _eolnPadding / 2;
+		std::vector<boost::uint16_t> expected( _image.size() );
+		for( std::size_t y = 0; y < _height; ++y )
+		{
+			for( std::size_t i = 0; i < nbDatums; ++i )
+			{
+				// the 10 bits expanded to 16 bits like libdpx
+				const boost::uint16_t v = _source[y * sourceRowDatums + i] >> 6;
+				expected[y * nbDatums + i] = ( v << 6 ) | ( v >> 4 );
+			}
+		}
+		return expected;
+	}
+
+	/// @brief The content of the file.
+	std::vector<unsigned char> data() const
+	{
+		boost::filesystem::ifstream file( _filepath, std::ios::in | std::ios::binary );
+		return std::vector<unsigned char>( std::istreambuf_iterator<char>( file ), std::istreambuf_iterator<char>() );
+	}
+
+	boost::filesystem::path _filepath;
+	std::size_t _width;
+	std::size_t _height;
+	::dpx::Descriptor _descriptor;
+	std::size_t _nbComponents;
+	int _bitDepth;
+	::dpx::Packing _packing;
+	bool _bigEndian;
+	int _eolnPadding;
+	std::size_t _dataOffset;
+	std::vector<boost::uint16_t> _source; ///< image written by libdpx
+	std::vector<boost::uint16_t> _image;  ///< image read by libdpx
+};
+
+/**
+ * @brief Unpack the lines of the file like DPXReaderProcess,
+ * and compare them with the image read by libdpx.
+ */
+void checkUnpack( const DpxFile& dpxFile )
+{
+	const std::vector<unsigned char> data = dpxFile.data();
+	const std::vector<boost::uint16_t> expected = dpxFile.expectedImage();
+	const std::size_t width = dpxFile._width;
+	const std::size_t nbDatums = width * dpxFile._nbComponents;
+	const std::size_t rowBytes = ( dpxFile._bitDepth == 10 ? ( nbDatums + 2 ) / 3 * 4 : nbDatums * 2 ) + dpxFile._eolnPadding;
+	BOOST_REQUIRE_GE( data.size(), dpxFile._dataOffset + rowBytes * dpxFile._height );
+	const bool swap = dpxFile._bigEndian != dpxReader::isBigEndianMachine();
+	const bool methodA = dpxFile._packing == ::dpx::kFilledMethodA;
+
+	std::vector<boost::uint16_t> line( nbDatums );
+	std::size_t nbErrors = 0;
+	for( std::size_t y = 0; y < dpxFile._height; ++y )
+	{
+		const unsigned char* src = &data[dpxFile._dataOffset + y * rowBytes];
+		if( dpxFile._bitDepth == 10 && dpxFile._nbComponents == 3 )
+		{
+			std::vector<boost::uint16_t> planes( nbDatums );
+			dpxReader::unpack10BitsRGB( src, width, swap, methodA ? 2 : 0, &planes[0], &planes[width], &planes[2 * width] );
+			for( std::size_t x = 0; x < width; ++x )
+			{
+				for( std::size_t c = 0; c < 3; ++c )
+					line[x * 3 + c] = planes[c * width + x];
+			}
+		}
+		else if( dpxFile._bitDepth == 10 )
+			dpxReader::unpack10Bits( src, nbDatums, swap, methodA ? 2 : 0, dpxFile._nbComponents == 1, &line[0] );
+		else if( dpxFile._bitDepth == 12 )
+			dpxReader::unpack12Bits( src, nbDatums, swap, methodA, &line[0] );
+		else if( swap )
+			dpxReader::swap16Bits( src, nbDatums, &line[0] );
+		else
+			std::memcpy( &line[0], src, nbDatums * sizeof( boost::uint16_t ) );
+
+		for( std::size_t i = 0; i < nbDatums; ++i )
+		{
+			if( line[i] != expected[y * nbDatums + i] )
+				++nbErrors;
+		}
+	}
+	BOOST_CHECK_EQUAL( nbErrors, 0U );
+}
+
+/**
+ * @brief Read the file with the DPX reader node,
+ * and compare the output lines with the image read by libdpx.
+ */
+void checkReader( const DpxFile& dpxFile )
+{
+	Graph g;
+	Graph::Node& read = g.createNode( "tuttle.dpxreader" );
+	read.getParam( "filename" ).setValue( dpxFile._filepath.string() );
+
+	memory::MemoryCache outputCache;
+	BOOST_REQUIRE( g.compute( outputCache, read ) );
+	memory::CACHE_ELEMENT image = outputCache.get( read.getName(), 0 );
+	BOOST_REQUIRE( image.get() != NULL );
+
+	const OfxRectI bounds = image->getBounds();
+	BOOST_REQUIRE_EQUAL( static_cast<std::size_t>( bounds.x2 - bounds.x1 ), dpxFile._width );
+	BOOST_REQUIRE_EQUAL( static_cast<std::size_t>( bounds.y2 - bounds.y1 ), dpxFile._height );
+	BOOST_REQUIRE_EQUAL( image->getBitDepth(), ofx::imageEffect::eBitDepthUShort );
+	// the RGB images are read in RGBA if the host doesn't support RGB
+	const std::size_t nbChannels = image->getNbComponents();
+	BOOST_REQUIRE_GE( nbChannels, dpxFile._nbComponents );
+
+	const std::vector<boost::uint16_t> expected = dpxFile.expectedImage();
+	const boost::uint8_t* top = image->getOrientedPixelData( attribute::Image::eImageOrientationFromTopToBottom );
+	const int rowDistance = image->getOrientedRowDistanceBytes( attribute::Image::eImageOrientationFromTopToBottom );
+	std::size_t nbErrors = 0;
+	for( std::size_t y = 0; y < dpxFile._height; ++y )
+	{
+		const boost::uint16_t* line = reinterpret_cast<const boost::uint16_t*>( top + static_cast<std::ptrdiff_t>( y ) * rowDistance );
+		for( std::size_t x = 0; x < dpxFile._width; ++x )
+		{
+			for( std::size_t c = 0; c < dpxFile._nbComponents; ++c )
+			{
+				if( line[x * nbChannels + c] != expected[( y * dpxFile._width + x ) * dpxFile._nbComponents + c] )
+					++nbErrors;
+			}
+		}
+	}
+	BOOST_CHECK_EQUAL( nbErrors, 0U );
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE( plugin_Dpx_unpack )
+
+BOOST_AUTO_TEST_CASE( unpack_10bits_rgb )
+{
+	for( int bigEndian = 0; bigEndian < 2; ++bigEndian )
+	{
+		for( int eolnPadding = 0; eolnPadding <= 24; eolnPadding += 24 )
+		{
+			checkUnpack( DpxFile( 37, 5, ::dpx::kRGB, 3, 10, ::dpx::kFilledMethodA, bigEndian, eolnPadding ) );
+			checkUnpack( DpxFile( 37, 5, ::dpx::kRGB, 3, 10, ::dpx::kFilledMethodB, bigEndian, eolnPadding ) );
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE( unpack_10bits_single_channel )
+{
+	// the datums of the words are reversed for the single channel images, like libdpx does
+	for( int bigEndian = 0; bigEndian < 2; ++bigEndian )
+	{
+		for( int eolnPadding = 0; eolnPadding <= 24; eolnPadding += 24 )
+		{
+			for( std::size_t width = 36; width <= 38; ++width )
+			{
+				checkUnpack( DpxFile( width, 5, ::dpx::kLuma, 1, 10, ::dpx::kFilledMethodA, bigEndian, eolnPadding ) );
+				checkUnpack( DpxFile( width, 5, ::dpx::kLuma, 1, 10, ::dpx::kFilledMethodB, bigEndian, eolnPadding ) );
+			}
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE( unpack_10bits_rgba )
+{
+	for( int bigEndian = 0; bigEndian < 2; ++bigEndian )
+	{
+		checkUnpack( DpxFile( 36, 5, ::dpx::kRGBA, 4, 10, ::dpx::kFilledMethodA, bigEndian ) );
+		checkUnpack( DpxFile( 36, 5, ::dpx::kRGBA, 4, 10, ::dpx::kFilledMethodA, bigEndian, 24 ) );
+	}
+}
+
+BOOST_AUTO_TEST_CASE( unpack_12bits )
+{
+	for( int bigEndian = 0; bigEndian < 2; ++bigEndian )
+	{
+		// libdpx doesn't write the end of line padding of the method A
+		checkUnpack( DpxFile( 37, 5, ::dpx::kRGB, 3, 12, ::dpx::kFilledMethodA, bigEndian ) );
+		checkUnpack( DpxFile( 37, 5, ::dpx::kRGB, 3, 12, ::dpx::kFilledMethodB, bigEndian ) );
+		checkUnpack( DpxFile( 37, 5, ::dpx::kRGB, 3, 12, ::dpx::kFilledMethodB, bigEndian, 24 ) );
+	}
+}
+
+BOOST_AUTO_TEST_CASE( unpack_16bits )
+{
+	for( int bigEndian = 0; bigEndian < 2; ++bigEndian )
+		checkUnpack( DpxFile( 37, 5, ::dpx::kRGBA, 4, 16, ::dpx::kFilledMethodA, bigEndian ) );
+}
+
+BOOST_AUTO_TEST_CASE( process_reader_layouts )
+{
+	// lines unpacked from the file
+	checkReader( DpxFile( 37, 23, ::dpx::kRGB, 3, 10, ::dpx::kFilledMethodA, true, 24 ) );
+	checkReader( DpxFile( 37, 23, ::dpx::kRGB, 3, 10, ::dpx::kFilledMethodB, false ) );
+	checkReader( DpxFile( 37, 23, ::dpx::kLuma, 1, 10, ::dpx::kFilledMethodB, false ) );
+	checkReader( DpxFile( 36, 23, ::dpx::kRGBA, 4, 10, ::dpx::kFilledMethodA, true ) );
+	checkReader( DpxFile( 37, 23, ::dpx::kRGB, 3, 12, ::dpx::kFilledMethodA, false ) );
+	checkReader( DpxFile( 37, 23, ::dpx::kRGB, 3, 12, ::dpx::kFilledMethodB, true, 24 ) );
+	checkReader( DpxFile( 37, 23, ::dpx::kRGBA, 4, 16, ::dpx::kFilledMethodA, true ) );
+	// the packed lines are read by libdpx
+	checkReader( DpxFile( 37, 23, ::dpx::kRGB, 3, 10, ::dpx::kPacked, false ) );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -7,6 +7,9 @@
 #include <ImfInputFile.h>
 #include <ImathBox.h>
 #include <ImfChannelList.h>
+#include <ImfThreading.h>
+
+#include <ofxsMultiThread.h>
 
 #include <boost/gil/gil_all.hpp>
 #include <boost/filesystem.hpp>
@@ -40,6 +43,10 @@ EXRReaderPlugin::EXRReaderPlugin( OfxImageEffectHandle handle )
 	
 	_paramFileCompression = fetchChoiceParam( kParamCompression );
 	_paramFileBitDepth = fetchChoiceParam( kParamFileBitDepth );
+
+	// the render is not split by the host, OpenEXR decodes the lines with a thread per core
+	if( Imf::globalThreadCount() == 0 )
+		Imf::setGlobalThreadCount( OFX::MultiThread::getNumCPUs() );
 }
 
 EXRReaderProcessParams EXRReaderPlugin::getProcessParams( const OfxTime time )
@@ -35,6 +35,8 @@ protected:
 	void initExrChannel( DataVector& data, Imf::Slice& slice, Imf::FrameBuffer& frameBuffer, Imf::PixelType pixelType, std::string channelID, const Imath::Box2i& dw );
 	
 	void channelCopy( Imf::InputFile& input, const EXRReaderProcessParams& params, View& dst, const std::size_t nbChannels );
+
+	bool readInPlace( Imf::InputFile& input, const EXRReaderProcessParams& params, View& dst, const std::size_t nbChannels );
 	
 	template<typename workingView>
 	void sliceCopy( Imf::InputFile& input, const Imf::Slice* slice, View& dst, const EXRReaderProcessParams& params, const std::size_t channelIndex );
@@ -48,7 +50,7 @@ public:
 
 	void multiThreadProcessImages( const OfxRectI& procWindowRoW );
 
-	void readImage( const std::string& filepath );
+	void readImage( Imf::InputFile& input );
 };
 
 }
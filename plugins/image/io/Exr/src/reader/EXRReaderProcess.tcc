@@ -30,9 +30,12 @@
 #include <boost/mpl/vector.hpp>
 #include <boost/scoped_ptr.hpp>
 #include <boost/assert.hpp>
+#include <boost/type_traits/is_same.hpp>
 #include <boost/filesystem/fstream.hpp>
 
 #include <algorithm>
+#include <string>
+#include <vector>
 
 namespace tuttle {
 namespace plugin {
@@ -78,12 +81,9 @@ void EXRReaderProcess<View>::multiThreadProcessImages( const OfxRectI& procWindo
 	using namespace terry;
 	BOOST_ASSERT( procWindowRoW == this->_dstPixelRod );
 
-	// TODO: Exr can contain a background color
-	terry::draw::fill_pixels(this->_dstView, terry::numeric::pixel_zeros<Pixel>());
-
 	try
 	{
-		readImage( _params._filepath );
+		readImage( *_exrImage );
 	}
 	catch( boost::exception& e )
 	{
@@ -101,16 +101,13 @@ void EXRReaderProcess<View>::multiThreadProcessImages( const OfxRectI& procWindo
 }
 
 template<class View>
-void EXRReaderProcess<View>::readImage( const std::string& filepath )
+void EXRReaderProcess<View>::readImage( Imf::InputFile& input )
 {
 	using namespace boost;
 	using namespace mpl;
 	using namespace boost::gil;
 	using namespace Imf;
 
-	EXRReaderProcessParams params = _plugin.getProcessParams( this->_renderArgs.time );
-	Imf::InputFile in( filepath.c_str() );
-	
 	int nbChannels = std::min(_params._fileNbChannels, int(num_channels<View>::type::value));
 	nbChannels = std::min(nbChannels, _params._userNbComponents);
 
@@ -120,7 +117,98 @@ void EXRReaderProcess<View>::readImage( const std::string& filepath )
 							   << exception::user() + "EXR: doesn't support " + _params._fileNbChannels + " channels." );
 	}
 
-	channelCopy( in, params, this->_dstView, nbChannels );
+	if( readInPlace( input, _params, this->_dstView, nbChannels ) )
+		return;
+
+	// TODO: Exr can contain a background color
+	terry::draw::fill_pixels( this->_dstView, terry::numeric::pixel_zeros<Pixel>() );
+
+	channelCopy( input, _params, this->_dstView, nbChannels );
+}
+
+/**
+ * @brief Decode the file directly into the output image, without temporary buffers.
+ * OpenEXR converts the half and float channels to the float channels of the output,
+ * the slices use the strides of the output view (negative for a bottom to top image).
+ * @return false if the output is not in float or if the data window is not inside the output image
+ */
+template<class View>
+bool EXRReaderProcess<View>::readInPlace( Imf::InputFile& input, const EXRReaderProcessParams& params, View& dst, const std::size_t nbChannels )
+{
+	using namespace boost::gil;
+	typedef typename channel_type<View>::type Channel;
+
+	if( ! boost::is_same<Channel, bits32f>::value )
+		return false;
+
+	const Imf::Header& header = input.header();
+	const Imath::Box2i& dataWindow = header.dataWindow();
+	// position of the output image in the file
+	const Imath::V2i origin = params._displayWindow ? header.displayWindow().min : dataWindow.min;
+
+	if( dataWindow.isEmpty() ||
+	    dataWindow.min.x < origin.x || dataWindow.min.y < origin.y ||
+	    dataWindow.max.x - origin.x >= dst.width() || dataWindow.max.y - origin.y >= dst.height() )
+		return false;
+
+	const Imf::ChannelList& channelList = header.channels();
+	std::vector<std::string> channelNames( nbChannels );
+	// index of the first output channel with the same file channel
+	std::vector<std::size_t> sourceChannels( nbChannels );
+	for( std::size_t channelIndex = 0; channelIndex < nbChannels; ++channelIndex )
+	{
+		channelNames[channelIndex] = getChannelName( channelIndex );
+		sourceChannels[channelIndex] = std::find( channelNames.begin(), channelNames.begin() + channelIndex, channelNames[channelIndex] ) - channelNames.begin();
+		const Imf::Channel* channel = channelList.findChannel( channelNames[channelIndex].c_str() );
+		if( ! channel ||
+		    ( channel->type != Imf::HALF && channel->type != Imf::FLOAT ) ||
+		    channel->xSampling != 1 || channel->ySampling != 1 )
+			return false;
+	}
+
+	// only fill the pixels which are not decoded
+	if( nbChannels != num_channels<View>::value ||
+	    dataWindow.min != origin ||
+	    dataWindow.max.x - origin.x != dst.width() - 1 || dataWindow.max.y - origin.y != dst.height() - 1 )
+	{
+		terry::draw::fill_pixels( dst, terry::numeric::pixel_zeros<Pixel>() );
+	}
+
+	const std::ptrdiff_t xStride = memunit_step( dst.x_at( 0, 0 ) );
+	const std::ptrdiff_t yStride = dst.pixels().row_size();
+
+	Imf::FrameBuffer frameBuffer;
+	for( std::size_t channelIndex = 0; channelIndex < nbChannels; ++channelIndex )
+	{
+		// the frame buffer has one slice per file channel, the duplicates are copied after the decoding
+		if( sourceChannels[channelIndex] != channelIndex )
+			continue;
+		// address of the pixel (0, 0) of the file, which may be outside of the output
+		char* base = reinterpret_cast<char*>( &dst( 0, 0 )[channelIndex] ) - origin.x * xStride - origin.y * yStride;
+		// OpenEXR uses unsigned strides, a negative stride wraps around like the pointer arithmetic
+		frameBuffer.insert( channelNames[channelIndex].c_str(),
+		                    Imf::Slice( Imf::FLOAT, base,
+		                                static_cast<std::size_t>( xStride ),
+		                                static_cast<std::size_t>( yStride ),
+		                                1, 1, 1.0 ) );
+	}
+
+	input.setFrameBuffer( frameBuffer );
+	input.readPixels( dataWindow.min.y, dataWindow.max.y );
+
+	for( std::size_t channelIndex = 0; channelIndex < nbChannels; ++channelIndex )
+	{
+		const std::size_t sourceChannel = sourceChannels[channelIndex];
+		if( sourceChannel == channelIndex )
+			continue;
+		for( std::ptrdiff_t y = 0; y < dst.height(); ++y )
+		{
+			typename View::x_iterator it = dst.row_begin( y );
+			for( std::ptrdiff_t x = 0; x < dst.width(); ++x, ++it )
+				( *it )[channelIndex] = ( *it )[sourceChannel];
+		}
+	}
+	return true;
 }
 
 template<class View>
@@ -192,21 +280,24 @@ void EXRReaderProcess<View>::channelCopy( Imf::InputFile& input, const EXRReader
 
 	for( size_t channelIndex = 0; channelIndex < nbChannels; ++channelIndex )
 	{
-		switch( slices[channelIndex].type )
+		// the frame buffer keeps one slice per file channel: the last one inserted
+		// for the output channels reading the same file channel
+		const Imf::Slice* slice = frameBuffer.findSlice( getChannelName( channelIndex ).c_str() );
+		switch( slice->type )
 		{
 			case Imf::HALF:
 			{
-				sliceCopy<gray16h_view_t>( input, &slices[channelIndex], dst, params, channelIndex );
+				sliceCopy<gray16h_view_t>( input, slice, dst, params, channelIndex );
 				break;
 			}
 			case Imf::FLOAT:
 			{
-				sliceCopy<gray32f_view_t>( input, &slices[channelIndex], dst, params, channelIndex );
+				sliceCopy<gray32f_view_t>( input, slice, dst, params, channelIndex );
 				break;
 			}
 			case Imf::UINT:
 			{
-				sliceCopy<gray32_view_t>( input, &slices[channelIndex], dst, params, channelIndex );
+				sliceCopy<gray32_view_t>( input, slice, dst, params, channelIndex );
 				break;
 			}
 			case Imf::NUM_PIXELTYPES:
@@ -42,7 +42,7 @@ void EXRWriterPlugin::render( const OFX::RenderArguments& args )
 {
 	WriterPlugin::render( args );
 
-	doGilRender<EXRWriterProcess>( *this, args );
+	doGilRender<WriteBehind<EXRWriterProcess>::Process>( *this, args );
 }
 
 }
@@ -64,6 +64,7 @@ void EXRWriterPluginFactory::describeInContext( OFX::ImageEffectDescriptor& desc
 	dstClip->setSupportsTiles( kSupportTiles );
 
 	describeWriterParamsInContext( desc, context );
+	describeWriteBehindParamInContext( desc, context );
 	
 	OFX::ChoiceParamDescriptor* storageType = desc.defineChoiceParam( kParamStorageType );
 	storageType->setLabel( "Storage type" );
@@ -59,7 +59,7 @@ void EXRWriterProcess<View>::multiThreadProcessImages( const OfxRectI& procWindo
 				{
 					case eTuttlePluginComponentsAuto:
 					{
-						switch ( _plugin._clipSrc->getPixelComponents() )
+						switch ( this->_src->getPixelComponents() )
 						{
 							case OFX::ePixelComponentAlpha:
 								writeImage<gray16h_pixel_t>( src, _params._filepath, Imf::HALF );
@@ -104,7 +104,7 @@ void EXRWriterProcess<View>::multiThreadProcessImages( const OfxRectI& procWindo
 				{
 					case eTuttlePluginComponentsAuto:
 					{
-						switch ( _plugin._clipSrc->getPixelComponents() )
+						switch ( this->_src->getPixelComponents() )
 						{
 							case OFX::ePixelComponentAlpha:
 								writeImage<gray32f_pixel_t>( src, _params._filepath, Imf::FLOAT );
@@ -149,7 +149,7 @@ void EXRWriterProcess<View>::multiThreadProcessImages( const OfxRectI& procWindo
 				{
 					case eTuttlePluginComponentsAuto:
 					{
-						switch ( _plugin._clipSrc->getPixelComponents() )
+						switch ( this->_src->getPixelComponents() )
 						{
 							case OFX::ePixelComponentAlpha:
 								writeImage<gray32_pixel_t>( src, _params._filepath, Imf::HALF );
@@ -275,7 +275,7 @@ void EXRWriterProcess<View>::writeImage( View& src, std::string& filepath, Imf::
 	image_t img( src.width(), src.height() );
 	view_t  dvw( view( img ) );
 	boost::gil::copy_and_convert_pixels( src, dvw );
-	Imf::Header header( src.width(), src.height(), (float) _plugin._clipSrc->getPixelAspectRatio() );
+	Imf::Header header( src.width(), src.height(), (float) this->_src->getPixelAspectRatio() );
 
 	switch( _params._compression )
 	{
@@ -79,6 +79,7 @@ void JpegWriterPluginFactory::describeInContext( OFX::ImageEffectDescriptor& des
 
 	// Controls
 	describeWriterParamsInContext( desc, context );
+	describeWriteBehindParamInContext( desc, context );
 	
 	OFX::ChoiceParamDescriptor* bitDepth = static_cast<OFX::ChoiceParamDescriptor*>( desc.getParamDescriptor( kTuttlePluginBitDepth ) );
 	bitDepth->resetOptions();
@@ -69,7 +69,7 @@ void Jpeg2000WriterPlugin::render( const OFX::RenderArguments &args )
 {
 	WriterPlugin::render( args );
 
-	doGilRender<Jpeg2000WriterProcess>( *this, args );
+	doGilRender<WriteBehind<Jpeg2000WriterProcess>::Process>( *this, args );
 }
 
 }
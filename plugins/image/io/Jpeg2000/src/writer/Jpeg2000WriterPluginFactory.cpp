@@ -71,6 +71,7 @@ void Jpeg2000WriterPluginFactory::describeInContext( OFX::ImageEffectDescriptor
     dstClip->setSupportsTiles( kSupportTiles );
 
 	describeWriterParamsInContext( desc, context );
+	describeWriteBehindParamInContext( desc, context );
 
 	OFX::ChoiceParamDescriptor* channel = static_cast<OFX::ChoiceParamDescriptor*>( desc.getParamDescriptor( kTuttlePluginChannel ) );
 	channel->resetOptions();
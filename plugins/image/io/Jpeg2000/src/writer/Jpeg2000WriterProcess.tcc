@@ -52,7 +52,7 @@ void Jpeg2000WriterProcess<View>::multiThreadProcessImages( const OfxRectI& proc
 	{
 		case eTuttlePluginBitDepthAuto:
 		{
-			switch( _plugin._clipSrc->getPixelDepth() )
+			switch( this->_src->getPixelDepth() )
 			{
 				case OFX::eBitDepthUByte:
 				{
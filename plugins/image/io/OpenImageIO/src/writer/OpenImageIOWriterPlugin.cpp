@@ -39,7 +39,7 @@ void OpenImageIOWriterPlugin::render( const OFX::RenderArguments& args )
 {
 	WriterPlugin::render( args );
 
-	doGilRender<OpenImageIOWriterProcess>( *this, args );
+	doGilRender<WriteBehind<OpenImageIOWriterProcess>::Process>( *this, args );
 }
 
 }
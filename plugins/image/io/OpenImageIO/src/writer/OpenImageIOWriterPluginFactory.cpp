@@ -86,6 +86,7 @@ void OpenImageIOWriterPluginFactory::describeInContext( OFX::ImageEffectDescript
 	
 	// Controls
 	describeWriterParamsInContext( desc, context );
+	describeWriteBehindParamInContext( desc, context );
 	
 	OFX::ChoiceParamDescriptor* bitDepth = static_cast<OFX::ChoiceParamDescriptor*>( desc.getParamDescriptor( kTuttlePluginBitDepth ) );
 	bitDepth->resetOptions();
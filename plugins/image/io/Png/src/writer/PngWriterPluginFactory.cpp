@@ -66,6 +66,7 @@ void PngWriterPluginFactory::describeInContext( OFX::ImageEffectDescriptor& desc
 	dstClip->setSupportsTiles( kSupportTiles );
 
 	describeWriterParamsInContext( desc, context );
+	describeWriteBehindParamInContext( desc, context );
 }
 
 /**
@@ -84,7 +84,7 @@ void PngWriterProcess<View>::writeImage( View& src )
 	{
 		case eTuttlePluginComponentsAuto:
 		{
-			switch ( _plugin._clipSrc->getPixelComponents() )
+			switch ( this->_src->getPixelComponents() )
 			{
 				case OFX::ePixelComponentAlpha:
 				{
@@ -83,6 +83,7 @@ void TurboJpegWriterPluginFactory::describeInContext( OFX::ImageEffectDescriptor
 	
 	// Controls
 	describeWriterParamsInContext( desc, context );
+	describeWriteBehindParamInContext( desc, context );
 	
 	OFX::ChoiceParamDescriptor* channel = static_cast<OFX::ChoiceParamDescriptor*>( desc.getParamDescriptor( kTuttlePluginChannel ) );
 	channel->resetOptions();
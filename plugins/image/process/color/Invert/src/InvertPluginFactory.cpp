@@ -44,6 +44,7 @@ void InvertPluginFactory::describe( OFX::ImageEffectDescriptor& desc )
 
 	// plugin flags
 	desc.setSupportsTiles( kSupportTiles );
+	desc.setSupportsInPlace( true );
 }
 
 /**
@@ -26,27 +26,26 @@ LutPlugin::LutPlugin( OfxImageEffectHandle handle )
  */
 void LutPlugin::render( const OFX::RenderArguments& args )
 {
-	if( !_lutReader.readOk() )
+	doGilRender<LutProcess>( *this, args );
+}
+
+LutCache::LutPtr LutPlugin::getLut() const
+{
+	std::string str;
+	_sFilename->getValue( str );
+	if( ! bfs::exists( str ) )
 	{
-		std::string str;
-		_sFilename->getValue( str );
-		if( ! bfs::exists( str ) )
-		{
-			BOOST_THROW_EXCEPTION( exception::FileNotExist()
-				<< exception::filename(str) );
-		}
-		if( ! _lutReader.read( str ) )
-		{
-			BOOST_THROW_EXCEPTION( exception::File()
-				<< exception::user( "Unable to read lut file." ) );
-		}
-		_lut3D.reset( new TetraInterpolator(), _lutReader );
+		BOOST_THROW_EXCEPTION( exception::FileNotExist()
+			<< exception::filename(str) );
 	}
-	if( !_lutReader.readOk() )
+	LutCache::LutPtr lut = LutCache::instance().get( str );
+	if( ! lut )
 	{
-		BOOST_THROW_EXCEPTION( exception::Unknown() );
+		BOOST_THROW_EXCEPTION( exception::File()
+			<< exception::user( "Unable to read lut file." )
+			<< exception::filename(str) );
 	}
-	doGilRender<LutProcess>( *this, args );
+	return lut;
 }
 
 void LutPlugin::changedParam( const OFX::InstanceChangedArgs& args, const std::string& paramName )
@@ -57,11 +56,8 @@ void LutPlugin::changedParam( const OFX::InstanceChangedArgs& args, const std::s
 		_sFilename->getValue( str );
 		if( bfs::exists( str ) )
 		{
-			if( ! _lutReader.read( str ) )
-			{
-				BOOST_THROW_EXCEPTION( exception::File() << exception::user( "Unable to read lut file..." ) );
-			}
-			_lut3D.reset( new TetraInterpolator(), _lutReader );
+			// read the file now to report errors
+			getLut();
 		}
 	}
 }
@@ -1,8 +1,7 @@
 #ifndef _TUTTLE_PLUGIN_LUTPLUGIN_HPP_
 #define _TUTTLE_PLUGIN_LUTPLUGIN_HPP_
 
-#include "lutEngine/LutReader.hpp"
-#include "lutEngine/Lut.hpp"
+#include "lutEngine/LutCache.hpp"
 
 #include <tuttle/plugin/ImageEffectGilPlugin.hpp>
 
@@ -26,8 +25,8 @@ public:
 public:
 	OFX::StringParam* _sFilename;    ///< Filename
 
-	LutReader _lutReader;               ///< Reader
-	Lut3D _lut3D;
+	/// @brief Get the lut of the file parameter from the LutCache.
+	LutCache::LutPtr getLut() const;
 };
 
 }
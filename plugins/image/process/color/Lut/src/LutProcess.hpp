@@ -2,8 +2,7 @@
 #define _TUTTLE_PLUGIN_LUTPROCESS_HPP_
 
 #include "LutPlugin.hpp"
-#include "lutEngine/LutReader.hpp"
-#include "lutEngine/Lut.hpp"
+#include "lutEngine/LutCache.hpp"
 
 #include <tuttle/plugin/global.hpp>
 #include <tuttle/plugin/ImageGilFilterProcessor.hpp>
@@ -25,12 +24,14 @@ template<class View>
 class LutProcess : public ImageGilFilterProcessor<View>
 {
 private:
-	Lut3D* _lut3D;               ///< Lut3D
+	LutCache::LutPtr _lut;       ///< lut of the render, shared with the LutCache
 	LutPlugin&  _plugin;        ///< Rendering plugin
 
 public:
 	LutProcess<View>( LutPlugin & instance );
 
+	void setup( const OFX::RenderArguments& args );
+
 	void multiThreadProcessImages( const OfxRectI& procWindowRoW );
 
 	// Lut3D Transform
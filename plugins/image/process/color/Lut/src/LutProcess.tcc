@@ -4,9 +4,7 @@
 
 #include "LutProcess.hpp"
 #include "LutDefinitions.hpp"
-#include "lutEngine/LutReader.hpp"
-#include "lutEngine/Lut.hpp"
-#include "lutEngine/TetraInterpolator.hpp"
+#include "lutEngine/FloatLut3D.hpp"
 
 #include <tuttle/plugin/global.hpp>
 #include <tuttle/plugin/ImageGilProcessor.hpp>
@@ -19,6 +17,8 @@
 #include <boost/gil/gil_all.hpp>
 #include <boost/filesystem/fstream.hpp>
 
+#include <vector>
+
 namespace tuttle {
 namespace plugin {
 namespace lut {
@@ -29,8 +29,13 @@ template<class View>
 LutProcess<View>::LutProcess( LutPlugin& instance )
 	: ImageGilFilterProcessor<View>( instance, eImageOrientationIndependant )
 	, _plugin( instance )
+{}
+
+template<class View>
+void LutProcess<View>::setup( const OFX::RenderArguments& args )
 {
-	_lut3D = &_plugin._lut3D;
+	ImageGilFilterProcessor<View>::setup( args );
+	_lut = _plugin.getLut();
 }
 
 /**
@@ -49,26 +54,43 @@ template<class View>
 void LutProcess<View>::applyLut( View& dst, View& src, const OfxRectI& procWindow )
 {
 	using namespace terry;
+	using namespace boost::gil;
 	typedef typename View::x_iterator vIterator;
-	typedef typename channel_type<View>::type Pixel;
+	typedef typename channel_type<View>::type Channel;
 	const OfxPointI procWindowSize = {
 		procWindow.x2 - procWindow.x1,
 		procWindow.y2 - procWindow.y1 };
+	if( procWindowSize.x <= 0 )
+		return;
+
+	// one line of each channel, normalized in [0, 1]
+	std::vector<float> red( procWindowSize.x );
+	std::vector<float> green( procWindowSize.x );
+	std::vector<float> blue( procWindowSize.x );
 
 	for( int y = procWindow.y1; y < procWindow.y2; ++y )
 	{
-		vIterator sit = src.row_begin( y );
-		vIterator dit = dst.row_begin( y );
-		for( int x = procWindow.x1; x < procWindow.x2; ++x )
+		vIterator sit = src.x_at( procWindow.x1, y );
+		for( int x = 0; x < procWindowSize.x; ++x, ++sit )
+		{
+			red[x]   = channel_convert<bits32f>( ( *sit )[0] );
+			green[x] = channel_convert<bits32f>( ( *sit )[1] );
+			blue[x]  = channel_convert<bits32f>( ( *sit )[2] );
+		}
+
+		_lut->apply( FloatLut3D::eInterpolationTetrahedral,
+		             &red[0], &green[0], &blue[0],
+		             &red[0], &green[0], &blue[0],
+		             procWindowSize.x );
+
+		vIterator dit = dst.x_at( procWindow.x1, y );
+		for( int x = 0; x < procWindowSize.x; ++x, ++dit )
 		{
-			tuttle::Color col = _lut3D->getColor( ( *sit )[0], ( *sit )[1], ( *sit )[2] );
-			( *dit )[0] = static_cast<Pixel>( col.x );
-			( *dit )[1] = static_cast<Pixel>( col.y );
-			( *dit )[2] = static_cast<Pixel>( col.z );
+			( *dit )[0] = channel_convert<Channel>( bits32f( red[x] ) );
+			( *dit )[1] = channel_convert<Channel>( bits32f( green[x] ) );
+			( *dit )[2] = channel_convert<Channel>( bits32f( blue[x] ) );
 			if( dst.num_channels() > 3 )
-				( *dit )[3] = channel_traits< typename channel_type< View >::type >::max_value();
-			++sit;
-			++dit;
+				( *dit )[3] = channel_traits<Channel>::max_value();
 		}
 		if( this->progressForward( procWindowSize.x ) )
 			return;
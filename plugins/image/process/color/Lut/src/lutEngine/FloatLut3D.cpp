@@ -0,0 +1,33 @@
+#include "FloatLut3D.hpp"
+
+namespace tuttle {
+
+FloatLut3D::FloatLut3D( LutReader& reader )
+{
+	init( reader.steps().size(), &reader.data()[0] );
+}
+
+FloatLut3D::FloatLut3D( const std::size_t dimSize, const double* data )
+{
+	init( dimSize, data );
+}
+
+void FloatLut3D::init( const std::size_t dimSize, const double* data )
+{
+	_dimSize = dimSize;
+	_maxIndex = static_cast<float>( _dimSize - 1 );
+	_maxCell = static_cast<float>( _dimSize - 2 );
+	_strideX = _dimSize * _dimSize * _strideZ;
+	_strideY = _dimSize * _strideZ;
+	_lattice.assign( _dimSize * _dimSize * _dimSize * _strideZ, 0.f );
+
+	const std::size_t nbNodes = _dimSize * _dimSize * _dimSize;
+	for( std::size_t i = 0; i < nbNodes; ++i )
+	{
+		_lattice[i * _strideZ    ] = static_cast<float>( data[i * 3    ] );
+		_lattice[i * _strideZ + 1] = static_cast<float>( data[i * 3 + 1] );
+		_lattice[i * _strideZ + 2] = static_cast<float>( data[i * 3 + 2] );
+	}
+}
+
+}
@@ -0,0 +1,195 @@
+#ifndef _LUTENGINE_FLOATLUT3D_HPP_
+#define _LUTENGINE_FLOATLUT3D_HPP_
+
+#include "LutReader.hpp"
+
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+
+#if defined( __GNUC__ )
+ #define LUTENGINE_PREFETCH( address ) __builtin_prefetch( address )
+#else
+ #define LUTENGINE_PREFETCH( address )
+#endif
+
+namespace tuttle {
+
+/**
+ * @brief 3D lut in single precision, to apply a lut on lines of pixels.
+ *
+ * Same lattice and interpolations than Lut3D with the Trilin and Tetra
+ * interpolators, without virtual calls. Each node of the lattice is stored
+ * on 4 floats (rgb and a padding) so a node is loaded at once.
+ * The pixels are processed by batches: the cells and the fractions of the
+ * whole batch are computed on separate channels (vectorized by the compiler),
+ * the cells are prefetched, then the nodes are interpolated.
+ */
+class FloatLut3D
+{
+public:
+	enum EInterpolation
+	{
+		eInterpolationTrilinear = 0,
+		eInterpolationTetrahedral
+	};
+
+	static const std::size_t kBatchSize = 8;
+
+public:
+	/**
+	 * @brief Copy the lattice of a lut file read by @p reader.
+	 * @pre reader.readOk(), at least 2 steps and steps^3 rgb values
+	 */
+	explicit FloatLut3D( LutReader& reader );
+	/**
+	 * @brief Copy a lattice of @p dimSize^3 rgb values, in the order of the lut files (blue first).
+	 * @pre dimSize >= 2
+	 */
+	FloatLut3D( const std::size_t dimSize, const double* data );
+
+	std::size_t dimSize() const { return _dimSize; }
+
+	/**
+	 * @brief Apply the lut on @p size pixels, given as separate channels with values in [0, 1].
+	 * The output channels may be the input channels.
+	 */
+	inline void apply( const EInterpolation interpolation,
+	                   const float* r, const float* g, const float* b,
+	                   float* outR, float* outG, float* outB,
+	                   const std::size_t size ) const;
+
+private:
+	void init( const std::size_t dimSize, const double* data );
+
+	inline void interpolateTrilinear( const float* node, const float fx, const float fy, const float fz, float& r, float& g, float& b ) const;
+	inline void interpolateTetrahedral( const float* node, const float fx, const float fy, const float fz, float& r, float& g, float& b ) const;
+
+private:
+	std::size_t _dimSize;
+	float _maxIndex; ///< index of the last node on each axis
+	float _maxCell; ///< index of the last cell on each axis
+	std::size_t _strideX; ///< floats between two nodes on red
+	std::size_t _strideY; ///< floats between two nodes on green
+	static const std::size_t _strideZ = 4; ///< floats between two nodes on blue
+	std::vector<float> _lattice;
+};
+
+inline void FloatLut3D::apply( const EInterpolation interpolation,
+                               const float* r, const float* g, const float* b,
+                               float* outR, float* outG, float* outB,
+                               const std::size_t size ) const
+{
+	std::size_t cell[kBatchSize];
+	float fx[kBatchSize];
+	float fy[kBatchSize];
+	float fz[kBatchSize];
+	const float* lattice = &_lattice[0];
+
+	for( std::size_t begin = 0; begin < size; begin += kBatchSize )
+	{
+		const std::size_t batchSize = size - begin < kBatchSize ? size - begin : kBatchSize;
+
+		for( std::size_t i = 0; i < batchSize; ++i )
+		{
+			// clamp, NaN goes to 0
+			float x = r[begin + i] * _maxIndex;
+			float y = g[begin + i] * _maxIndex;
+			float z = b[begin + i] * _maxIndex;
+			x = x > 0.f ? ( x < _maxIndex ? x : _maxIndex ) : 0.f;
+			y = y > 0.f ? ( y < _maxIndex ? y : _maxIndex ) : 0.f;
+			z = z > 0.f ? ( z < _maxIndex ? z : _maxIndex ) : 0.f;
+			// the last node uses the last cell with a fraction of 1
+			const float x0 = std::min( static_cast<float>( static_cast<int>( x ) ), _maxCell );
+			const float y0 = std::min( static_cast<float>( static_cast<int>( y ) ), _maxCell );
+			const float z0 = std::min( static_cast<float>( static_cast<int>( z ) ), _maxCell );
+			fx[i] = x - x0;
+			fy[i] = y - y0;
+			fz[i] = z - z0;
+			cell[i] = static_cast<std::size_t>( x0 ) * _strideX + static_cast<std::size_t>( y0 ) * _strideY + static_cast<std::size_t>( z0 ) * _strideZ;
+		}
+
+		// the nodes of a cell are on 4 cache lines
+		for( std::size_t i = 0; i < batchSize; ++i )
+		{
+			const float* node = lattice + cell[i];
+			LUTENGINE_PREFETCH( node );
+			LUTENGINE_PREFETCH( node + _strideY );
+			LUTENGINE_PREFETCH( node + _strideX );
+			LUTENGINE_PREFETCH( node + _strideX + _strideY );
+		}
+
+		if( interpolation == eInterpolationTetrahedral )
+		{
+			for( std::size_t i = 0; i < batchSize; ++i )
+				interpolateTetrahedral( lattice + cell[i], fx[i], fy[i], fz[i], outR[begin + i], outG[begin + i], outB[begin + i] );
+		}
+		else
+		{
+			for( std::size_t i = 0; i < batchSize; ++i )
+				interpolateTrilinear( lattice + cell[i], fx[i], fy[i], fz[i], outR[begin + i], outG[begin + i], outB[begin + i] );
+		}
+	}
+}
+
+inline void FloatLut3D::interpolateTrilinear( const float* node, const float fx, const float fy, const float fz, float& r, float& g, float& b ) const
+{
+	const float* p000 = node;
+	const float* p001 = node + _strideZ;
+	const float* p010 = node + _strideY;
+	const float* p011 = p010 + _strideZ;
+	const float* p100 = node + _strideX;
+	const float* p101 = p100 + _strideZ;
+	const float* p110 = p100 + _strideY;
+	const float* p111 = p110 + _strideZ;
+
+	float res[3];
+	for( std::size_t c = 0; c < 3; ++c )
+	{
+		const float c00 = p000[c] + ( p001[c] - p000[c] ) * fz;
+		const float c01 = p010[c] + ( p011[c] - p010[c] ) * fz;
+		const float c10 = p100[c] + ( p101[c] - p100[c] ) * fz;
+		const float c11 = p110[c] + ( p111[c] - p110[c] ) * fz;
+		const float c0 = c00 + ( c01 - c00 ) * fy;
+		const float c1 = c10 + ( c11 - c10 ) * fy;
+		res[c] = c0 + ( c1 - c0 ) * fx;
+	}
+	r = res[0];
+	g = res[1];
+	b = res[2];
+}
+
+inline void FloatLut3D::interpolateTetrahedral( const float* node, const float fx, const float fy, const float fz, float& r, float& g, float& b ) const
+{
+	// the tetrahedron goes from p000 to p111 through the axes sorted by decreasing fraction
+	std::size_t first, second; // strides of the first and second axes
+	float f1, f2, f3; // sorted fractions
+	if( fx >= fy )
+	{
+		if( fy >= fz )      { first = _strideX; second = _strideY; f1 = fx; f2 = fy; f3 = fz; } // T1
+		else if( fx >= fz ) { first = _strideX; second = _strideZ; f1 = fx; f2 = fz; f3 = fy; } // T2
+		else                { first = _strideZ; second = _strideX; f1 = fz; f2 = fx; f3 = fy; } // T3
+	}
+	else
+	{
+		if( fx >= fz )      { first = _strideY; second = _strideX; f1 = fy; f2 = fx; f3 = fz; } // T4
+		else if( fy >= fz ) { first = _strideY; second = _strideZ; f1 = fy; f2 = fz; f3 = fx; } // T5
+		else                { first = _strideZ; second = _strideY; f1 = fz; f2 = fy; f3 = fx; } // T6
+	}
+	const float* p0 = node;
+	const float* p1 = node + first;
+	const float* p2 = p1 + second;
+	const float* p3 = node + _strideX + _strideY + _strideZ;
+	const float w0 = 1.f - f1;
+	const float w1 = f1 - f2;
+	const float w2 = f2 - f3;
+	const float w3 = f3;
+
+	r = w0 * p0[0] + w1 * p1[0] + w2 * p2[0] + w3 * p3[0];
+	g = w0 * p0[1] + w1 * p1[1] + w2 * p2[1] + w3 * p3[1];
+	b = w0 * p0[2] + w1 * p1[2] + w2 * p2[2] + w3 * p3[2];
+}
+
+}
+
+#endif
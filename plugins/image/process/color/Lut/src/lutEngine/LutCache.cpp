@@ -0,0 +1,52 @@
+#include "LutCache.hpp"
+#include "LutReader.hpp"
+
+#include <boost/filesystem/operations.hpp>
+
+namespace tuttle {
+
+LutCache& LutCache::instance()
+{
+	// created on first use, when the OFX suites are available
+	static LutCache cache;
+	return cache;
+}
+
+LutCache::LutPtr LutCache::get( const boost::filesystem::path& filename )
+{
+	const std::string key = filename.string();
+	boost::system::error_code error;
+	const std::time_t lastWriteTime = boost::filesystem::last_write_time( filename, error );
+	if( error )
+		return LutPtr();
+
+	{
+		OFX::MultiThread::AutoMutex lock( _mutex );
+		ElementMap::const_iterator it = _elements.find( key );
+		if( it != _elements.end() && it->second._lastWriteTime == lastWriteTime )
+			return it->second._lut;
+	}
+
+	// read the file without the lock, the other luts stay available
+	LutReader reader;
+	if( ! reader.read( filename ) )
+		return LutPtr();
+	const std::size_t dimSize = reader.steps().size();
+	if( dimSize < 2 || reader.data().size() != dimSize * dimSize * dimSize * 3 )
+		return LutPtr();
+	LutPtr lut( new FloatLut3D( reader ) );
+
+	OFX::MultiThread::AutoMutex lock( _mutex );
+	Element& element = _elements[key];
+	element._lastWriteTime = lastWriteTime;
+	element._lut = lut;
+	return lut;
+}
+
+void LutCache::clear()
+{
+	OFX::MultiThread::AutoMutex lock( _mutex );
+	_elements.clear();
+}
+
+}
@@ -0,0 +1,55 @@
+#ifndef _LUTENGINE_LUTCACHE_HPP_
+#define _LUTENGINE_LUTCACHE_HPP_
+
+#include "FloatLut3D.hpp"
+
+#include <ofxsMultiThread.h>
+
+#include <boost/filesystem/path.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <map>
+#include <string>
+#include <ctime>
+
+namespace tuttle {
+
+/**
+ * @brief Luts read from files, shared by all the plugin instances.
+ *
+ * A file is read again only if its last modification time has changed.
+ */
+class LutCache
+{
+public:
+	typedef boost::shared_ptr<const FloatLut3D> LutPtr;
+
+public:
+	static LutCache& instance();
+
+	/**
+	 * @brief Get the lut of a file, read it if needed.
+	 * @return an empty pointer if the file can't be read as a lut
+	 */
+	LutPtr get( const boost::filesystem::path& filename );
+
+	void clear();
+
+private:
+	LutCache() {}
+
+private:
+	struct Element
+	{
+		std::time_t _lastWriteTime;
+		LutPtr _lut;
+	};
+	typedef std::map<std::string, Element> ElementMap;
+
+	OFX::MultiThread::Mutex _mutex;
+	ElementMap _elements;
+};
+
+}
+
+#endif
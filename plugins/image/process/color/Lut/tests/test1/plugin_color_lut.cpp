@@ -3,6 +3,128 @@
 #define BOOST_TEST_MODULE test_plugin_lut
 #include <boost/test/unit_test.hpp>
 
+// the lut engine is not in a library, build the parts used by the tests
+#include "../../src/lutEngine/AbstractLut.cpp"
+#include "../../src/lutEngine/Interpolator.cpp"
+#include "../../src/lutEngine/TrilinInterpolator.cpp"
+#include "../../src/lutEngine/TetraInterpolator.cpp"
+#include "../../src/lutEngine/Lut.cpp"
+#include "../../src/lutEngine/FloatLut3D.cpp"
+
+#include <boost/filesystem/path.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_real.hpp>
+#include <boost/random/variate_generator.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace tuttle;
+
+namespace {
+
+/**
+ * @brief Read the lattice of a 3dl file, normalized like LutReader.
+ * LutReader can't be used without a host, it allocates with the OFX memory suite.
+ */
+std::size_t read3dl( const boost::filesystem::path& filename, std::vector<double>& data )
+{
+	boost::filesystem::ifstream file( filename );
+	std::size_t dimSize = 0;
+	std::string line;
+	while( std::getline( file, line ) )
+	{
+		const std::size_t first = line.find_first_not_of( " \t\r" );
+		if( first == std::string::npos || line[first] == '#' )
+			continue;
+		std::istringstream values( line );
+		double value;
+		if( dimSize == 0 )
+		{
+			// the first line gives the input steps
+			while( values >> value )
+				++dimSize;
+			continue;
+		}
+		while( values >> value )
+			data.push_back( value );
+	}
+	const double max = *std::max_element( data.begin(), data.end() );
+	const double norm = 1.0 / std::pow( 2.0, std::ceil( std::log( max ) / std::log( 2.0 ) ) );
+	for( std::vector<double>::iterator it = data.begin(); it != data.end(); ++it )
+		*it *= norm;
+	return dimSize;
+}
+
+/// @brief A smooth lut mixing the channels, far from the identity.
+std::size_t buildLut( const std::size_t dimSize, std::vector<double>& data )
+{
+	const double step = 1.0 / ( dimSize - 1 );
+	for( std::size_t x = 0; x < dimSize; ++x )
+	{
+		for( std::size_t y = 0; y < dimSize; ++y )
+		{
+			for( std::size_t z = 0; z < dimSize; ++z )
+			{
+				const double r = x * step;
+				const double g = y * step;
+				const double b = z * step;
+				data.push_back( 0.8 * std::pow( r, 0.45 ) + 0.2 * b );
+				data.push_back( 0.5 * g * g + 0.3 * r + 0.1 );
+				data.push_back( 1.0 - 0.7 * b + 0.2 * std::sin( 3.0 * g ) );
+			}
+		}
+	}
+	return dimSize;
+}
+
+/// @brief Check the float tetrahedral interpolation against Lut3D with the TetraInterpolator.
+void checkTetrahedral( const std::size_t dimSize, std::vector<double>& data )
+{
+	BOOST_REQUIRE_GE( dimSize, 2U );
+	BOOST_REQUIRE_EQUAL( data.size(), dimSize * dimSize * dimSize * 3 );
+
+	const FloatLut3D floatLut( dimSize, &data[0] );
+	// the Lut3D deletes its data
+	double* lutData = new double[data.size()];
+	std::copy( data.begin(), data.end(), lutData );
+	const Lut3D lut( new TetraInterpolator(), dimSize, lutData );
+
+	// values in [0, 1[, the TetraInterpolator reads outside of the lattice for 1
+	boost::mt19937 generator( 42 );
+	boost::variate_generator<boost::mt19937&, boost::uniform_real<float> > randomValue( generator, boost::uniform_real<float>( 0.f, 0.99999f ) );
+	const std::size_t size = 10000 + 3; // not a multiple of the batch size
+	std::vector<float> r( size ), g( size ), b( size );
+	for( std::size_t i = 0; i < size; ++i )
+	{
+		r[i] = randomValue();
+		g[i] = randomValue();
+		b[i] = randomValue();
+	}
+	// the nodes themselves
+	r[0] = g[0] = b[0] = 0.f;
+	r[1] = 0.5f; g[1] = 0.25f; b[1] = 0.75f;
+
+	std::vector<float> outR( size ), outG( size ), outB( size );
+	floatLut.apply( FloatLut3D::eInterpolationTetrahedral, &r[0], &g[0], &b[0], &outR[0], &outG[0], &outB[0], size );
+
+	double maxError = 0.0;
+	for( std::size_t i = 0; i < size; ++i )
+	{
+		const Color expected = lut.getColor( r[i], g[i], b[i] );
+		maxError = std::max( maxError, std::abs( expected.x - outR[i] ) );
+		maxError = std::max( maxError, std::abs( expected.y - outG[i] ) );
+		maxError = std::max( maxError, std::abs( expected.z - outB[i] ) );
+	}
+	BOOST_CHECK_SMALL( maxError, 1e-5 );
+}
+
+}
+
 BOOST_AUTO_TEST_SUITE( plugin_lut )
 
 using namespace boost::unit_test;
@@ -12,5 +134,19 @@ BOOST_AUTO_TEST_CASE( plugin_lut_test_01 )
 	BOOST_CHECK_EQUAL( 1.0, 1.0 );
 }
 
+BOOST_AUTO_TEST_CASE( plugin_lut_float_tetrahedral_identity )
+{
+	std::vector<double> data;
+	const std::size_t dimSize = read3dl( boost::filesystem::path( __FILE__ ).parent_path() / "ident.3dl", data );
+	BOOST_CHECK_EQUAL( dimSize, 17U );
+	checkTetrahedral( dimSize, data );
+}
+
+BOOST_AUTO_TEST_CASE( plugin_lut_float_tetrahedral )
+{
+	std::vector<double> data;
+	const std::size_t dimSize = buildLut( 9, data );
+	checkTetrahedral( dimSize, data );
+}
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -24,6 +24,20 @@ enum EParamBorder
 	eParamBorderPadded
 };
 
+static const std::string kParamMethod                  = "method";
+static const std::string kParamMethodConvolution       = "Convolution";
+static const std::string kParamMethodRecursiveGaussian = "RecursiveGaussian";
+static const std::string kParamMethodDeriche           = "Deriche";
+static const std::string kParamMethodBox               = "Box";
+
+enum EParamMethod
+{
+	eParamMethodConvolution = 0,
+	eParamMethodRecursiveGaussian,
+	eParamMethodDeriche,
+	eParamMethodBox
+};
+
 static const std::string kParamGroupAdvanced = "advanced";
 static const std::string kParamNormalizedKernel = "normalizedKernel";
 static const std::string kParamKernelEpsilon = "kernelEpsilon";
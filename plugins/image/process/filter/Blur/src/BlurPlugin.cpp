@@ -6,6 +6,8 @@
 
 #include <boost/gil/gil_all.hpp>
 
+#include <cmath>
+
 namespace tuttle {
 namespace plugin {
 namespace blur {
@@ -15,6 +17,7 @@ BlurPlugin::BlurPlugin( OfxImageEffectHandle handle )
 {
 	_paramSize   = fetchDouble2DParam( kParamSize );
 	_paramBorder = fetchChoiceParam( kParamBorder );
+	_paramMethod = fetchChoiceParam( kParamMethod );
 	_paramNormalizedKernel = fetchBooleanParam( kParamNormalizedKernel );
 	_paramKernelEpsilon = fetchDoubleParam( kParamKernelEpsilon );
 }
@@ -26,12 +29,41 @@ BlurProcessParams<BlurPlugin::Scalar> BlurPlugin::getProcessParams( const OfxPoi
 	BlurProcessParams<Scalar> params;
 	params._size   = ofxToGil( _paramSize->getValue() ) * ofxToGil( renderScale  );
 	params._border = static_cast<EParamBorder>( _paramBorder->getValue() );
+	params._method = static_cast<EParamMethod>( _paramMethod->getValue() );
+	// the kernel of buildGaussian1DKernel has a variance of size
+	params._sigma.x = std::sqrt( params._size.x );
+	params._sigma.y = std::sqrt( params._size.y );
 
-	const bool normalizedKernel = _paramNormalizedKernel->getValue();
-	const double kernelEpsilon = _paramKernelEpsilon->getValue();
-
-	params._gilKernelX = buildGaussian1DKernel<Scalar>( params._size.x, normalizedKernel, kernelEpsilon );
-	params._gilKernelY = buildGaussian1DKernel<Scalar>( params._size.y, normalizedKernel, kernelEpsilon );
+	params._recursiveMethod = recursive_blur_young_van_vliet;
+	switch( params._method )
+	{
+		case eParamMethodConvolution:
+		{
+			const bool normalizedKernel = _paramNormalizedKernel->getValue();
+			const double kernelEpsilon = _paramKernelEpsilon->getValue();
+
+			params._gilKernelX = buildGaussian1DKernel<Scalar>( params._size.x, normalizedKernel, kernelEpsilon );
+			params._gilKernelY = buildGaussian1DKernel<Scalar>( params._size.y, normalizedKernel, kernelEpsilon );
+			// the kernels are symmetric
+			params._margin.x = params._gilKernelX.left_size();
+			params._margin.y = params._gilKernelY.left_size();
+			break;
+		}
+		case eParamMethodRecursiveGaussian:
+			params._recursiveMethod = recursive_blur_young_van_vliet;
+			break;
+		case eParamMethodDeriche:
+			params._recursiveMethod = recursive_blur_deriche;
+			break;
+		case eParamMethodBox:
+			params._recursiveMethod = recursive_blur_box;
+			break;
+	}
+	if( params._method != eParamMethodConvolution )
+	{
+		params._margin.x = static_cast<int>( recursive_blur_margin( params._sigma.x, params._recursiveMethod ) );
+		params._margin.y = static_cast<int>( recursive_blur_margin( params._sigma.y, params._recursiveMethod ) );
+	}
 	
 	params._boundary_option = convolve_option_extend_mirror;
 	switch( params._border )
@@ -76,18 +108,18 @@ bool BlurPlugin::getRegionOfDefinition( const OFX::RegionOfDefinitionArguments&
 	switch( params._border )
 	{
 		case eParamBorderPadded:
-			rod.x1 = srcRod.x1 + params._gilKernelX.left_size();
-			rod.y1 = srcRod.y1 + params._gilKernelY.left_size();
-			rod.x2 = srcRod.x2 - params._gilKernelX.right_size();
-			rod.y2 = srcRod.y2 - params._gilKernelY.right_size();
+			rod.x1 = srcRod.x1 + params._margin.x;
+			rod.y1 = srcRod.y1 + params._margin.y;
+			rod.x2 = srcRod.x2 - params._margin.x;
+			rod.y2 = srcRod.y2 - params._margin.y;
 			return true;
 		case eParamBorderBlack:
 		case eParamBorderConstant:
 		case eParamBorderMirror:
-			rod.x1 = srcRod.x1 - params._gilKernelX.left_size();
-			rod.y1 = srcRod.y1 - params._gilKernelY.left_size();
-			rod.x2 = srcRod.x2 + params._gilKernelX.right_size();
-			rod.y2 = srcRod.y2 + params._gilKernelY.right_size();
+			rod.x1 = srcRod.x1 - params._margin.x;
+			rod.y1 = srcRod.y1 - params._margin.y;
+			rod.x2 = srcRod.x2 + params._margin.x;
+			rod.y2 = srcRod.y2 + params._margin.y;
 			return true;
 		case eParamBorderNo:
 			return false; // don't modify the source image RoD
@@ -102,10 +134,10 @@ void BlurPlugin::getRegionsOfInterest( const OFX::RegionsOfInterestArguments& ar
 	OfxRectD srcRod                  = _clipSrc->getCanonicalRod( args.time );
 
 	OfxRectD srcRoi;
-	srcRoi.x1 = srcRod.x1 - params._gilKernelX.left_size();
-	srcRoi.y1 = srcRod.y1 - params._gilKernelY.left_size();
-	srcRoi.x2 = srcRod.x2 + params._gilKernelX.right_size();
-	srcRoi.y2 = srcRod.y2 + params._gilKernelY.right_size();
+	srcRoi.x1 = srcRod.x1 - params._margin.x;
+	srcRoi.y1 = srcRod.y1 - params._margin.y;
+	srcRoi.x2 = srcRod.x2 + params._margin.x;
+	srcRoi.y2 = srcRod.y2 + params._margin.y;
 	rois.setRegionOfInterest( *_clipSrc, srcRoi );
 }
 
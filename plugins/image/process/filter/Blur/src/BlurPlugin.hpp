@@ -5,6 +5,7 @@
 #include <tuttle/plugin/ImageEffectGilPlugin.hpp>
 
 #include <terry/filter/convolve.hpp>
+#include <terry/filter/recursiveBlur.hpp>
 
 #include <boost/gil/gil_all.hpp>
 
@@ -19,6 +20,10 @@ struct BlurProcessParams
 	terry::point2<double> _size;
 	EParamBorder _border;
 	terry::filter::convolve_boundary_option _boundary_option;
+	EParamMethod _method;
+	terry::filter::recursive_blur_method _recursiveMethod;
+	terry::point2<double> _sigma; ///< standard deviation of the gaussian
+	terry::point2<int> _margin; ///< source pixels needed on each side of an output pixel
 
 	Kernel _gilKernelX;
 	Kernel _gilKernelY;
@@ -48,6 +53,7 @@ public:
 public:
 	OFX::Double2DParam* _paramSize;
 	OFX::ChoiceParam* _paramBorder;
+	OFX::ChoiceParam* _paramMethod;
 	OFX::BooleanParam* _paramNormalizedKernel;
 	OFX::DoubleParam* _paramKernelEpsilon;
 };
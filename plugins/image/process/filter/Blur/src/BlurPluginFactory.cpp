@@ -97,19 +97,28 @@ void BlurPluginFactory::describeInContext( OFX::ImageEffectDescriptor& desc,
 	border->appendOption( kParamBorderPadded );
 	border->setDefault( eParamBorderMirror );
 
+	OFX::ChoiceParamDescriptor* method = desc.defineChoiceParam( kParamMethod );
+	method->setLabel( "Method" );
+	method->appendOption( kParamMethodConvolution, "Convolution: exact gaussian, slow for big sizes" );
+	method->appendOption( kParamMethodRecursiveGaussian, "Recursive gaussian (Young - van Vliet): constant cost whatever the size" );
+	method->appendOption( kParamMethodDeriche, "Deriche: recursive, constant cost whatever the size" );
+	method->appendOption( kParamMethodBox, "Box: 3 iterated box filters, constant cost whatever the size" );
+	method->setHint( "Algorithm used to compute the blur. The recursive methods approximate the gaussian." );
+	method->setDefault( eParamMethodConvolution );
+
 	OFX::GroupParamDescriptor* advanced = desc.defineGroupParam( kParamGroupAdvanced );
 	advanced->setLabel( "Advanced" );
 	advanced->setOpen( false );
 
 	OFX::BooleanParamDescriptor* normalizedKernel = desc.defineBooleanParam( kParamNormalizedKernel );
 	normalizedKernel->setLabel( "Normalized kernel" );
-	normalizedKernel->setHint( "Use a normalized kernel to compute the gradient." );
+	normalizedKernel->setHint( "Use a normalized kernel to compute the gradient (Convolution method)." );
 	normalizedKernel->setDefault( true );
 	normalizedKernel->setParent( advanced );
 
 	OFX::DoubleParamDescriptor* kernelEpsilon = desc.defineDoubleParam( kParamKernelEpsilon );
 	kernelEpsilon->setLabel( "Kernel espilon value" );
-	kernelEpsilon->setHint( "Threshold at which we no longer consider the values of the function." );
+	kernelEpsilon->setHint( "Threshold at which we no longer consider the values of the function (Convolution method)." );
 	kernelEpsilon->setDefault( 0.01 );
 	kernelEpsilon->setRange( std::numeric_limits<double>::epsilon(), 1.0 );
 	kernelEpsilon->setDisplayRange( 0, 0.01 );
@@ -2,6 +2,7 @@
 
 #include <terry/filter/gaussianKernel.hpp>
 #include <terry/filter/convolve.hpp>
+#include <terry/filter/recursiveBlur.hpp>
 
 #include <tuttle/plugin/memory/OfxAllocator.hpp>
 
@@ -21,6 +22,10 @@ void BlurProcess<View>::setup( const OFX::RenderArguments& args )
 	ImageGilFilterProcessor<View>::setup( args );
 	_params = _plugin.getProcessParams( args.renderScale );
 
+	// each call filters the margins again, so use big windows
+	if( _params._method != eParamMethodConvolution )
+		this->setProcessSchedule( eProcessScheduleBands );
+
 	//	TUTTLE_LOG_VAR( TUTTLE_INFO, _params._size );
 	//	TUTTLE_LOG_VAR2( TUTTLE_INFO, _params._gilKernelX.size(), _params._gilKernelY.size() );
 	//	std::cout << "x [";
@@ -52,7 +57,11 @@ void BlurProcess<View>::multiThreadProcessImages( const OfxRectI& procWindowRoW
 
 	const Point proc_tl( procWindowRoW.x1 - this->_srcPixelRod.x1, procWindowRoW.y1 - this->_srcPixelRod.y1 );
 
-	if( _params._size.x == 0 )
+	if( _params._method != eParamMethodConvolution )
+	{
+		recursive_blur<OfxAllocator>( this->_srcView, dst, proc_tl, _params._sigma, _params._recursiveMethod, _params._boundary_option );
+	}
+	else if( _params._size.x == 0 )
 	{
 		correlate_cols_auto<Pixel>( this->_srcView, _params._gilKernelY, dst, proc_tl, _params._boundary_option );
 	}
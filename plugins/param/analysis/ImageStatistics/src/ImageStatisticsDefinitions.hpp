@@ -24,6 +24,7 @@ enum EParamCoordinateSystem
 
 static const std::string kParamRectCenter  = "rectCenter";
 static const std::string kParamRectSize    = "rectSize";
+static const std::string kParamSubsample   = "subsample";
 static const std::string kParamOutputGroup = "outputGroup";
 
 static const std::string kParamOutputGroupRGBA     = "outputGroupRGBA";
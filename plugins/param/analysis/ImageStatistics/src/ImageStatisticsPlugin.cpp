@@ -23,6 +23,7 @@ ImageStatisticsPlugin::ImageStatisticsPlugin( OfxImageEffectHandle handle )
 	_paramCoordinateSystem = fetchChoiceParam( kParamCoordinateSystem );
 	_paramRectCenter       = fetchDouble2DParam( kParamRectCenter );
 	_paramRectSize         = fetchDouble2DParam( kParamRectSize );
+	_paramSubsample        = fetchIntParam( kParamSubsample );
 	_paramChooseOutput     = fetchChoiceParam( kParamChooseOutput );
 
 	_paramOutputNbPixels = fetchIntParam( kParamOutputNbPixels );
@@ -86,6 +87,7 @@ ImageStatisticsProcessParams ImageStatisticsPlugin::getProcessParams( const OfxT
 	params._rect *= renderScale;
 
 	params._chooseOutput = static_cast<EParamChooseOutput>( _paramChooseOutput->getValue() );
+	params._subsample = _paramSubsample->getValue();
 
 	return params;
 }
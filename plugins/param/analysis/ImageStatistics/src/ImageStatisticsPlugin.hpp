@@ -12,6 +12,7 @@ struct ImageStatisticsProcessParams
 {
 	OfxRectI _rect; ///< the selected rectangle, clipped to the image rod
 	EParamChooseOutput _chooseOutput;
+	int _subsample; ///< use one pixel every _subsample pixels on each axis
 };
 
 /**
@@ -36,6 +37,7 @@ public:
 	OFX::ChoiceParam* _paramCoordinateSystem;
 	OFX::Double2DParam* _paramRectCenter;
 	OFX::Double2DParam* _paramRectSize;
+	OFX::IntParam* _paramSubsample;
 	OFX::ChoiceParam* _paramChooseOutput;
 
 	OFX::IntParam* _paramOutputNbPixels;
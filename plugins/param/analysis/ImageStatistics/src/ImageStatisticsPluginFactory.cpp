@@ -126,6 +126,15 @@ void ImageStatisticsPluginFactory::describeInContext( OFX::ImageEffectDescriptor
 	//	rectSize->setDoubleType( OFX::eDoubleTypeNormalisedXYAbsolute );
 	rectSize->setDefault( 0.5, 0.5 );
 	rectSize->setParent(selectRegionGroup);
+
+	OFX::IntParamDescriptor* subsample = desc.defineIntParam( kParamSubsample );
+	subsample->setLabel( "Subsample" );
+	subsample->setHint(
+		"Use one pixel every n pixels on each axis.\n"
+		"Faster on big images for an interactive use, but the statistics are approximated." );
+	subsample->setDefault( 1 );
+	subsample->setRange( 1, 1024 );
+	subsample->setDisplayRange( 1, 16 );
 	
 	// -----------------------------------------------------------------------------
 	
@@ -137,9 +146,9 @@ void ImageStatisticsPluginFactory::describeInContext( OFX::ImageEffectDescriptor
 	outputNbPixels->setLabel( "Nb Pixels" );
 	outputNbPixels->setHint(
 		"Number of pixels used to compute statistics.\n"
-		"It depends on the number of non 0 values in the input mask and "
-		"the intersection between: input image RoD, input mask RoD and "
-		"user defined region." );
+		"It depends on the number of non 0 values in the input mask, "
+		"the subsample and the intersection between: input image RoD, "
+		"input mask RoD and user defined region." );
 	outputNbPixels->setEvaluateOnChange( false );
 	outputNbPixels->setParent( outputGroup );
 
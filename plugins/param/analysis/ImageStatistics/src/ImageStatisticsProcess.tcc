@@ -21,6 +21,11 @@
 #include <boost/mpl/erase.hpp>
 #include <boost/mpl/find.hpp>
 
+#include <ofxsMultiThread.h>
+
+#include <vector>
+#include <algorithm>
+
 /*
 namespace boost {
 namespace gil {
@@ -173,6 +178,7 @@ template<class Pixel>
 struct OutputParams
 {
 	OutputParams()
+		: _nbPixels( 0 )
 	{
 		using namespace terry::numeric;
 		pixel_zeros_t<Pixel>( )( _average );
@@ -197,142 +203,343 @@ struct OutputParams
 	std::size_t _nbPixels;
 };
 
+/**
+ * @brief Sum of each channel, with a compensation of the rounding errors (Kahan summation).
+ */
+template<class CPixel>
+struct PixelCompensatedSum
+{
+	PixelCompensatedSum()
+	{
+		using namespace terry::numeric;
+		pixel_zeros_t<CPixel>( )( _sum );
+		pixel_zeros_t<CPixel>( )( _compensation );
+	}
+
+	void add( const CPixel& value )
+	{
+		using namespace boost::gil;
+		for( int i = 0; i < num_channels<CPixel>::type::value; ++i )
+		{
+			const double y = value[i] - _compensation[i];
+			const double t = _sum[i] + y;
+			_compensation[i] = ( t - _sum[i] ) - y;
+			_sum[i] = t;
+		}
+	}
+
+	CPixel get() const
+	{
+		using namespace boost::gil;
+		CPixel res;
+		for( int i = 0; i < num_channels<CPixel>::type::value; ++i )
+		{
+			res[i] = _sum[i] - _compensation[i];
+		}
+		return res;
+	}
+
+	CPixel _sum;
+	CPixel _compensation; ///< rounding errors of the previous additions
+};
+
+/**
+ * @brief Statistics of a part of the image.
+ */
+template<class Pixel, class PixelGray, class CPixel>
+struct StatisticsAccumulator
+{
+	StatisticsAccumulator()
+		: _nbPixels( 0 )
+	{}
+
+	/**
+	 * @brief Add the statistics of the next part of the image.
+	 * The parts are merged in the image order, so the luminosity min and max
+	 * are the first found pixels, like with a single pass on the image.
+	 */
+	void merge( const StatisticsAccumulator& other )
+	{
+		using namespace boost::gil;
+		using namespace terry::numeric;
+		if( other._nbPixels == 0 )
+			return;
+		if( _nbPixels == 0 )
+		{
+			*this = other;
+			return;
+		}
+		_nbPixels += other._nbPixels;
+
+		pixel_assign_min_t<Pixel, Pixel>( )( other._channelMin, _channelMin );
+		pixel_assign_max_t<Pixel, Pixel>( )( other._channelMax, _channelMax );
+		if( get_color( other._luminosityMinGray, gray_color_t() ) < get_color( _luminosityMinGray, gray_color_t() ) )
+		{
+			_luminosityMin     = other._luminosityMin;
+			_luminosityMinGray = other._luminosityMinGray;
+		}
+		if( get_color( other._luminosityMaxGray, gray_color_t() ) > get_color( _luminosityMaxGray, gray_color_t() ) )
+		{
+			_luminosityMax     = other._luminosityMax;
+			_luminosityMaxGray = other._luminosityMaxGray;
+		}
+
+		_sum.add( other._sum.get() );
+		_sum_p2.add( other._sum_p2.get() );
+		_sum_p3.add( other._sum_p3.get() );
+		_sum_p4.add( other._sum_p4.get() );
+	}
+
+	std::size_t _nbPixels;
+
+	Pixel _channelMin;
+	Pixel _channelMax;
+	Pixel _luminosityMin;
+	PixelGray _luminosityMinGray;
+	Pixel _luminosityMax;
+	PixelGray _luminosityMaxGray;
+
+	PixelCompensatedSum<CPixel> _sum;
+	PixelCompensatedSum<CPixel> _sum_p2;
+	PixelCompensatedSum<CPixel> _sum_p3;
+	PixelCompensatedSum<CPixel> _sum_p4;
+};
+
+/**
+ * @brief Compute the statistics of an image with all the threads.
+ *
+ * Each thread accumulates a band of rows. The pixels of a row are summed
+ * directly, then the rows and the bands are added with a compensated
+ * summation, so the precision doesn't depend on the image size.
+ * With a subsample, only one pixel every @p subsample pixels on each axis
+ * is used.
+ */
 template<class View, class MaskView, typename CType = boost::gil::bits64f>
-struct ComputeOutputParams
+class ComputeOutputParams : public OFX::MultiThread::Processor
 {
+public:
 	typedef typename View::value_type Pixel;
 	typedef typename boost::gil::color_space_type<View>::type Colorspace;
 	typedef boost::gil::pixel<typename boost::gil::channel_type<View>::type, boost::gil::layout<boost::gil::gray_t> > PixelGray; // grayscale pixel type (using the input channel_type)
 	typedef boost::gil::pixel<CType, boost::gil::layout<Colorspace> > CPixel; // the pixel type use for computation (using input colorspace)
 
 	typedef OutputParams<CPixel> Output;
+	typedef StatisticsAccumulator<Pixel, PixelGray, CPixel> Accumulator;
 
-	static Output run( const View& image, const MaskView& maskView, const bool useMask, ImageStatisticsPlugin& plugin )
+private:
+	enum EPass
+	{
+		ePassMoments = 0,
+		ePassVariance
+	};
+
+	const View& _image;
+	const MaskView& _maskView;
+	const bool _useMask;
+	const int _subsample;
+	const int _nbRows; ///< number of rows used
+	EPass _pass;
+	CPixel _average; ///< used by the variance pass
+	std::vector<Accumulator> _accumulators; ///< statistics of each thread
+	std::vector<PixelCompensatedSum<CPixel> > _varianceSums; ///< variance sum of each thread
+
+public:
+	ComputeOutputParams( const View& image, const MaskView& maskView, const bool useMask, const int subsample )
+		: _image( image )
+		, _maskView( maskView )
+		, _useMask( useMask )
+		, _subsample( std::max( 1, subsample ) )
+		, _nbRows( ( image.height() + _subsample - 1 ) / _subsample )
+		, _pass( ePassMoments )
+	{}
+
+	static Output run( const View& image, const MaskView& maskView, const bool useMask, const int subsample )
+	{
+		ComputeOutputParams compute( image, maskView, useMask, subsample );
+		return compute.compute();
+	}
+
+	Output compute()
 	{
 		using namespace terry::numeric;
-		OutputParams<CPixel> output;
+		Output output;
+
+		const unsigned int nbThreads = std::max( 1, std::min( static_cast<int>( OFX::MultiThread::getNumCPUs() ), _nbRows ) );
 
-		std::size_t nbProcPixels = 0;
+		_pass = ePassMoments;
+		_accumulators.assign( nbThreads, Accumulator() );
+		multiThread( nbThreads );
 
-		Pixel channelMin;
-		Pixel channelMax;
-		Pixel luminosityMin;
-		PixelGray luminosityMinGray;
-		Pixel luminosityMax;
-		PixelGray luminosityMaxGray;
+		Accumulator total;
+		for( std::size_t i = 0; i < _accumulators.size(); ++i )
+			total.merge( _accumulators[i] );
 
+		const std::size_t nbProcPixels = total._nbPixels;
+		output._nbPixels = nbProcPixels;
+		if( nbProcPixels == 0 )
+			return output;
+
+		output._channelMin    = total._channelMin;
+		output._channelMax    = total._channelMax;
+		output._luminosityMin = total._luminosityMin;
+		output._luminosityMax = total._luminosityMax;
+
+		const CPixel sum    = total._sum.get();
+		const CPixel sum_p2 = total._sum_p2.get();
+		const CPixel sum_p3 = total._sum_p3.get();
+		const CPixel sum_p4 = total._sum_p4.get();
+
+		CPixel stdDeriv = pixel_standard_deviation( sum, sum_p2, nbProcPixels );
+		output._average  = pixel_divides_scalar_t<CPixel, double>() ( sum, nbProcPixels );
+
+		_pass = ePassVariance;
+		_average = output._average;
+		_varianceSums.assign( nbThreads, PixelCompensatedSum<CPixel>() );
+		multiThread( nbThreads );
+
+		PixelCompensatedSum<CPixel> varianceSum;
+		for( std::size_t i = 0; i < _varianceSums.size(); ++i )
+			varianceSum.add( _varianceSums[i].get() );
+
+		CPixel varianceSquare = pixel_divides_scalar_t<CPixel, double>() ( varianceSum.get(), nbProcPixels );
+		output._variance = pixel_sqrt_t<CPixel, Pixel>()( varianceSquare );
+		output._kurtosis = pixel_kurtosis( output._average, stdDeriv, sum, sum_p2, sum_p3, sum_p4, nbProcPixels );
+		output._skewness = pixel_skewness( output._average, stdDeriv, sum, sum_p2, sum_p3, nbProcPixels );
+
+		return output;
+	}
+
+	void multiThreadFunction( const unsigned int threadID, const unsigned int nThreads )
+	{
+		if( threadID >= _accumulators.size() )
+			return;
+		// contiguous bands of rows, to merge the results in the image order
+		const int rowBegin = static_cast<int>( static_cast<std::size_t>( _nbRows ) * threadID / nThreads );
+		const int rowEnd   = static_cast<int>( static_cast<std::size_t>( _nbRows ) * ( threadID + 1 ) / nThreads );
+		for( int row = rowBegin; row < rowEnd; ++row )
+		{
+			if( _pass == ePassMoments )
+				accumulateRow( row * _subsample, _accumulators[threadID] );
+			else
+				accumulateVarianceRow( row * _subsample, _varianceSums[threadID] );
+		}
+	}
+
+private:
+	bool isMasked( const typename MaskView::x_iterator& mask_it, const int x ) const
+	{
+		using namespace boost::gil;
+		return _useMask && get_color( mask_it[x], gray_color_t() ) == 0.0;
+	}
+
+	void accumulateRow( const int y, Accumulator& acc ) const
+	{
+		using namespace boost::gil;
+		using namespace terry::numeric;
+
+		Accumulator row;
 		CPixel sum;
-		CPixel varianceSum;
 		CPixel sum_p2;
 		CPixel sum_p3;
 		CPixel sum_p4;
 		pixel_zeros_t<CPixel>( )( sum );
-		pixel_zeros_t<CPixel>( )( varianceSum );
 		pixel_zeros_t<CPixel>( )( sum_p2 );
 		pixel_zeros_t<CPixel>( )( sum_p3 );
 		pixel_zeros_t<CPixel>( )( sum_p4 );
 
-		for( int y = 0; y < image.height(); ++y )
+		typename View::x_iterator src_it = _image.x_at( 0, y );
+		typename MaskView::x_iterator mask_it = _maskView.x_at( 0, y );
+
+		for( int x = 0; x < _image.width(); x += _subsample )
 		{
-			typename View::x_iterator src_it = image.x_at( 0, y );
-			typename MaskView::x_iterator mask_it = maskView.x_at( 0, y );
+			if( isMasked( mask_it, x ) )
+				continue;
 
-			for( int x = 0; x < image.width(); ++x, ++src_it, ++mask_it )
+			const Pixel srcPixel = src_it[x];
+			PixelGray grayCurrentPixel; // current pixel in gray colorspace
+			color_convert( srcPixel, grayCurrentPixel );
+
+			if( row._nbPixels == 0 )
 			{
-				if( useMask && get_color( *mask_it, gray_color_t() ) == 0.0 )
-					continue;
-				
-				
-				PixelGray grayCurrentPixel; // current pixel in gray colorspace
-				color_convert( * src_it, grayCurrentPixel );
-
-				if( nbProcPixels == 0 )
-				{
-					// It's the first pixel we visit.
-					// So initialize statistics!
-					channelMin = *src_it;
-					channelMax = *src_it;
-					luminosityMin = *src_it;
-					luminosityMinGray = grayCurrentPixel;
-					luminosityMax = *src_it;
-					luminosityMaxGray = grayCurrentPixel;
-				}
-				// Count the number of pixels taken into account
-				++nbProcPixels;
-				
-				CPixel pix;
-				pixel_assigns_t<Pixel, CPixel>( )( * src_it, pix ); // pix = src_it;
-
-				CPixel pix_p2;
-				CPixel pix_p3;
-				CPixel pix_p4;
-
-				pixel_assigns_t<CPixel, CPixel>( )( pixel_pow_t<CPixel, 2>( )( pix ), pix_p2 ); // pix_p2 = pow<2>( pix );
-				pixel_assigns_t<CPixel, CPixel>( )( pixel_multiplies_t<CPixel, CPixel, CPixel>( )( pix, pix_p2 ), pix_p3 ); // pix_p3 = pix * pix_p2;
-				pixel_assigns_t<CPixel, CPixel>( )( pixel_multiplies_t<CPixel, CPixel, CPixel>( )( pix_p2, pix_p2 ), pix_p4 ); // pix_p4 = pix_p2 * pix_p2;
-
-				pixel_plus_assign_t<CPixel, CPixel>( )( pix, sum ); // sum += pix;
-				pixel_plus_assign_t<CPixel, CPixel>( )( pix_p2, sum_p2 ); // sum_p2 += pix_p2;
-				pixel_plus_assign_t<CPixel, CPixel>( )( pix_p3, sum_p3 ); // sum_p3 += pix_p3;
-				pixel_plus_assign_t<CPixel, CPixel>( )( pix_p4, sum_p4 ); // sum_p4 += pix_p4;
-
-				// search min for each channel
-				pixel_assign_min_t<Pixel, Pixel>( )( * src_it, channelMin );
-				// search max for each channel
-				pixel_assign_max_t<Pixel, Pixel>( )( * src_it, channelMax );
-
-				// search min luminosity
-				if( get_color( grayCurrentPixel, gray_color_t() ) < get_color( luminosityMinGray, gray_color_t() ) )
-				{
-					luminosityMin     = *src_it;
-					luminosityMinGray = grayCurrentPixel;
-				}
-				// search max luminosity
-				if( get_color( grayCurrentPixel, gray_color_t() ) > get_color( luminosityMaxGray, gray_color_t() ) )
-				{
-					luminosityMax     = *src_it;
-					luminosityMaxGray = grayCurrentPixel;
-				}
+				// It's the first pixel we visit.
+				// So initialize statistics!
+				row._channelMin = srcPixel;
+				row._channelMax = srcPixel;
+				row._luminosityMin = srcPixel;
+				row._luminosityMinGray = grayCurrentPixel;
+				row._luminosityMax = srcPixel;
+				row._luminosityMaxGray = grayCurrentPixel;
 			}
-		}
+			// Count the number of pixels taken into account
+			++row._nbPixels;
 
-		output._nbPixels = nbProcPixels;
+			CPixel pix;
+			pixel_assigns_t<Pixel, CPixel>( )( srcPixel, pix ); // pix = src_it;
 
-		output._channelMin    = channelMin;
-		output._channelMax    = channelMax;
-		output._luminosityMin = luminosityMin;
-		output._luminosityMax = luminosityMax;
+			CPixel pix_p2;
+			CPixel pix_p3;
+			CPixel pix_p4;
 
-		CPixel stdDeriv = pixel_standard_deviation( sum, sum_p2, nbProcPixels );
-		output._average  = pixel_divides_scalar_t<CPixel, double>() ( sum, nbProcPixels );
+			pixel_assigns_t<CPixel, CPixel>( )( pixel_pow_t<CPixel, 2>( )( pix ), pix_p2 ); // pix_p2 = pow<2>( pix );
+			pixel_assigns_t<CPixel, CPixel>( )( pixel_multiplies_t<CPixel, CPixel, CPixel>( )( pix, pix_p2 ), pix_p3 ); // pix_p3 = pix * pix_p2;
+			pixel_assigns_t<CPixel, CPixel>( )( pixel_multiplies_t<CPixel, CPixel, CPixel>( )( pix_p2, pix_p2 ), pix_p4 ); // pix_p4 = pix_p2 * pix_p2;
 
-		for( int y = 0; y < image.height(); ++y )
-		{
-			typename View::x_iterator src_it = image.x_at( 0, y );
-			
-			for( int x = 0; x < image.width(); ++x, ++src_it )
-			{
-				CPixel pix;
-				pixel_assigns_t<Pixel, CPixel>( )( * src_it, pix ); // pix = src_it;
+			pixel_plus_assign_t<CPixel, CPixel>( )( pix, sum ); // sum += pix;
+			pixel_plus_assign_t<CPixel, CPixel>( )( pix_p2, sum_p2 ); // sum_p2 += pix_p2;
+			pixel_plus_assign_t<CPixel, CPixel>( )( pix_p3, sum_p3 ); // sum_p3 += pix_p3;
+			pixel_plus_assign_t<CPixel, CPixel>( )( pix_p4, sum_p4 ); // sum_p4 += pix_p4;
 
-				CPixel pix_diff = pix;
-				CPixel pix_diff2;
+			// search min for each channel
+			pixel_assign_min_t<Pixel, Pixel>( )( srcPixel, row._channelMin );
+			// search max for each channel
+			pixel_assign_max_t<Pixel, Pixel>( )( srcPixel, row._channelMax );
 
-				pix_diff = pixel_minus_t<CPixel, CPixel, CPixel>( )( pix, output._average ); // pix_diff = (pix - mean)
-				pix_diff2 = pixel_multiplies_t<CPixel, CPixel, CPixel>( )( pix_diff, pix_diff ); // pix_diff2 = (x - mean)*(x - mean)
-				
-				pixel_plus_assign_t<CPixel, CPixel>( )( pix_diff2, varianceSum ); // varianceSum += pix_diff2;
+			// search min luminosity
+			if( get_color( grayCurrentPixel, gray_color_t() ) < get_color( row._luminosityMinGray, gray_color_t() ) )
+			{
+				row._luminosityMin     = srcPixel;
+				row._luminosityMinGray = grayCurrentPixel;
+			}
+			// search max luminosity
+			if( get_color( grayCurrentPixel, gray_color_t() ) > get_color( row._luminosityMaxGray, gray_color_t() ) )
+			{
+				row._luminosityMax     = srcPixel;
+				row._luminosityMaxGray = grayCurrentPixel;
 			}
 		}
 
-		CPixel varianceSquare = pixel_divides_scalar_t<CPixel, double>() ( varianceSum, nbProcPixels );
-		output._variance = pixel_sqrt_t<CPixel, Pixel>()( varianceSquare );
-		output._kurtosis = pixel_kurtosis( output._average, stdDeriv, sum, sum_p2, sum_p3, sum_p4, nbProcPixels );
-		output._skewness = pixel_skewness( output._average, stdDeriv, sum, sum_p2, sum_p3, nbProcPixels );
-
-		return output;
+		row._sum.add( sum );
+		row._sum_p2.add( sum_p2 );
+		row._sum_p3.add( sum_p3 );
+		row._sum_p4.add( sum_p4 );
+		acc.merge( row );
 	}
 
+	void accumulateVarianceRow( const int y, PixelCompensatedSum<CPixel>& varianceSum ) const
+	{
+		using namespace terry::numeric;
+
+		CPixel rowSum;
+		pixel_zeros_t<CPixel>( )( rowSum );
+
+		typename View::x_iterator src_it = _image.x_at( 0, y );
+		typename MaskView::x_iterator mask_it = _maskView.x_at( 0, y );
+
+		for( int x = 0; x < _image.width(); x += _subsample )
+		{
+			if( isMasked( mask_it, x ) )
+				continue;
+
+			CPixel pix;
+			pixel_assigns_t<Pixel, CPixel>( )( src_it[x], pix ); // pix = src_it;
+
+			CPixel pix_diff = pixel_minus_t<CPixel, CPixel, CPixel>( )( pix, _average ); // pix_diff = (pix - mean)
+			CPixel pix_diff2 = pixel_multiplies_t<CPixel, CPixel, CPixel>( )( pix_diff, pix_diff ); // pix_diff2 = (x - mean)*(x - mean)
+
+			pixel_plus_assign_t<CPixel, CPixel>( )( pix_diff2, rowSum ); // rowSum += pix_diff2;
+		}
+		varianceSum.add( rowSum );
+	}
 };
 
 
@@ -431,12 +638,12 @@ void ImageStatisticsProcess<View>::setup( const OFX::RenderArguments& args )
 	typename KthChannelView::type channelMaskView = KthChannelView::make(maskView); // gray or alpha channel
 
 	typedef ComputeOutputParams<View, typename KthChannelView::type, boost::gil::bits64f> ComputeRGBA;
-	typename ComputeRGBA::Output outputRGBA = ComputeRGBA::run( image, channelMaskView, _clipMaskConnected, this->_plugin );
+	typename ComputeRGBA::Output outputRGBA = ComputeRGBA::run( image, channelMaskView, _clipMaskConnected, _processParams._subsample );
 
 	typedef pixel<typename channel_type<View>::type, layout<hsl_t> > HSLPixel;
 	typedef color_converted_view_type<View, HSLPixel> HSLConverter;
 	typedef ComputeOutputParams<typename HSLConverter::type, typename KthChannelView::type, boost::gil::bits64f> ComputeHSL;
-	typename ComputeHSL::Output outputHSL = ComputeHSL::run( color_converted_view<HSLPixel>( image ), channelMaskView, _clipMaskConnected, this->_plugin );
+	typename ComputeHSL::Output outputHSL = ComputeHSL::run( color_converted_view<HSLPixel>( image ), channelMaskView, _clipMaskConnected, _processParams._subsample );
 
 	setOutputParams( outputRGBA, outputHSL, args.time, this->_plugin );
 
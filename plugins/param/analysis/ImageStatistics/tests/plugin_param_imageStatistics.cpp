@@ -0,0 +1,187 @@
+#define BOOST_TEST_MODULE plugin_ImageStatistics
+#include <tuttle/test/main.hpp>
+
+#include <tuttle/host/Graph.hpp>
+#include <tuttle/host/Node.hpp>
+#include <tuttle/host/memory/MemoryCache.hpp>
+#include <tuttle/host/attribute/Image.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace boost::unit_test;
+using namespace tuttle::host;
+
+namespace {
+
+static const int kWidth = 301;
+static const int kHeight = 203;
+
+/// @brief Statistics of the RGBA channels, computed on a single thread.
+struct Statistics
+{
+	std::size_t _nbPixels;
+	double _average[4];
+	double _variance[4];
+	float _channelMin[4];
+	float _channelMax[4];
+};
+
+NodeInit sourceNode()
+{
+	return NodeInit( "tuttle.colorwheel" )
+		.setParam( "explicitConversion", 3 ) // float
+		.setParam( "size", kWidth, kHeight );
+}
+
+/// @brief Transparent boxes, which are masked.
+NodeInit maskNode()
+{
+	return NodeInit( "tuttle.checkerboard" )
+		.setParam( "explicitConversion", 3 ) // float
+		.setParam( "size", kWidth, kHeight )
+		.setParam( "boxes", 7, 5 )
+		.setParam( "color1", 1.0, 1.0, 1.0, 0.0 )
+		.setParam( "color2", 1.0, 1.0, 1.0, 1.0 );
+}
+
+memory::CACHE_ELEMENT computeImage( const NodeInit& nodeInit )
+{
+	Graph g;
+	Graph::Node& node = g.addNode( nodeInit );
+	memory::MemoryCache outputCache;
+	BOOST_REQUIRE( g.compute( outputCache, node ) );
+	memory::CACHE_ELEMENT image = outputCache.get( node.getName(), 0 );
+	BOOST_REQUIRE( image.get() != NULL );
+	BOOST_REQUIRE_EQUAL( image->getBitDepth(), ofx::imageEffect::eBitDepthFloat );
+	BOOST_REQUIRE_EQUAL( image->getNbComponents(), 4U );
+	return image;
+}
+
+const float* imageRow( attribute::Image& image, const int y )
+{
+	// the plugin uses the memory order of the lines
+	return reinterpret_cast<const float*>( image.getPixelData() + static_cast<std::ptrdiff_t>( y ) * image.getRowAbsDistanceBytes() );
+}
+
+/**
+ * @brief Statistics of one pixel every @p subsample pixels on each axis,
+ * without the pixels with a null alpha in the mask.
+ */
+Statistics referenceStatistics( attribute::Image& image, attribute::Image* mask, const int subsample )
+{
+	Statistics stats;
+	stats._nbPixels = 0;
+	double sum[4] = { 0, 0, 0, 0 };
+	for( int c = 0; c < 4; ++c )
+	{
+		stats._channelMin[c] = std::numeric_limits<float>::max();
+		stats._channelMax[c] = -std::numeric_limits<float>::max();
+	}
+
+	for( int y = 0; y < kHeight; y += subsample )
+	{
+		const float* src = imageRow( image, y );
+		for( int x = 0; x < kWidth; x += subsample )
+		{
+			if( mask && imageRow( *mask, y )[x * 4 + 3] == 0.f )
+				continue;
+			++stats._nbPixels;
+			for( int c = 0; c < 4; ++c )
+			{
+				const float v = src[x * 4 + c];
+				sum[c] += v;
+				stats._channelMin[c] = std::min( stats._channelMin[c], v );
+				stats._channelMax[c] = std::max( stats._channelMax[c], v );
+			}
+		}
+	}
+	for( int c = 0; c < 4; ++c )
+		stats._average[c] = sum[c] / stats._nbPixels;
+
+	double varianceSum[4] = { 0, 0, 0, 0 };
+	for( int y = 0; y < kHeight; y += subsample )
+	{
+		const float* src = imageRow( image, y );
+		for( int x = 0; x < kWidth; x += subsample )
+		{
+			if( mask && imageRow( *mask, y )[x * 4 + 3] == 0.f )
+				continue;
+			for( int c = 0; c < 4; ++c )
+			{
+				const double diff = src[x * 4 + c] - stats._average[c];
+				varianceSum[c] += diff * diff;
+			}
+		}
+	}
+	// the plugin outputs the standard deviation as the variance
+	for( int c = 0; c < 4; ++c )
+		stats._variance[c] = std::sqrt( varianceSum[c] / stats._nbPixels );
+	return stats;
+}
+
+void checkClose( const double value, const double expected )
+{
+	BOOST_CHECK_SMALL( value - expected, 1e-9 * std::max( 1.0, std::abs( expected ) ) );
+}
+
+/**
+ * @brief Compare the statistics of the plugin, computed with all the threads,
+ * with the statistics computed on a single thread.
+ */
+void checkStatistics( const int subsample, const bool useMask )
+{
+	TUTTLE_LOG_INFO( "--> IMAGE STATISTICS, subsample " << subsample << ( useMask ? ", with mask" : "" ) );
+	memory::CACHE_ELEMENT image = computeImage( sourceNode() );
+	memory::CACHE_ELEMENT mask;
+	if( useMask )
+		mask = computeImage( maskNode() );
+	const Statistics expected = referenceStatistics( *image, mask.get(), subsample );
+	BOOST_REQUIRE_GT( expected._nbPixels, 0U );
+
+	Graph g;
+	Graph::Node& source = g.addNode( sourceNode() );
+	Graph::Node& stats = g.addNode( NodeInit( "tuttle.imagestatistics" ).setParam( "subsample", subsample ) );
+	g.connect( source, stats );
+	if( useMask )
+	{
+		Graph::Node& maskSource = g.addNode( maskNode() );
+		g.connect( maskSource, stats.getAttribute( "mask" ) );
+	}
+	BOOST_REQUIRE( g.compute( stats ) );
+
+	BOOST_CHECK_EQUAL( static_cast<std::size_t>( stats.getParam( "outputNbPixels" ).getIntValueAtTime( 0 ) ), expected._nbPixels );
+	for( std::size_t c = 0; c < 4; ++c )
+	{
+		checkClose( stats.getParam( "outputAverage" ).getDoubleValueAtTimeAndIndex( 0, c ), expected._average[c] );
+		checkClose( stats.getParam( "outputVariance" ).getDoubleValueAtTimeAndIndex( 0, c ), expected._variance[c] );
+		BOOST_CHECK_EQUAL( stats.getParam( "outputChannelMin" ).getDoubleValueAtTimeAndIndex( 0, c ), expected._channelMin[c] );
+		BOOST_CHECK_EQUAL( stats.getParam( "outputChannelMax" ).getDoubleValueAtTimeAndIndex( 0, c ), expected._channelMax[c] );
+	}
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE( plugin_ImageStatistics )
+
+BOOST_AUTO_TEST_CASE( statistics_multithread )
+{
+	checkStatistics( 1, false );
+}
+
+BOOST_AUTO_TEST_CASE( statistics_subsample )
+{
+	// the number of lines isn't a multiple of the subsample
+	checkStatistics( 3, false );
+	checkStatistics( 4, false );
+}
+
+BOOST_AUTO_TEST_CASE( statistics_mask )
+{
+	// the masked pixels are not in the average, nor in the variance
+	checkStatistics( 1, true );
+	checkStatistics( 3, true );
+}
+
+BOOST_AUTO_TEST_SUITE_END()